@@ -0,0 +1,278 @@
+// Benchmarks the reader's hot paths against reproducible synthetic corpora.
+//
+// Usage: node bench/run-benchmarks.mjs [options] (see "Benchmarking" in `README.md`)
+//
+// Results are written as JSON to stdout (or `--output`), and a summary is written to stderr.
+
+import fs from "node:fs";
+import os from "node:os";
+import path from "node:path";
+import {pipeline} from "node:stream/promises";
+import {Readable} from "node:stream";
+import {fileURLToPath, pathToFileURL} from "node:url";
+import {parseArgs} from "node:util";
+import zlib from "node:zlib";
+
+const RESULTS_SCHEMA_VERSION = 1;
+// Incremented whenever the generator's output changes, so that cached corpora are regenerated.
+const CORPUS_VERSION = 2;
+const ROOT_DIR = path.resolve(path.dirname(fileURLToPath(import.meta.url)), "..");
+const GENERATOR_BATCH_SIZE = 100_000;
+const LOG_LEVEL_ERROR = 5;
+const LOG_LEVEL_FATAL = 6;
+const STRUCTURED_READER_OPTIONS = {logLevelKey: "level", timestampKey: "timestamp"};
+
+const {values: args} = parseArgs({
+    options: {
+        "module": {
+            type: "string",
+            default: path.join(ROOT_DIR, "build", "clp-ffi-js-bench", "ClpFfiJsBench-node.js"),
+        },
+        "corpus-dir": {type: "string", default: path.join(ROOT_DIR, "build", "bench-corpus")},
+        "sizes": {type: "string", default: "1000000,10000000"},
+        "types": {type: "string", default: "structured,unstructured"},
+        "seed": {type: "string", default: "1"},
+        "lazy": {type: "boolean", default: false},
+        "packed": {type: "boolean", default: false},
+        "page-size": {type: "string", default: "100"},
+        "num-queries": {type: "string", default: "200"},
+        "output": {type: "string"},
+    },
+});
+
+/**
+ * @param {number} seed
+ * @return {function(): number} A reproducible PRNG (mulberry32) returning numbers in [0, 1).
+ */
+const createRandom = (seed) => {
+    let state = seed >>> 0;
+    return () => {
+        state = (state + 0x6D2B79F5) >>> 0;
+        let t = state;
+        t = Math.imul(t ^ (t >>> 15), t | 1);
+        t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+        return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+    };
+};
+
+/**
+ * @param {function(): void} func
+ * @return {number} The time taken by `func` in milliseconds.
+ */
+const time = (func) => {
+    const begin = process.hrtime.bigint();
+    func();
+    return Number(process.hrtime.bigint() - begin) / 1e6;
+};
+
+/**
+ * @param {number[]} latenciesMs
+ * @return {object} Summary statistics of the latencies.
+ */
+const summarizeLatencies = (latenciesMs) => {
+    const sorted = [...latenciesMs].sort((a, b) => a - b);
+    const percentile = (p) => sorted[Math.min(sorted.length - 1, Math.floor(p * sorted.length))];
+    return {
+        numCalls: sorted.length,
+        meanMs: sorted.reduce((sum, latency) => sum + latency, 0) / sorted.length,
+        p50Ms: percentile(0.5),
+        p95Ms: percentile(0.95),
+        p99Ms: percentile(0.99),
+        maxMs: sorted[sorted.length - 1],
+    };
+};
+
+/**
+ * Generates the corpus if it isn't cached yet.
+ *
+ * @param {object} module
+ * @param {string} type
+ * @param {number} numEvents
+ * @param {number} seed
+ * @return {Promise<object>} The corpus's description, including its compressed stream's path.
+ */
+const getCorpus = async (module, type, numEvents, seed) => {
+    const name = `${type}-${numEvents}-${seed}-v${CORPUS_VERSION}`;
+    const streamPath = path.join(args["corpus-dir"], `${name}.clp.zst`);
+    const descriptionPath = path.join(args["corpus-dir"], `${name}.json`);
+    if (fs.existsSync(streamPath) && fs.existsSync(descriptionPath)) {
+        return JSON.parse(fs.readFileSync(descriptionPath, "utf8"));
+    }
+
+    fs.mkdirSync(args["corpus-dir"], {recursive: true});
+    const streamType = "structured" === type ?
+        module.IrStreamType.STRUCTURED :
+        module.IrStreamType.UNSTRUCTURED;
+    const generator = new module.SyntheticCorpusGenerator(streamType, seed);
+    let uncompressedSize = 0;
+    const batches = function* () {
+        for (let numGenerated = 0; numGenerated < numEvents;) {
+            const batchSize = Math.min(GENERATOR_BATCH_SIZE, numEvents - numGenerated);
+            const batch = generator.generate(batchSize);
+            uncompressedSize += batch.length;
+            numGenerated += batchSize;
+            yield batch;
+        }
+        const endOfStream = generator.finish();
+        uncompressedSize += endOfStream.length;
+        yield endOfStream;
+    };
+    try {
+        await pipeline(
+            Readable.from(batches()),
+            zlib.createZstdCompress(),
+            fs.createWriteStream(streamPath)
+        );
+    } finally {
+        generator.delete();
+    }
+
+    const description = {
+        type,
+        numEvents,
+        seed,
+        streamPath,
+        compressedSize: fs.statSync(streamPath).size,
+        uncompressedSize,
+    };
+    fs.writeFileSync(descriptionPath, JSON.stringify(description, null, 2));
+    return description;
+};
+
+/**
+ * @param {object} module
+ * @param {object} corpus
+ * @return {object} The benchmark results for the corpus.
+ */
+const benchmarkCorpus = (module, corpus) => {
+    const random = createRandom(corpus.seed);
+    const data = new Uint8Array(fs.readFileSync(corpus.streamPath));
+    const readerOptions = "structured" === corpus.type ?
+        {...STRUCTURED_READER_OPTIONS, lazy: args.lazy, packed: args.packed} :
+        null;
+
+    let reader = null;
+    let numEvents = 0;
+    const deserializeMs = time(() => {
+        reader = new module.ClpStreamReader(data, readerOptions);
+        numEvents = reader.deserializeStream();
+    });
+    const deserializeSeconds = deserializeMs / 1e3;
+    // null unless the module was built with `CLP_FFI_JS_ENABLE_STATS`.
+    const deserializeStats = reader.getStats();
+
+    const filterMs = time(() => {
+        reader.filterLogEvents([LOG_LEVEL_ERROR, LOG_LEVEL_FATAL]);
+    });
+    const numFilteredEvents = reader.getFilteredLogEventMap()?.length ?? 0;
+    reader.filterLogEvents(null);
+
+    const pageSize = Number(args["page-size"]);
+    const numQueries = Number(args["num-queries"]);
+    const decodeLatencies = [];
+    for (let i = 0; i < numQueries; ++i) {
+        const beginIdx = Math.floor(random() * Math.max(1, numEvents - pageSize));
+        const endIdx = Math.min(numEvents, beginIdx + pageSize);
+        decodeLatencies.push(time(() => reader.decodeRange(beginIdx, endIdx, false)));
+    }
+    const decodeSummary = summarizeLatencies(decodeLatencies);
+
+    const firstTimestamp = 0 === numEvents ?
+        0n :
+        reader.decodeRange(0, 1, false)[0][1];
+    const lastTimestamp = 0 === numEvents ?
+        0n :
+        reader.decodeRange(numEvents - 1, numEvents, false)[0][1];
+    const timestampSpan = Number(lastTimestamp - firstTimestamp);
+    const findLatencies = [];
+    for (let i = 0; i < numQueries; ++i) {
+        const target = firstTimestamp + BigInt(Math.floor(random() * timestampSpan));
+        findLatencies.push(time(() => reader.findNearestLogEventByTimestamp(target)));
+    }
+
+    const readerMemoryUsage = reader.getMemoryUsage();
+    reader.delete();
+
+    return {
+        corpus: {
+            type: corpus.type,
+            numEvents: corpus.numEvents,
+            seed: corpus.seed,
+            compressedSize: corpus.compressedSize,
+            uncompressedSize: corpus.uncompressedSize,
+            readerOptions,
+        },
+        deserializeStream: {
+            totalMs: deserializeMs,
+            numEvents,
+            eventsPerSecond: numEvents / deserializeSeconds,
+            compressedMBPerSecond: corpus.compressedSize / 1e6 / deserializeSeconds,
+            uncompressedMBPerSecond: corpus.uncompressedSize / 1e6 / deserializeSeconds,
+            stats: deserializeStats,
+        },
+        filterLogEvents: {
+            totalMs: filterMs,
+            numFilteredEvents,
+            eventsPerSecond: numEvents / (filterMs / 1e3),
+        },
+        decodeRange: {
+            pageSize,
+            ...decodeSummary,
+            eventsPerSecond: pageSize / (decodeSummary.meanMs / 1e3),
+        },
+        findNearestLogEventByTimestamp: summarizeLatencies(findLatencies),
+        memory: {
+            reader: readerMemoryUsage,
+            // Wasm memory never shrinks, so its current size is the peak size so far.
+            peakWasmHeapBytes: module.HEAPU8.buffer.byteLength,
+        },
+    };
+};
+
+const main = async () => {
+    const {default: createModule} = await import(pathToFileURL(args.module).href);
+    const generatorModule = await createModule();
+    const seed = Number(args.seed);
+
+    const results = [];
+    for (const type of args.types.split(",")) {
+        for (const numEvents of args.sizes.split(",").map(Number)) {
+            const corpus = await getCorpus(generatorModule, type, numEvents, seed);
+
+            // Each corpus is benchmarked in a fresh module instance so that its peak heap size
+            // isn't inflated by previous corpora.
+            const result = benchmarkCorpus(await createModule(), corpus);
+            results.push(result);
+            console.error(
+                `${type} ${numEvents}: ` +
+                `deserialize ${result.deserializeStream.eventsPerSecond.toFixed(0)} events/s ` +
+                `(${result.deserializeStream.uncompressedMBPerSecond.toFixed(1)} MB/s), ` +
+                `decodeRange p50 ${result.decodeRange.p50Ms.toFixed(3)} ms, ` +
+                `findNearest p50 ${result.findNearestLogEventByTimestamp.p50Ms.toFixed(4)} ms, ` +
+                `peak heap ${(result.memory.peakWasmHeapBytes / 2 ** 20).toFixed(0)} MiB`
+            );
+        }
+    }
+
+    const report = JSON.stringify(
+        {
+            schemaVersion: RESULTS_SCHEMA_VERSION,
+            date: new Date().toISOString(),
+            environment: {
+                node: process.version,
+                platform: `${os.platform()}-${os.arch()}`,
+                cpu: os.cpus()[0]?.model ?? "unknown",
+            },
+            results,
+        },
+        null,
+        2
+    );
+    if (args.output) {
+        fs.writeFileSync(args.output, report);
+    } else {
+        process.stdout.write(`${report}\n`);
+    }
+};
+
+await main();
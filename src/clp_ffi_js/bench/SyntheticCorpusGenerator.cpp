@@ -0,0 +1,360 @@
+#include "SyntheticCorpusGenerator.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_utils.hpp>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ffi/ir_stream/encoding_methods.hpp>
+#include <clp/ffi/ir_stream/protocol_constants.hpp>
+#include <clp/ffi/ir_stream/Serializer.hpp>
+#include <clp/ir/types.hpp>
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <msgpack.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/StreamReader.hpp>
+
+namespace clp_ffi_js::bench {
+namespace {
+constexpr std::string_view cTimestampPattern{"%Y-%m-%d %H:%M:%S,%3"};
+constexpr std::string_view cTimeZoneId{"UTC"};
+
+constexpr std::array<std::string_view, 5> cServices{"api", "auth", "billing", "search", "storage"};
+
+// The cumulative weight (out of `cTotalLevelWeight`) of each log level, roughly resembling the
+// distribution of levels in production logs.
+constexpr std::array<std::pair<LogLevel, uint64_t>, 6> cCumulativeLevelWeights{{
+        {LogLevel::TRACE, 15},
+        {LogLevel::DEBUG, 165},
+        {LogLevel::INFO, 865},
+        {LogLevel::WARN, 945},
+        {LogLevel::ERROR, 995},
+        {LogLevel::FATAL, 1000},
+}};
+constexpr uint64_t cTotalLevelWeight{1000};
+
+constexpr size_t cNumMessageTemplates{7};
+constexpr uint64_t cMaxTimestampDeltaMs{50};
+constexpr uint64_t cMaxLatencyMicroseconds{2'000'000};
+constexpr double cMicrosecondsPerMillisecond{1000.0};
+constexpr clp::ir::epoch_time_ms_t cMillisecondsPerSecond{1000};
+}  // namespace
+
+auto SyntheticCorpusGenerator::create(ir::StreamType stream_type, uint32_t seed)
+        -> std::unique_ptr<SyntheticCorpusGenerator> {
+    return create(stream_type, seed, TimestampFormat::EpochMilliseconds);
+}
+
+auto SyntheticCorpusGenerator::create(
+        ir::StreamType stream_type,
+        uint32_t seed,
+        TimestampFormat timestamp_format
+) -> std::unique_ptr<SyntheticCorpusGenerator> {
+    std::optional<StructuredSerializer> structured_serializer;
+    std::vector<int8_t> unstructured_ir_buf;
+    if (ir::StreamType::Structured == stream_type) {
+        auto result{StructuredSerializer::create()};
+        if (result.has_error()) {
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_Failure,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format("Failed to create serializer: {}", result.error().message())
+            };
+        }
+        structured_serializer.emplace(std::move(result.value()));
+    } else if (false
+               == clp::ffi::ir_stream::four_byte_encoding::serialize_preamble(
+                       cTimestampPattern,
+                       {},
+                       cTimeZoneId,
+                       cBeginTimestamp,
+                       unstructured_ir_buf
+               ))
+    {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                "Failed to serialize preamble"
+        };
+    }
+
+    return std::unique_ptr<SyntheticCorpusGenerator>(new SyntheticCorpusGenerator{
+            seed,
+            timestamp_format,
+            std::move(structured_serializer),
+            std::move(unstructured_ir_buf)
+    });
+}
+
+auto SyntheticCorpusGenerator::generate(size_t num_log_events) -> ir::DataArrayTsType {
+    for (size_t i{0}; i < num_log_events; ++i) {
+        auto const log_event{generate_log_event()};
+        if (m_structured_serializer.has_value()) {
+            serialize_structured(log_event);
+        } else {
+            serialize_unstructured(log_event);
+        }
+    }
+
+    if (m_structured_serializer.has_value()) {
+        auto const data_array{to_data_array(m_structured_serializer->get_ir_buf_view())};
+        m_structured_serializer->clear_ir_buf();
+        return data_array;
+    }
+    auto const data_array{to_data_array(m_unstructured_ir_buf)};
+    m_unstructured_ir_buf.clear();
+    return data_array;
+}
+
+auto SyntheticCorpusGenerator::finish() -> ir::DataArrayTsType {
+    std::array<int8_t, 1> const end_of_stream{clp::ffi::ir_stream::cProtocol::Eof};
+    return to_data_array(end_of_stream);
+}
+
+SyntheticCorpusGenerator::SyntheticCorpusGenerator(
+        uint32_t seed,
+        TimestampFormat timestamp_format,
+        std::optional<StructuredSerializer> structured_serializer,
+        std::vector<int8_t> unstructured_ir_buf
+)
+        : m_random_state{seed},
+          m_timestamp_format{timestamp_format},
+          m_structured_serializer{std::move(structured_serializer)},
+          m_unstructured_ir_buf{std::move(unstructured_ir_buf)} {}
+
+auto SyntheticCorpusGenerator::next_random() -> uint64_t {
+    constexpr uint64_t cIncrement{0x9E37'79B9'7F4A'7C15};
+    constexpr uint64_t cMultiplier1{0xBF58'476D'1CE4'E5B9};
+    constexpr uint64_t cMultiplier2{0x94D0'49BB'1331'11EB};
+    constexpr uint64_t cShift1{30};
+    constexpr uint64_t cShift2{27};
+    constexpr uint64_t cShift3{31};
+
+    m_random_state += cIncrement;
+    auto value{m_random_state};
+    value = (value ^ (value >> cShift1)) * cMultiplier1;
+    value = (value ^ (value >> cShift2)) * cMultiplier2;
+    return value ^ (value >> cShift3);
+}
+
+auto SyntheticCorpusGenerator::generate_log_event() -> LogEvent {
+    m_timestamp += static_cast<clp::ir::epoch_time_ms_t>(next_random(cMaxTimestampDeltaMs));
+
+    auto const level_weight{next_random(cTotalLevelWeight)};
+    size_t level_idx{0};
+    while (cCumulativeLevelWeights.at(level_idx).second <= level_weight) {
+        ++level_idx;
+    }
+
+    // NOTE: Each random number is drawn into a variable before being used, since the evaluation
+    // order of function arguments is unspecified and would make the corpus compiler-dependent.
+    // NOLINTBEGIN(readability-magic-numbers)
+    std::string message;
+    auto const template_idx{next_random(cNumMessageTemplates)};
+    auto const arg1{next_random()};
+    auto const arg2{next_random()};
+    auto const arg3{next_random()};
+    switch (template_idx) {
+        case 0:
+            message = std::format(
+                    "GET /api/v1/users/{} completed in {} ms",
+                    arg1 % 100'000,
+                    arg2 % 1000
+            );
+            break;
+        case 1:
+            message = std::format("Cache miss for key session:{:08x}", arg1 % (uint64_t{1} << 32U));
+            break;
+        case 2:
+            message = std::format("Retrying request {:016x} (attempt {} of 5)", arg1, arg2 % 5 + 1);
+            break;
+        case 3:
+            message = std::format(
+                    "Connection to 10.0.{}.{}:{} closed by peer",
+                    arg1 % 256,
+                    arg2 % 256,
+                    arg3 % 65'536
+            );
+            break;
+        case 4:
+            message = std::format(
+                    "Processed batch of {} records from partition {}",
+                    arg1 % 10'000,
+                    arg2 % 64
+            );
+            break;
+        case 5: {
+            // Contains a float variable that may be negative or have leading zeros in its fraction,
+            // e.g., "-0.042".
+            auto const sign{0 == arg3 % 2 ? "" : "-"};
+            message = std::format(
+                    "Clock skew of {}{}.{:03} s detected on replica {}",
+                    sign,
+                    arg1 % 3,
+                    arg2 % 1000,
+                    arg3 % 16
+            );
+            break;
+        }
+        default:
+            // Contains backslashes, which CLP escapes in logtypes.
+            message = std::format("Wrote checkpoint C:\\data\\part-{:05}.ckpt", arg1 % 100'000);
+            break;
+    }
+    auto const status{static_cast<int64_t>(
+            cCumulativeLevelWeights.at(level_idx).first >= LogLevel::ERROR ? 500 : 200
+    )};
+    // NOLINTEND(readability-magic-numbers)
+
+    auto const service_idx{next_random(cServices.size())};
+    auto const latency{
+            static_cast<double>(next_random(cMaxLatencyMicroseconds)) / cMicrosecondsPerMillisecond
+    };
+
+    return {m_timestamp, level_idx, service_idx, std::move(message), status, latency};
+}
+
+auto SyntheticCorpusGenerator::serialize_structured(LogEvent const& log_event) -> void {
+    constexpr uint32_t cNumKvPairs{6};
+    auto const level{cCumulativeLevelWeights.at(log_event.level_idx).first};
+
+    msgpack::sbuffer buf;
+    msgpack::packer<msgpack::sbuffer> packer{buf};
+    packer.pack_map(cNumKvPairs);
+    packer.pack("timestamp");
+    auto const seconds{log_event.timestamp / cMillisecondsPerSecond};
+    auto const milliseconds{log_event.timestamp % cMillisecondsPerSecond};
+    switch (m_timestamp_format) {
+        case TimestampFormat::EpochMillisecondsString:
+            packer.pack(std::to_string(log_event.timestamp));
+            break;
+        case TimestampFormat::EpochSecondsString:
+            packer.pack(std::to_string(seconds));
+            break;
+        case TimestampFormat::DecimalEpochSecondsString:
+            packer.pack(std::format("{}.{:03}", seconds, milliseconds));
+            break;
+        case TimestampFormat::EpochMilliseconds:
+        default:
+            packer.pack(log_event.timestamp);
+            break;
+    }
+    packer.pack("level");
+    packer.pack(cLogLevelNames.at(clp::enum_to_underlying_type(level)));
+    packer.pack("service");
+    packer.pack(cServices.at(log_event.service_idx));
+    packer.pack("message");
+    packer.pack(log_event.message);
+    packer.pack("status");
+    packer.pack(log_event.status);
+    packer.pack("latency");
+    packer.pack(log_event.latency);
+
+    auto const handle{msgpack::unpack(buf.data(), buf.size())};
+    if (false == m_structured_serializer->serialize_msgpack_map(handle.get().via.map)) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                "Failed to serialize log event"
+        };
+    }
+}
+
+auto SyntheticCorpusGenerator::serialize_unstructured(LogEvent const& log_event) -> void {
+    auto const level{cCumulativeLevelWeights.at(log_event.level_idx).first};
+    auto const message{std::format(
+            " {} [{}] {} (status={}, latency={} ms)",
+            cLogLevelNames.at(clp::enum_to_underlying_type(level)),
+            cServices.at(log_event.service_idx),
+            log_event.message,
+            log_event.status,
+            log_event.latency
+    )};
+    if (false
+        == clp::ffi::ir_stream::four_byte_encoding::serialize_log_event(
+                log_event.timestamp - m_prev_timestamp,
+                message,
+                m_logtype,
+                m_unstructured_ir_buf
+        ))
+    {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                "Failed to serialize log event"
+        };
+    }
+    m_prev_timestamp = log_event.timestamp;
+}
+
+auto SyntheticCorpusGenerator::to_data_array(std::span<int8_t const> ir_buf)
+        -> ir::DataArrayTsType {
+    auto const array{emscripten::val::global("Uint8Array").new_(ir_buf.size())};
+    array.call<void>(
+            "set",
+            emscripten::typed_memory_view(
+                    ir_buf.size(),
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                    reinterpret_cast<uint8_t const*>(ir_buf.data())
+            )
+    );
+    return ir::DataArrayTsType{array};
+}
+}  // namespace clp_ffi_js::bench
+
+namespace {
+EMSCRIPTEN_BINDINGS(ClpSyntheticCorpusGenerator) {
+    using clp_ffi_js::bench::SyntheticCorpusGenerator;
+    emscripten::enum_<SyntheticCorpusGenerator::TimestampFormat>("SyntheticTimestampFormat")
+            .value(
+                    "EPOCH_MILLISECONDS",
+                    SyntheticCorpusGenerator::TimestampFormat::EpochMilliseconds
+            )
+            .value(
+                    "EPOCH_MILLISECONDS_STRING",
+                    SyntheticCorpusGenerator::TimestampFormat::EpochMillisecondsString
+            )
+            .value(
+                    "EPOCH_SECONDS_STRING",
+                    SyntheticCorpusGenerator::TimestampFormat::EpochSecondsString
+            )
+            .value(
+                    "DECIMAL_EPOCH_SECONDS_STRING",
+                    SyntheticCorpusGenerator::TimestampFormat::DecimalEpochSecondsString
+            );
+    emscripten::class_<SyntheticCorpusGenerator>("SyntheticCorpusGenerator")
+            .constructor(
+                    emscripten::select_overload<std::unique_ptr<SyntheticCorpusGenerator>(
+                            clp_ffi_js::ir::StreamType,
+                            uint32_t
+                    )>(&SyntheticCorpusGenerator::create),
+                    emscripten::return_value_policy::take_ownership()
+            )
+            .constructor(
+                    emscripten::select_overload<std::unique_ptr<SyntheticCorpusGenerator>(
+                            clp_ffi_js::ir::StreamType,
+                            uint32_t,
+                            SyntheticCorpusGenerator::TimestampFormat
+                    )>(&SyntheticCorpusGenerator::create),
+                    emscripten::return_value_policy::take_ownership()
+            )
+            .function("generate", &SyntheticCorpusGenerator::generate)
+            .function("finish", &SyntheticCorpusGenerator::finish);
+}
+}  // namespace
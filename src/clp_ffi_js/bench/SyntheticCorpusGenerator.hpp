@@ -0,0 +1,159 @@
+#ifndef CLP_FFI_JS_BENCH_SYNTHETICCORPUSGENERATOR_HPP
+#define CLP_FFI_JS_BENCH_SYNTHETICCORPUSGENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <clp/ffi/ir_stream/encoding_methods.hpp>
+#include <clp/ffi/ir_stream/Serializer.hpp>
+#include <clp/ir/types.hpp>
+#include <emscripten/val.h>
+
+#include <clp_ffi_js/ir/StreamReader.hpp>
+
+namespace clp_ffi_js::bench {
+/**
+ * Class to generate reproducible synthetic IR streams for benchmarking the readers.
+ *
+ * Log events are generated from a fixed vocabulary of services, log levels, and message templates
+ * using a seeded PRNG, so that the same seed always generates the same stream. The stream is
+ * generated uncompressed and in pieces, so that callers can compress it (and write it out)
+ * incrementally without holding the whole stream in memory.
+ *
+ * Structured streams contain log events of the form `{"timestamp": <ms>, "level": <name>,
+ * "service": <name>, "message": <text>, "status": <int>, "latency": <float>}`, and are meant to be
+ * read with `{logLevelKey: "level", timestampKey: "timestamp"}`. Structured streams' timestamps can
+ * also be written as strings (see `TimestampFormat`). Unstructured streams contain the same
+ * information in text messages, with the level following the timestamp.
+ */
+class SyntheticCorpusGenerator {
+public:
+    // Types
+    /**
+     * The representation of structured log events' timestamps.
+     */
+    enum class TimestampFormat : uint8_t {
+        // An integer, e.g., 1700000000123.
+        EpochMilliseconds,
+        // A string, e.g., "1700000000123".
+        EpochMillisecondsString,
+        // A string truncated to seconds, e.g., "1700000000".
+        EpochSecondsString,
+        // A string, e.g., "1700000000.123".
+        DecimalEpochSecondsString,
+    };
+
+    // Constants
+    static constexpr clp::ir::epoch_time_ms_t cBeginTimestamp{1'700'000'000'000};
+
+    /**
+     * @param stream_type
+     * @param seed
+     * @return The created instance, with integer timestamps.
+     * @throw ClpFfiJsException if the stream's preamble can't be serialized.
+     */
+    [[nodiscard]] static auto create(ir::StreamType stream_type, uint32_t seed)
+            -> std::unique_ptr<SyntheticCorpusGenerator>;
+
+    /**
+     * @param stream_type
+     * @param seed
+     * @param timestamp_format The representation of timestamps, which only applies to structured
+     * streams.
+     * @return The created instance.
+     * @throw ClpFfiJsException if the stream's preamble can't be serialized.
+     */
+    [[nodiscard]] static auto
+    create(ir::StreamType stream_type, uint32_t seed, TimestampFormat timestamp_format)
+            -> std::unique_ptr<SyntheticCorpusGenerator>;
+
+    // Destructor
+    ~SyntheticCorpusGenerator() = default;
+
+    // Disable copy/move constructors and assignment operators since instances are only ever owned
+    // through a `std::unique_ptr`.
+    SyntheticCorpusGenerator(SyntheticCorpusGenerator const&) = delete;
+    SyntheticCorpusGenerator(SyntheticCorpusGenerator&&) = delete;
+    auto operator=(SyntheticCorpusGenerator const&) -> SyntheticCorpusGenerator& = delete;
+    auto operator=(SyntheticCorpusGenerator&&) -> SyntheticCorpusGenerator& = delete;
+
+    // Methods
+    /**
+     * Generates the next log events of the stream.
+     *
+     * @param num_log_events
+     * @return The serialized log events, preceded by the stream's preamble if this is the first
+     * call.
+     * @throw ClpFfiJsException if a log event can't be serialized.
+     */
+    [[nodiscard]] auto generate(size_t num_log_events) -> ir::DataArrayTsType;
+
+    /**
+     * @return The end-of-stream marker, which must be appended after all generated log events.
+     */
+    [[nodiscard]] auto finish() -> ir::DataArrayTsType;
+
+private:
+    // Types
+    using StructuredSerializer
+            = clp::ffi::ir_stream::Serializer<clp::ir::eight_byte_encoded_variable_t>;
+
+    struct LogEvent {
+        clp::ir::epoch_time_ms_t timestamp;
+        size_t level_idx;
+        size_t service_idx;
+        std::string message;
+        int64_t status;
+        double latency;
+    };
+
+    // Constructor
+    SyntheticCorpusGenerator(
+            uint32_t seed,
+            TimestampFormat timestamp_format,
+            std::optional<StructuredSerializer> structured_serializer,
+            std::vector<int8_t> unstructured_ir_buf
+    );
+
+    // Methods
+    /**
+     * @return The next pseudo-random number (SplitMix64).
+     */
+    [[nodiscard]] auto next_random() -> uint64_t;
+
+    /**
+     * @param bound
+     * @return A pseudo-random number in `[0, bound)`.
+     */
+    [[nodiscard]] auto next_random(uint64_t bound) -> uint64_t { return next_random() % bound; }
+
+    [[nodiscard]] auto generate_log_event() -> LogEvent;
+
+    auto serialize_structured(LogEvent const& log_event) -> void;
+
+    auto serialize_unstructured(LogEvent const& log_event) -> void;
+
+    /**
+     * @param ir_buf
+     * @return A copy of the buffer as a `Uint8Array`.
+     */
+    [[nodiscard]] static auto to_data_array(std::span<int8_t const> ir_buf)
+            -> ir::DataArrayTsType;
+
+    // Variables
+    uint64_t m_random_state;
+    TimestampFormat m_timestamp_format;
+    clp::ir::epoch_time_ms_t m_timestamp{cBeginTimestamp};
+    clp::ir::epoch_time_ms_t m_prev_timestamp{cBeginTimestamp};
+    std::optional<StructuredSerializer> m_structured_serializer;
+    std::vector<int8_t> m_unstructured_ir_buf;
+    std::string m_logtype;
+};
+}  // namespace clp_ffi_js::bench
+
+#endif  // CLP_FFI_JS_BENCH_SYNTHETICCORPUSGENERATOR_HPP
@@ -0,0 +1,68 @@
+#include "ChunkedReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include <clp/Array.hpp>
+#include <clp/ErrorCode.hpp>
+#include <clp/TraceableException.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+
+namespace clp_ffi_js::ir {
+auto ChunkedReader::try_seek_from_begin(size_t pos) -> clp::ErrorCode {
+    if (pos != m_pos) {
+        return clp::ErrorCode::ErrorCode_Unsupported;
+    }
+    return clp::ErrorCode::ErrorCode_Success;
+}
+
+auto ChunkedReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    num_bytes_read = 0;
+    while (num_bytes_read < num_bytes_to_read && false == m_chunks.empty()) {
+        auto const& chunk{*m_chunks.front()};
+        auto const num_bytes_to_copy{
+                std::min(chunk.size() - m_front_chunk_pos, num_bytes_to_read - num_bytes_read)
+        };
+        std::memcpy(buf + num_bytes_read, chunk.data() + m_front_chunk_pos, num_bytes_to_copy);
+        num_bytes_read += num_bytes_to_copy;
+        m_front_chunk_pos += num_bytes_to_copy;
+        if (m_front_chunk_pos == chunk.size()) {
+            m_num_bytes_resident -= chunk.size();
+            m_chunks.pop_front();
+            m_front_chunk_pos = 0;
+        }
+    }
+    m_pos += num_bytes_read;
+
+    if (0 == num_bytes_read && 0 != num_bytes_to_read) {
+        return clp::ErrorCode::ErrorCode_EndOfFile;
+    }
+    return clp::ErrorCode::ErrorCode_Success;
+}
+
+auto ChunkedReader::push_chunk(clp::Array<char>&& chunk) -> void {
+    push_chunk(std::make_shared<clp::Array<char> const>(std::move(chunk)));
+}
+
+auto ChunkedReader::push_chunk(std::shared_ptr<clp::Array<char> const> chunk) -> void {
+    if (m_is_input_complete) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "Cannot push a chunk after the input has been marked as complete."
+        };
+    }
+    if (0 == chunk->size()) {
+        return;
+    }
+    m_num_bytes_pushed += chunk->size();
+    m_num_bytes_resident += chunk->size();
+    m_chunks.emplace_back(std::move(chunk));
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,113 @@
+#ifndef CLP_FFI_JS_IR_CHUNKEDREADER_HPP
+#define CLP_FFI_JS_IR_CHUNKEDREADER_HPP
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+
+#include <clp/Array.hpp>
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * A forward-only `clp::ReaderInterface` over a queue of byte chunks supplied incrementally by the
+ * caller. Each chunk is released as soon as the read head moves past it, so the full input never
+ * has to be resident at once (unless the chunk is shared with another owner).
+ *
+ * When no more bytes are buffered, reads fail with `ErrorCode_EndOfFile` regardless of whether
+ * the input is complete; callers can use `is_input_complete` to distinguish a truncated input from
+ * one that's still being supplied.
+ */
+class ChunkedReader : public clp::ReaderInterface {
+public:
+    // Constructors
+    ChunkedReader() = default;
+
+    // Disable copy/move constructors and assignment operators since readers further down the chain
+    // hold references to this instance.
+    ChunkedReader(ChunkedReader const&) = delete;
+    ChunkedReader(ChunkedReader&&) = delete;
+    auto operator=(ChunkedReader const&) -> ChunkedReader& = delete;
+    auto operator=(ChunkedReader&&) -> ChunkedReader& = delete;
+
+    // Destructor
+    ~ChunkedReader() override = default;
+
+    // Methods implementing `clp::ReaderInterface`
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        pos = m_pos;
+        return clp::ErrorCode::ErrorCode_Success;
+    }
+
+    /**
+     * @param pos
+     * @return ErrorCode_Success if `pos` is the current position.
+     * @return ErrorCode_Unsupported otherwise, since consumed chunks have already been freed.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override;
+
+    /**
+     * Reads up to `num_bytes_to_read` buffered bytes.
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_EndOfFile if no bytes are buffered.
+     * @return ErrorCode_Success otherwise.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    // Methods
+    /**
+     * Appends a chunk to the end of the input.
+     * @param chunk
+     * @throw ClpFfiJsException if the input has already been marked as complete.
+     */
+    auto push_chunk(clp::Array<char>&& chunk) -> void;
+
+    /**
+     * Appends a chunk that may be shared with other owners to the end of the input. The reader
+     * releases its reference once the read head moves past the chunk.
+     * @param chunk
+     * @throw ClpFfiJsException if the input has already been marked as complete.
+     */
+    auto push_chunk(std::shared_ptr<clp::Array<char> const> chunk) -> void;
+
+    /**
+     * Marks that no more chunks will be pushed.
+     */
+    auto mark_input_complete() -> void { m_is_input_complete = true; }
+
+    [[nodiscard]] auto is_input_complete() const -> bool { return m_is_input_complete; }
+
+    /**
+     * @return The total number of bytes pushed into the reader.
+     */
+    [[nodiscard]] auto get_num_bytes_pushed() const -> size_t { return m_num_bytes_pushed; }
+
+    /**
+     * @return The number of bytes pushed but not yet read.
+     */
+    [[nodiscard]] auto get_num_bytes_buffered() const -> size_t {
+        return m_num_bytes_pushed - m_pos;
+    }
+
+    /**
+     * @return The number of bytes held by the chunks that haven't been freed yet.
+     */
+    [[nodiscard]] auto get_num_bytes_resident() const -> size_t { return m_num_bytes_resident; }
+
+private:
+    // Variables
+    std::deque<std::shared_ptr<clp::Array<char> const>> m_chunks;
+    // Position of the read head within `m_chunks.front()`
+    size_t m_front_chunk_pos{0};
+    size_t m_pos{0};
+    size_t m_num_bytes_pushed{0};
+    size_t m_num_bytes_resident{0};
+    bool m_is_input_complete{false};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_CHUNKEDREADER_HPP
@@ -0,0 +1,29 @@
+#include "ColumnarDecodeBuffers.hpp"
+
+#include <cstdint>
+
+#include <emscripten/val.h>
+
+#include <clp_ffi_js/ir/typed_array.hpp>
+
+namespace clp_ffi_js::ir {
+auto ColumnarDecodeBuffers::create_views() const -> emscripten::val {
+    auto views{emscripten::val::object()};
+    views.set(
+            "messages",
+            create_typed_array(
+                    m_messages.size(),
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                    reinterpret_cast<uint8_t const*>(m_messages.data())
+            )
+    );
+    views.set(
+            "messageOffsets",
+            create_typed_array(m_message_offsets.size(), m_message_offsets.data())
+    );
+    views.set("timestamps", create_typed_array(m_timestamps.size(), m_timestamps.data()));
+    views.set("logLevels", create_typed_array(m_log_levels.size(), m_log_levels.data()));
+    views.set("logEventNums", create_typed_array(m_log_event_nums.size(), m_log_event_nums.data()));
+    return views;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,92 @@
+#ifndef CLP_FFI_JS_IR_COLUMNARDECODEBUFFERS_HPP
+#define CLP_FFI_JS_IR_COLUMNARDECODEBUFFERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+#include <clp/type_utils.hpp>
+#include <emscripten/val.h>
+
+#include <clp_ffi_js/constants.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Buffers that hold a range of decoded log events in a columnar layout, so that they can be
+ * handed to JavaScript as typed-array views over wasm memory rather than one JS object per log
+ * event.
+ *
+ * The buffers are reused across decodes to avoid reallocating them.
+ */
+class ColumnarDecodeBuffers {
+public:
+    // Methods
+    /**
+     * Clears the buffers and reserves space for the given number of log events.
+     * @param num_log_events
+     */
+    auto reset(size_t num_log_events) -> void {
+        m_messages.clear();
+        m_message_offsets.clear();
+        m_timestamps.clear();
+        m_log_levels.clear();
+        m_log_event_nums.clear();
+
+        m_message_offsets.reserve(num_log_events + 1);
+        m_timestamps.reserve(num_log_events);
+        m_log_levels.reserve(num_log_events);
+        m_log_event_nums.reserve(num_log_events);
+        m_message_offsets.emplace_back(0);
+    }
+
+    /**
+     * Appends a decoded log event.
+     * @param message
+     * @param timestamp
+     * @param log_level
+     * @param log_event_num
+     */
+    auto append(
+            std::string_view message,
+            clp::ir::epoch_time_ms_t timestamp,
+            LogLevel log_level,
+            size_t log_event_num
+    ) -> void {
+        m_messages.append(message);
+        m_message_offsets.emplace_back(static_cast<uint32_t>(m_messages.size()));
+        m_timestamps.emplace_back(timestamp);
+        m_log_levels.emplace_back(clp::enum_to_underlying_type(log_level));
+        m_log_event_nums.emplace_back(static_cast<uint32_t>(log_event_num));
+    }
+
+    /**
+     * Creates typed-array views over the buffers.
+     *
+     * NOTE: The views are only valid until the buffers are next modified or the wasm memory grows,
+     * so callers must consume (or copy) them immediately. With pthreads, they're copies in
+     * non-shared buffers instead (see `create_typed_array`).
+     *
+     * @return An object containing:
+     * - `messages`: The UTF-8 encoded messages, concatenated.
+     * - `messageOffsets`: The offset of each message in `messages`, followed by the total length.
+     * - `timestamps`: Each log event's timestamp as milliseconds since the Unix epoch.
+     * - `logLevels`: Each log event's log level as an integer that indexes into `cLogLevelNames`.
+     * - `logEventNums`: Each log event's number (1-indexed) in the stream.
+     */
+    [[nodiscard]] auto create_views() const -> emscripten::val;
+
+private:
+    // Variables
+    std::string m_messages;
+    std::vector<uint32_t> m_message_offsets;
+    std::vector<clp::ir::epoch_time_ms_t> m_timestamps;
+    std::vector<std::underlying_type_t<LogLevel>> m_log_levels;
+    std::vector<uint32_t> m_log_event_nums;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_COLUMNARDECODEBUFFERS_HPP
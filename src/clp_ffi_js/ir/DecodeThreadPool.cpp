@@ -0,0 +1,115 @@
+#include "DecodeThreadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <mutex>
+#include <thread>
+
+#include <clp/ErrorCode.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+
+namespace clp_ffi_js::ir {
+auto DecodeThreadPool::get_instance() -> DecodeThreadPool& {
+#if CLP_FFI_JS_ENABLE_PTHREADS
+    static DecodeThreadPool pool{std::max<size_t>(std::thread::hardware_concurrency(), 1) - 1};
+#else
+    static DecodeThreadPool pool{0};
+#endif
+    return pool;
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+    {
+        std::scoped_lock const lock{m_mutex};
+        m_is_stopping = true;
+    }
+    m_batch_started.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+auto DecodeThreadPool::run(size_t num_tasks, TaskFunc const& task) -> void {
+    if (num_tasks > get_max_num_tasks()) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_BadParam,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Can't run {} tasks at once with {} threads.",
+                        num_tasks,
+                        get_max_num_tasks()
+                )
+        };
+    }
+    if (0 == num_tasks) {
+        return;
+    }
+    if (1 == num_tasks) {
+        task(0);
+        return;
+    }
+
+    {
+        std::scoped_lock const lock{m_mutex};
+        m_task = &task;
+        m_num_tasks = num_tasks;
+        m_num_unfinished_tasks = num_tasks - 1;
+        ++m_batch_idx;
+    }
+    m_batch_started.notify_all();
+
+    task(0);
+
+    std::unique_lock lock{m_mutex};
+    m_batch_finished.wait(lock, [&] { return 0 == m_num_unfinished_tasks; });
+    m_task = nullptr;
+}
+
+DecodeThreadPool::DecodeThreadPool(size_t num_threads) {
+#if CLP_FFI_JS_ENABLE_PTHREADS
+    m_threads.reserve(num_threads);
+    for (size_t thread_idx{0}; thread_idx < num_threads; ++thread_idx) {
+        m_threads.emplace_back([this, thread_idx] { run_thread(thread_idx); });
+    }
+#else
+    static_cast<void>(num_threads);
+#endif
+}
+
+auto DecodeThreadPool::run_thread(size_t thread_idx) -> void {
+    auto const task_idx{thread_idx + 1};
+    size_t last_batch_idx{0};
+    while (true) {
+        TaskFunc const* task{nullptr};
+        {
+            std::unique_lock lock{m_mutex};
+            m_batch_started.wait(lock, [&] {
+                return m_is_stopping || last_batch_idx != m_batch_idx;
+            });
+            if (m_is_stopping) {
+                return;
+            }
+            last_batch_idx = m_batch_idx;
+            if (task_idx >= m_num_tasks) {
+                continue;
+            }
+            task = m_task;
+        }
+
+        (*task)(task_idx);
+
+        bool is_batch_finished{false};
+        {
+            std::scoped_lock const lock{m_mutex};
+            --m_num_unfinished_tasks;
+            is_batch_finished = 0 == m_num_unfinished_tasks;
+        }
+        if (is_batch_finished) {
+            m_batch_finished.notify_one();
+        }
+    }
+}
+}  // namespace clp_ffi_js::ir
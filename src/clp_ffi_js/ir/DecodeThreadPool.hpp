@@ -0,0 +1,92 @@
+#ifndef CLP_FFI_JS_IR_DECODETHREADPOOL_HPP
+#define CLP_FFI_JS_IR_DECODETHREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace clp_ffi_js::ir {
+/**
+ * A fixed set of threads that are started once and reused to decode log events in parallel (see
+ * `parallel_decode`).
+ *
+ * Threads are started when the pool is first used and live until the module exits, since starting
+ * a thread for every decode would cost more than decoding small ranges.
+ *
+ * NOTE: With pthreads enabled, each thread occupies a worker from Emscripten's pthread pool, which
+ * is sized to fit all of them at link time (`-sPTHREAD_POOL_SIZE`). The calling thread blocks
+ * while tasks run, so the threads must not need the calling thread's event loop to start.
+ */
+class DecodeThreadPool {
+public:
+    // Types
+    /**
+     * Function to run the task at the given index. It must not throw.
+     */
+    using TaskFunc = std::function<void(size_t task_idx)>;
+
+    // Factory function
+    /**
+     * @return The module's pool, starting its threads on the first call. The pool has one thread
+     * fewer than the hardware's concurrency, since the calling thread also runs tasks; without
+     * pthreads, it has none.
+     */
+    [[nodiscard]] static auto get_instance() -> DecodeThreadPool&;
+
+    // Disable copy and move constructors and assignment operators
+    DecodeThreadPool(DecodeThreadPool const&) = delete;
+    DecodeThreadPool(DecodeThreadPool&&) = delete;
+    auto operator=(DecodeThreadPool const&) -> DecodeThreadPool& = delete;
+    auto operator=(DecodeThreadPool&&) -> DecodeThreadPool& = delete;
+
+    // Destructor
+    ~DecodeThreadPool();
+
+    // Methods
+    /**
+     * @return The maximum number of tasks that can run at once, including on the calling thread.
+     */
+    [[nodiscard]] auto get_max_num_tasks() const -> size_t { return m_threads.size() + 1; }
+
+    /**
+     * Runs tasks `0` to `num_tasks - 1` at once, with the calling thread running task `0` and the
+     * pool's threads running the others, and waits for all of them to finish.
+     *
+     * NOTE: The pool runs one batch of tasks at a time, so this must not be called concurrently.
+     *
+     * @param num_tasks
+     * @param task
+     * @throw ClpFfiJsException if `num_tasks` exceeds `get_max_num_tasks()`.
+     */
+    auto run(size_t num_tasks, TaskFunc const& task) -> void;
+
+private:
+    // Constructor
+    explicit DecodeThreadPool(size_t num_threads);
+
+    // Methods
+    /**
+     * Runs the task at `thread_idx + 1` in each batch that has one, until the pool is destroyed.
+     *
+     * @param thread_idx
+     */
+    auto run_thread(size_t thread_idx) -> void;
+
+    // Variables
+    std::mutex m_mutex;
+    std::condition_variable m_batch_started;
+    std::condition_variable m_batch_finished;
+    TaskFunc const* m_task{nullptr};
+    size_t m_num_tasks{0};
+    size_t m_num_unfinished_tasks{0};
+    // Incremented for each batch, so that threads can tell a new batch from the one they ran.
+    size_t m_batch_idx{0};
+    bool m_is_stopping{false};
+    std::vector<std::thread> m_threads;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_DECODETHREADPOOL_HPP
@@ -0,0 +1,17 @@
+#include "ExportBuffer.hpp"
+
+#include <cstdint>
+
+#include <emscripten/val.h>
+
+#include <clp_ffi_js/ir/typed_array.hpp>
+
+namespace clp_ffi_js::ir {
+auto ExportBuffer::create_view() const -> emscripten::val {
+    return create_typed_array(
+            m_chunk.size(),
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            reinterpret_cast<uint8_t const*>(m_chunk.data())
+    );
+}
+}  // namespace clp_ffi_js::ir
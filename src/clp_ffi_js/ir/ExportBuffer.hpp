@@ -0,0 +1,148 @@
+#ifndef CLP_FFI_JS_IR_EXPORTBUFFER_HPP
+#define CLP_FFI_JS_IR_EXPORTBUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <emscripten/val.h>
+
+namespace clp_ffi_js::ir {
+/**
+ * Buffer and cursor for exporting a range of log events as newline-delimited text (NDJSON for
+ * structured streams), in chunks handed to JavaScript as typed-array views over wasm memory, so
+ * that exporting a whole stream neither creates a JS value per log event nor holds the entire
+ * output in memory.
+ *
+ * Log events are decoded in batches of `cNumLogEventsPerBatch`, and each chunk is cut at the last
+ * line that fits within `cChunkSize` bytes. The log events of the batch that don't fit are decoded
+ * again for the next chunk. So a chunk only exceeds `cChunkSize` if it's a single line that does.
+ */
+class ExportBuffer {
+public:
+    // Constants
+    static constexpr size_t cChunkSize{size_t{8} * 1024 * 1024};
+    static constexpr size_t cNumLogEventsPerBatch{1024};
+
+    // Methods
+    /**
+     * Starts exporting the range `[begin_idx, end_idx)`, discarding any unfinished export.
+     *
+     * @param begin_idx
+     * @param end_idx
+     * @param use_filter Whether the range is in the filtered or unfiltered log events collection.
+     * @param filtered_log_event_map_generation The generation of the filtered log events map when
+     * the export started.
+     */
+    auto reset(
+            size_t begin_idx,
+            size_t end_idx,
+            bool use_filter,
+            size_t filtered_log_event_map_generation
+    ) -> void {
+        m_next_idx = begin_idx;
+        m_end_idx = end_idx;
+        m_use_filter = use_filter;
+        m_filtered_log_event_map_generation = filtered_log_event_map_generation;
+        m_chunk.clear();
+    }
+
+    [[nodiscard]] auto has_next_log_event() const -> bool { return m_next_idx < m_end_idx; }
+
+    [[nodiscard]] auto get_use_filter() const -> bool { return m_use_filter; }
+
+    [[nodiscard]] auto get_filtered_log_event_map_generation() const -> size_t {
+        return m_filtered_log_event_map_generation;
+    }
+
+    /**
+     * Clears the chunk and reserves space for a full chunk.
+     */
+    auto begin_chunk() -> void {
+        m_chunk.clear();
+        m_chunk.reserve(cChunkSize);
+        m_is_chunk_full = false;
+    }
+
+    [[nodiscard]] auto is_chunk_full() const -> bool { return m_is_chunk_full; }
+
+    /**
+     * Advances the cursor past the next batch of log events.
+     *
+     * @return The range of the batch, `[begin_idx, end_idx)`.
+     */
+    [[nodiscard]] auto take_next_batch() -> std::pair<size_t, size_t> {
+        auto const begin_idx{m_next_idx};
+        m_next_idx = std::min(m_end_idx, begin_idx + cNumLogEventsPerBatch);
+        m_next_line_idx = begin_idx;
+        return {begin_idx, m_next_idx};
+    }
+
+    /**
+     * Appends the next decoded log event of the batch to the chunk as a line, adding a trailing
+     * newline unless it already ends with one.
+     *
+     * The chunk is full once it reaches `cChunkSize`, or once a line doesn't fit within it (unless
+     * the chunk is empty). The rest of the batch is then dropped, and the cursor is moved back so
+     * that the next chunk starts with the first dropped line.
+     *
+     * @param decoded_log_event
+     */
+    auto append_line(std::string_view decoded_log_event) -> void {
+        auto const line_idx{m_next_line_idx++};
+        if (m_is_chunk_full) {
+            return;
+        }
+        auto const has_newline{decoded_log_event.ends_with('\n')};
+        auto const line_size{decoded_log_event.size() + (has_newline ? 0 : 1)};
+        if (false == m_chunk.empty() && m_chunk.size() + line_size > cChunkSize) {
+            m_is_chunk_full = true;
+            m_next_idx = line_idx;
+            return;
+        }
+        m_chunk.append(decoded_log_event);
+        if (false == has_newline) {
+            m_chunk.push_back('\n');
+        }
+        if (m_chunk.size() >= cChunkSize) {
+            m_is_chunk_full = true;
+            m_next_idx = line_idx + 1;
+        }
+    }
+
+    /**
+     * Creates a typed-array view over the chunk.
+     *
+     * NOTE: The view is only valid until the chunk is next modified or the wasm memory grows, so
+     * callers must consume (or copy) it immediately. With pthreads, it's a copy in a non-shared
+     * buffer instead (see `create_typed_array`).
+     *
+     * @return A `Uint8Array` view of the UTF-8 encoded chunk.
+     */
+    [[nodiscard]] auto create_view() const -> emscripten::val;
+
+    /**
+     * Releases the chunk's memory.
+     */
+    auto release() -> void {
+        m_end_idx = m_next_idx;
+        std::string{}.swap(m_chunk);
+    }
+
+    [[nodiscard]] auto get_heap_size() const -> size_t { return m_chunk.capacity(); }
+
+private:
+    // Variables
+    size_t m_next_idx{0};
+    size_t m_end_idx{0};
+    bool m_use_filter{false};
+    size_t m_filtered_log_event_map_generation{0};
+    size_t m_next_line_idx{0};
+    bool m_is_chunk_full{false};
+    std::string m_chunk;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_EXPORTBUFFER_HPP
@@ -0,0 +1,585 @@
+#include "FieldPredicate.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+#include <clp/TraceableException.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/ir/kv_pair_values.hpp>
+#include <clp_ffi_js/ir/StructuredLogEventJsonSerializer.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+using clp::ffi::SchemaTree;
+
+constexpr std::string_view cDelimiters{"()\"':=!<>"};
+
+/**
+ * @param c
+ * @param is_key Whether the word is a key, which also ends at a '.'.
+ * @return Whether `c` can be part of a bare word.
+ */
+[[nodiscard]] auto is_bare_word_char(char c, bool is_key) -> bool;
+
+/**
+ * @param lhs
+ * @param rhs
+ * @return Whether `lhs` and `rhs` are equal, ignoring the case of ASCII letters.
+ */
+[[nodiscard]] auto equals_ignoring_case(std::string_view lhs, std::string_view rhs) -> bool;
+
+/**
+ * @tparam T
+ * @param lhs
+ * @param rhs
+ * @return -1 if `lhs < rhs`, 1 if `lhs > rhs`, or 0 otherwise.
+ */
+template <typename T>
+[[nodiscard]] auto compare_values(T const& lhs, T const& rhs) -> int {
+    if (lhs < rhs) {
+        return -1;
+    }
+    if (rhs < lhs) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @param str
+ * @param[out] value Returns the integer parsed.
+ * @return Whether the whole of `str` was parsed as an integer.
+ */
+[[nodiscard]] auto parse_int(std::string_view str, clp::ffi::value_int_t& value) -> bool;
+
+/**
+ * @param str
+ * @param[out] value Returns the float parsed.
+ * @return Whether the whole of `str` was parsed as a finite float.
+ */
+[[nodiscard]] auto parse_float(std::string_view str, clp::ffi::value_float_t& value) -> bool;
+
+auto is_bare_word_char(char c, bool is_key) -> bool {
+    if (0 != std::isspace(static_cast<unsigned char>(c))) {
+        return false;
+    }
+    if (is_key && '.' == c) {
+        return false;
+    }
+    return std::string_view::npos == cDelimiters.find(c);
+}
+
+auto equals_ignoring_case(std::string_view lhs, std::string_view rhs) -> bool {
+    return std::ranges::equal(lhs, rhs, [](unsigned char l, unsigned char r) {
+        return std::tolower(l) == std::tolower(r);
+    });
+}
+
+auto parse_int(std::string_view str, clp::ffi::value_int_t& value) -> bool {
+    auto const* const end_ptr{str.data() + str.size()};
+    auto const [ptr, ec]{std::from_chars(str.data(), end_ptr, value)};
+    return std::errc{} == ec && end_ptr == ptr;
+}
+
+auto parse_float(std::string_view str, clp::ffi::value_float_t& value) -> bool {
+    // NOTE: We use `strtod` since not every standard library we target implements `from_chars` for
+    // floats.
+    std::string const null_terminated_str{str};
+    char* end_ptr{nullptr};
+    value = std::strtod(null_terminated_str.c_str(), &end_ptr);
+    return false == str.empty() && null_terminated_str.c_str() + str.size() == end_ptr
+           && std::isfinite(value);
+}
+}  // namespace
+
+/**
+ * Recursive-descent parser that builds a `FieldPredicate`'s expressions.
+ */
+class FieldPredicate::Parser {
+public:
+    // Constructor
+    Parser(std::string_view predicate, FieldPredicate& field_predicate)
+            : m_predicate{predicate},
+              m_field_predicate{field_predicate} {}
+
+    // Methods
+    /**
+     * @return The index of the root expression.
+     * @throw ClpFfiJsException if the predicate is invalid.
+     */
+    [[nodiscard]] auto parse() -> size_t;
+
+private:
+    // Methods
+    [[nodiscard]] auto parse_disjunction(size_t depth) -> size_t;
+
+    [[nodiscard]] auto parse_conjunction(size_t depth) -> size_t;
+
+    [[nodiscard]] auto parse_negation(size_t depth) -> size_t;
+
+    [[nodiscard]] auto parse_comparison() -> size_t;
+
+    [[nodiscard]] auto parse_key() -> std::string;
+
+    [[nodiscard]] auto parse_operator() -> Operator;
+
+    [[nodiscard]] auto parse_literal() -> Literal;
+
+    /**
+     * Parses a string enclosed in single or double quotes, in which a backslash escapes the next
+     * character.
+     */
+    [[nodiscard]] auto parse_quoted_string() -> std::string;
+
+    [[nodiscard]] auto parse_bare_word(bool is_key) -> std::string_view;
+
+    /**
+     * Consumes the given keyword if it's next, ignoring case.
+     *
+     * @param keyword
+     * @return Whether the keyword was consumed.
+     */
+    [[nodiscard]] auto consume_keyword(std::string_view keyword) -> bool;
+
+    /**
+     * Consumes the given token if it's next.
+     *
+     * @param token
+     * @return Whether the token was consumed.
+     */
+    [[nodiscard]] auto consume(std::string_view token) -> bool;
+
+    [[nodiscard]] auto is_next_quote() const -> bool {
+        if (m_pos == m_predicate.size()) {
+            return false;
+        }
+        auto const c{m_predicate[m_pos]};
+        return '"' == c || '\'' == c;
+    }
+
+    auto skip_whitespace() -> void;
+
+    /**
+     * @param expression
+     * @return The index of the added expression.
+     */
+    auto add_expression(Expression expression) -> size_t;
+
+    /**
+     * @param message
+     * @throw ClpFfiJsException describing the syntax error at the current position.
+     */
+    [[noreturn]] auto throw_syntax_error(std::string_view message) const -> void;
+
+    // Variables
+    std::string_view m_predicate;
+    size_t m_pos{0};
+    FieldPredicate& m_field_predicate;
+};
+
+auto FieldPredicate::Parser::parse() -> size_t {
+    skip_whitespace();
+    if (m_pos == m_predicate.size()) {
+        throw_syntax_error("Predicate is empty");
+    }
+    auto const root_idx{parse_disjunction(0)};
+    skip_whitespace();
+    if (m_pos != m_predicate.size()) {
+        throw_syntax_error("Expected \"and\", \"or\", or the end of the predicate");
+    }
+    return root_idx;
+}
+
+auto FieldPredicate::Parser::parse_disjunction(size_t depth) -> size_t {
+    Expression disjunction{.type = Expression::Type::Or, .operands = {parse_conjunction(depth)}};
+    while (consume_keyword("or")) {
+        disjunction.operands.emplace_back(parse_conjunction(depth));
+    }
+    if (1 == disjunction.operands.size()) {
+        return disjunction.operands.front();
+    }
+    return add_expression(std::move(disjunction));
+}
+
+auto FieldPredicate::Parser::parse_conjunction(size_t depth) -> size_t {
+    Expression conjunction{.type = Expression::Type::And, .operands = {parse_negation(depth)}};
+    while (consume_keyword("and")) {
+        conjunction.operands.emplace_back(parse_negation(depth));
+    }
+    if (1 == conjunction.operands.size()) {
+        return conjunction.operands.front();
+    }
+    return add_expression(std::move(conjunction));
+}
+
+auto FieldPredicate::Parser::parse_negation(size_t depth) -> size_t {
+    if (depth >= cMaxNestingDepth) {
+        throw_syntax_error("Predicate is nested too deeply");
+    }
+    if (consume_keyword("not")) {
+        auto const operand_idx{parse_negation(depth + 1)};
+        return add_expression({.type = Expression::Type::Not, .operands = {operand_idx}});
+    }
+    if (consume("(")) {
+        auto const expression_idx{parse_disjunction(depth + 1)};
+        if (false == consume(")")) {
+            throw_syntax_error("Expected \")\"");
+        }
+        return expression_idx;
+    }
+    return parse_comparison();
+}
+
+auto FieldPredicate::Parser::parse_comparison() -> size_t {
+    Comparison comparison;
+    comparison.key_path.emplace_back(parse_key());
+    while (m_pos < m_predicate.size() && '.' == m_predicate[m_pos]) {
+        ++m_pos;
+        comparison.key_path.emplace_back(parse_key());
+    }
+    comparison.op = parse_operator();
+    comparison.literal = parse_literal();
+
+    auto& comparisons{m_field_predicate.m_comparisons};
+    comparisons.emplace_back(std::move(comparison));
+    auto const comparison_idx{comparisons.size() - 1};
+    return add_expression({.type = Expression::Type::Comparison, .operands = {comparison_idx}});
+}
+
+auto FieldPredicate::Parser::parse_key() -> std::string {
+    skip_whitespace();
+    if (is_next_quote()) {
+        return parse_quoted_string();
+    }
+    auto const key{parse_bare_word(true)};
+    if (key.empty()) {
+        throw_syntax_error("Expected a key");
+    }
+    return std::string{key};
+}
+
+auto FieldPredicate::Parser::parse_operator() -> Operator {
+    // NOTE: Two-character operators must be checked before their one-character prefixes.
+    if (consume("==") || consume(":")) {
+        return Operator::Equal;
+    }
+    if (consume("!=")) {
+        return Operator::NotEqual;
+    }
+    if (consume("<=")) {
+        return Operator::LessOrEqual;
+    }
+    if (consume(">=")) {
+        return Operator::GreaterOrEqual;
+    }
+    if (consume("<")) {
+        return Operator::Less;
+    }
+    if (consume(">")) {
+        return Operator::Greater;
+    }
+    throw_syntax_error("Expected one of \":\", \"==\", \"!=\", \"<\", \"<=\", \">\", or \">=\"");
+}
+
+auto FieldPredicate::Parser::parse_literal() -> Literal {
+    skip_whitespace();
+    Literal literal;
+    if (is_next_quote()) {
+        literal.type = Literal::Type::String;
+        literal.text = parse_quoted_string();
+        return literal;
+    }
+
+    auto const word{parse_bare_word(false)};
+    if (word.empty()) {
+        throw_syntax_error("Expected a value");
+    }
+    literal.text = word;
+    if (equals_ignoring_case(word, "null")) {
+        literal.type = Literal::Type::Null;
+    } else if (equals_ignoring_case(word, "true") || equals_ignoring_case(word, "false")) {
+        literal.type = Literal::Type::Bool;
+        literal.bool_value = equals_ignoring_case(word, "true");
+    } else if (parse_int(word, literal.int_value)) {
+        literal.type = Literal::Type::Int;
+    } else if (parse_float(word, literal.float_value)) {
+        literal.type = Literal::Type::Float;
+    } else {
+        literal.type = Literal::Type::String;
+    }
+    return literal;
+}
+
+auto FieldPredicate::Parser::parse_quoted_string() -> std::string {
+    auto const quote{m_predicate[m_pos]};
+    ++m_pos;
+    std::string str;
+    while (m_pos < m_predicate.size()) {
+        auto const c{m_predicate[m_pos]};
+        ++m_pos;
+        if (quote == c) {
+            return str;
+        }
+        if ('\\' == c) {
+            if (m_pos == m_predicate.size()) {
+                break;
+            }
+            str += m_predicate[m_pos];
+            ++m_pos;
+            continue;
+        }
+        str += c;
+    }
+    throw_syntax_error("Unterminated quoted string");
+}
+
+auto FieldPredicate::Parser::parse_bare_word(bool is_key) -> std::string_view {
+    auto const begin_pos{m_pos};
+    while (m_pos < m_predicate.size() && is_bare_word_char(m_predicate[m_pos], is_key)) {
+        ++m_pos;
+    }
+    return m_predicate.substr(begin_pos, m_pos - begin_pos);
+}
+
+auto FieldPredicate::Parser::consume_keyword(std::string_view keyword) -> bool {
+    skip_whitespace();
+    auto const end_pos{m_pos + keyword.size()};
+    if (end_pos > m_predicate.size()
+        || false == equals_ignoring_case(m_predicate.substr(m_pos, keyword.size()), keyword)
+        || (end_pos < m_predicate.size() && is_bare_word_char(m_predicate[end_pos], false)))
+    {
+        return false;
+    }
+    m_pos = end_pos;
+    return true;
+}
+
+auto FieldPredicate::Parser::consume(std::string_view token) -> bool {
+    skip_whitespace();
+    if (false == m_predicate.substr(m_pos).starts_with(token)) {
+        return false;
+    }
+    m_pos += token.size();
+    return true;
+}
+
+auto FieldPredicate::Parser::skip_whitespace() -> void {
+    while (m_pos < m_predicate.size()
+           && 0 != std::isspace(static_cast<unsigned char>(m_predicate[m_pos])))
+    {
+        ++m_pos;
+    }
+}
+
+auto FieldPredicate::Parser::add_expression(Expression expression) -> size_t {
+    auto& expressions{m_field_predicate.m_expressions};
+    expressions.emplace_back(std::move(expression));
+    return expressions.size() - 1;
+}
+
+auto FieldPredicate::Parser::throw_syntax_error(std::string_view message) const -> void {
+    throw ClpFfiJsException{
+            clp::ErrorCode::ErrorCode_BadParam,
+            __FILENAME__,
+            __LINE__,
+            std::format("Invalid predicate \"{}\" at position {}: {}", m_predicate, m_pos, message)
+    };
+}
+
+FieldPredicate::FieldPredicate(std::string_view predicate) {
+    m_root_expression_idx = Parser{predicate, *this}.parse();
+}
+
+auto FieldPredicate::matches(clp::ffi::KeyValuePairLogEvent const& log_event) -> bool {
+    auto const& schema_tree{log_event.get_schema_tree()};
+    if (m_resolved_schema_tree_size != schema_tree.get_size()) {
+        resolve_key_paths(schema_tree);
+    }
+    return evaluate(m_root_expression_idx, log_event);
+}
+
+auto FieldPredicate::resolve_key_paths(SchemaTree const& schema_tree) -> void {
+    for (auto& comparison : m_comparisons) {
+        comparison.node_ids = StructuredLogEventJsonSerializer::resolve_key_path(
+                schema_tree,
+                comparison.key_path
+        );
+    }
+    m_resolved_schema_tree_size = schema_tree.get_size();
+}
+
+auto FieldPredicate::evaluate(
+        size_t expression_idx,
+        clp::ffi::KeyValuePairLogEvent const& log_event
+) const -> bool {
+    auto const& expression{m_expressions[expression_idx]};
+    auto evaluate_operand = [&](size_t operand_idx) -> bool {
+        return evaluate(operand_idx, log_event);
+    };
+    switch (expression.type) {
+        case Expression::Type::And:
+            return std::ranges::all_of(expression.operands, evaluate_operand);
+        case Expression::Type::Or:
+            return std::ranges::any_of(expression.operands, evaluate_operand);
+        case Expression::Type::Not:
+            return false == evaluate_operand(expression.operands.front());
+        case Expression::Type::Comparison:
+            return evaluate_comparison(m_comparisons[expression.operands.front()], log_event);
+        default:
+            return false;
+    }
+}
+
+auto FieldPredicate::evaluate_comparison(
+        Comparison const& comparison,
+        clp::ffi::KeyValuePairLogEvent const& log_event
+) -> bool {
+    auto const& schema_tree{log_event.get_schema_tree()};
+    auto const& node_id_value_pairs{log_event.get_node_id_value_pairs()};
+
+    // At most one of the key path's nodes has a value in any given log event.
+    std::optional<clp::ffi::Value> const* value{nullptr};
+    auto type{SchemaTree::Node::Type::Obj};
+    for (auto const node_id : comparison.node_ids) {
+        auto const pair_it{node_id_value_pairs.find(node_id)};
+        if (node_id_value_pairs.end() != pair_it) {
+            value = &pair_it->second;
+            type = schema_tree.get_node(node_id).get_type();
+            break;
+        }
+    }
+
+    if (Operator::Equal == comparison.op) {
+        return is_equal(value, type, comparison.literal);
+    }
+    if (Operator::NotEqual == comparison.op) {
+        return false == is_equal(value, type, comparison.literal);
+    }
+    if (nullptr == value || false == value->has_value()) {
+        return false;
+    }
+    auto const result{compare(value->value(), type, comparison.literal)};
+    if (false == result.has_value()) {
+        return false;
+    }
+    switch (comparison.op) {
+        case Operator::Less:
+            return result.value() < 0;
+        case Operator::LessOrEqual:
+            return result.value() <= 0;
+        case Operator::Greater:
+            return result.value() > 0;
+        case Operator::GreaterOrEqual:
+            return result.value() >= 0;
+        default:
+            return false;
+    }
+}
+
+auto FieldPredicate::is_equal(
+        std::optional<clp::ffi::Value> const* value,
+        SchemaTree::Node::Type type,
+        Literal const& literal
+) -> bool {
+    if (nullptr == value) {
+        return Literal::Type::Null == literal.type;
+    }
+    if (false == value->has_value()) {
+        // The value is an empty object.
+        return false;
+    }
+    auto const& kv_value{value->value()};
+    if (kv_value.is_null() || Literal::Type::Null == literal.type) {
+        return kv_value.is_null() && Literal::Type::Null == literal.type;
+    }
+
+    switch (type) {
+        case SchemaTree::Node::Type::Bool:
+            return Literal::Type::Bool == literal.type && kv_value.is<clp::ffi::value_bool_t>()
+                   && kv_value.get_immutable_view<clp::ffi::value_bool_t>() == literal.bool_value;
+        case SchemaTree::Node::Type::Str: {
+            if (Literal::Type::Bool == literal.type) {
+                return false;
+            }
+            std::string decoded;
+            auto const str{get_string_value(kv_value, decoded)};
+            return str.has_value() && str.value() == literal.text;
+        }
+        case SchemaTree::Node::Type::Int:
+        case SchemaTree::Node::Type::Float:
+            return compare(kv_value, type, literal) == 0;
+        default:
+            return false;
+    }
+}
+
+auto FieldPredicate::compare(
+        clp::ffi::Value const& value,
+        SchemaTree::Node::Type type,
+        Literal const& literal
+) -> std::optional<int> {
+    switch (type) {
+        case SchemaTree::Node::Type::Int: {
+            if (false == value.is<clp::ffi::value_int_t>()) {
+                return std::nullopt;
+            }
+            auto const int_value{value.get_immutable_view<clp::ffi::value_int_t>()};
+            if (Literal::Type::Int == literal.type) {
+                return compare_values(int_value, literal.int_value);
+            }
+            if (Literal::Type::Float == literal.type) {
+                return compare_values(
+                        static_cast<clp::ffi::value_float_t>(int_value),
+                        literal.float_value
+                );
+            }
+            return std::nullopt;
+        }
+        case SchemaTree::Node::Type::Float: {
+            if (false == value.is<clp::ffi::value_float_t>()) {
+                return std::nullopt;
+            }
+            auto const float_value{value.get_immutable_view<clp::ffi::value_float_t>()};
+            if (Literal::Type::Int == literal.type) {
+                return compare_values(
+                        float_value,
+                        static_cast<clp::ffi::value_float_t>(literal.int_value)
+                );
+            }
+            if (Literal::Type::Float == literal.type) {
+                return compare_values(float_value, literal.float_value);
+            }
+            return std::nullopt;
+        }
+        case SchemaTree::Node::Type::Str: {
+            if (Literal::Type::String != literal.type) {
+                return std::nullopt;
+            }
+            std::string decoded;
+            auto const str{get_string_value(value, decoded)};
+            if (false == str.has_value()) {
+                return std::nullopt;
+            }
+            return compare_values(str.value(), std::string_view{literal.text});
+        }
+        default:
+            return std::nullopt;
+    }
+}
+}  // namespace clp_ffi_js::ir
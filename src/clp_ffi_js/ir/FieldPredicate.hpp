@@ -0,0 +1,175 @@
+#ifndef CLP_FFI_JS_IR_FIELDPREDICATE_HPP
+#define CLP_FFI_JS_IR_FIELDPREDICATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * A predicate over the kv-pairs of structured log events, written in a subset of KQL, e.g.:
+ *
+ *   service: "api" and (status >= 500 or not retried: true)
+ *
+ * Grammar (keywords are case-insensitive):
+ * - predicate := disjunction
+ * - disjunction := conjunction ("or" conjunction)*
+ * - conjunction := negation ("and" negation)*
+ * - negation := "not" negation | "(" disjunction ")" | comparison
+ * - comparison := key_path operator literal
+ * - key_path := key ("." key)*, where each key is a quoted string or a bare word
+ * - operator := ":" | "==" | "!=" | "<" | "<=" | ">" | ">="
+ * - literal := a quoted string, a number, `true`, `false`, `null`, or a bare word (as a string)
+ *
+ * `:` and `==` are equivalent, and `!=` is always their negation. A number literal matches both
+ * numeric values and string values with the same text. `key == null` matches log events where the
+ * key is null or missing. Ordering operators only match numeric values against number literals,
+ * and string values against string literals (lexicographically).
+ *
+ * Key paths are resolved against the schema tree of the log events being matched, and the
+ * predicate is then evaluated directly over each log event's node-ID-value pairs.
+ *
+ * NOTE: `matches` isn't thread-safe since it caches the resolved key paths.
+ */
+class FieldPredicate {
+public:
+    // Constants
+    static constexpr size_t cMaxNestingDepth{64};
+
+    // Constructor
+    /**
+     * @param predicate
+     * @throw ClpFfiJsException if `predicate` is invalid.
+     */
+    explicit FieldPredicate(std::string_view predicate);
+
+    // Methods
+    /**
+     * @param log_event
+     * @return Whether the log event matches the predicate.
+     */
+    [[nodiscard]] auto matches(clp::ffi::KeyValuePairLogEvent const& log_event) -> bool;
+
+private:
+    // Types
+    class Parser;
+
+    enum class Operator : uint8_t {
+        Equal,
+        NotEqual,
+        Less,
+        LessOrEqual,
+        Greater,
+        GreaterOrEqual,
+    };
+
+    struct Literal {
+        enum class Type : uint8_t {
+            Null,
+            Bool,
+            Int,
+            Float,
+            String,
+        };
+
+        Type type{Type::Null};
+        bool bool_value{false};
+        clp::ffi::value_int_t int_value{0};
+        clp::ffi::value_float_t float_value{0};
+        // The literal's text, which number literals are also compared to string values with.
+        std::string text;
+    };
+
+    struct Comparison {
+        std::vector<std::string> key_path;
+        Operator op{Operator::Equal};
+        Literal literal;
+        // The schema-tree nodes that `key_path` resolves to.
+        std::vector<clp::ffi::SchemaTree::Node::id_t> node_ids;
+    };
+
+    struct Expression {
+        enum class Type : uint8_t {
+            And,
+            Or,
+            Not,
+            Comparison,
+        };
+
+        Type type{Type::Comparison};
+        // The indices of the operand expressions, or the index of the comparison in
+        // `m_comparisons` if the expression is a comparison.
+        std::vector<size_t> operands;
+    };
+
+    // Methods
+    /**
+     * Resolves every comparison's key path against the given schema tree.
+     *
+     * @param schema_tree
+     */
+    auto resolve_key_paths(clp::ffi::SchemaTree const& schema_tree) -> void;
+
+    /**
+     * @param expression_idx
+     * @param log_event
+     * @return Whether the log event matches the expression.
+     */
+    [[nodiscard]] auto
+    evaluate(size_t expression_idx, clp::ffi::KeyValuePairLogEvent const& log_event) const -> bool;
+
+    /**
+     * @param comparison
+     * @param log_event
+     * @return Whether the log event matches `comparison`.
+     */
+    [[nodiscard]] static auto evaluate_comparison(
+            Comparison const& comparison,
+            clp::ffi::KeyValuePairLogEvent const& log_event
+    ) -> bool;
+
+    /**
+     * @param value The value of the comparison's key, or nullptr if the log event doesn't contain
+     * the key.
+     * @param type The type of the value's schema-tree node.
+     * @param literal
+     * @return The result of comparing the value to `literal` for equality.
+     */
+    [[nodiscard]] static auto is_equal(
+            std::optional<clp::ffi::Value> const* value,
+            clp::ffi::SchemaTree::Node::Type type,
+            Literal const& literal
+    ) -> bool;
+
+    /**
+     * @param value
+     * @param type The type of the value's schema-tree node.
+     * @param literal
+     * @return The result of comparing the value to `literal` (negative if the value is less,
+     * positive if it's greater), or std::nullopt if they can't be ordered.
+     */
+    [[nodiscard]] static auto compare(
+            clp::ffi::Value const& value,
+            clp::ffi::SchemaTree::Node::Type type,
+            Literal const& literal
+    ) -> std::optional<int>;
+
+    // Variables
+    std::vector<Comparison> m_comparisons;
+    std::vector<Expression> m_expressions;
+    size_t m_root_expression_idx{0};
+
+    // The size of the schema tree that the key paths were last resolved against. Since schema trees
+    // only grow, the key paths only need to be resolved again when the size changes.
+    std::optional<size_t> m_resolved_schema_tree_size;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_FIELDPREDICATE_HPP
@@ -0,0 +1,113 @@
+#include "FilterCache.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clp_ffi_js::ir {
+auto FilterCache::activate(
+        std::string_view key,
+        size_t num_log_events,
+        FilteredLogEventsMap& filtered_log_event_map
+) -> bool {
+    auto const it{std::ranges::find(m_entries, key, &Entry::key)};
+    if (m_entries.end() == it) {
+        return false;
+    }
+    if (m_has_active_entry && m_entries.begin() == it) {
+        update_active(num_log_events, filtered_log_event_map);
+        return true;
+    }
+
+    deactivate(filtered_log_event_map);
+    ++m_generation;
+    m_entries.splice(m_entries.begin(), m_entries, it);
+    m_has_active_entry = true;
+    filtered_log_event_map.emplace(std::move(it->log_event_indices));
+    it->log_event_indices = {};
+    update_active(num_log_events, filtered_log_event_map);
+    return true;
+}
+
+auto FilterCache::deactivate(FilteredLogEventsMap& filtered_log_event_map) -> void {
+    if (m_has_active_entry) {
+        m_has_active_entry = false;
+        if (filtered_log_event_map.has_value()) {
+            m_entries.front().log_event_indices = std::move(filtered_log_event_map.value());
+        } else {
+            // The map was reset without deactivating the filter, so the filter's result is lost.
+            m_entries.pop_front();
+        }
+    }
+    if (filtered_log_event_map.has_value()) {
+        filtered_log_event_map.reset();
+        ++m_generation;
+    }
+}
+
+auto FilterCache::insert(
+        std::string key,
+        FilterFunc filter,
+        std::vector<size_t>&& log_event_indices,
+        size_t num_log_events,
+        FilteredLogEventsMap& filtered_log_event_map
+) -> void {
+    deactivate(filtered_log_event_map);
+    ++m_generation;
+    if (auto const it{std::ranges::find(m_entries, key, &Entry::key)}; m_entries.end() != it) {
+        m_entries.erase(it);
+    }
+    m_entries.emplace_front(Entry{std::move(key), std::move(filter), {}, num_log_events});
+    m_has_active_entry = true;
+    filtered_log_event_map.emplace(std::move(log_event_indices));
+    while (m_entries.size() > cMaxNumEntries) {
+        m_entries.pop_back();
+    }
+}
+
+auto FilterCache::update_active(
+        size_t num_log_events,
+        FilteredLogEventsMap& filtered_log_event_map
+) -> void {
+    if (false == m_has_active_entry || false == filtered_log_event_map.has_value()) {
+        return;
+    }
+    auto& entry{m_entries.front()};
+    if (entry.num_log_events >= num_log_events) {
+        return;
+    }
+    auto& log_event_indices{filtered_log_event_map.value()};
+    auto const num_log_event_indices_before{log_event_indices.size()};
+    entry.filter(entry.num_log_events, num_log_events, log_event_indices);
+    entry.num_log_events = num_log_events;
+    if (log_event_indices.size() != num_log_event_indices_before) {
+        ++m_generation;
+    }
+}
+
+auto FilterCache::get_heap_size() const -> size_t {
+    // Each element of a list is allocated individually alongside pointers to the next and
+    // previous elements.
+    constexpr size_t cListNodeOverhead{2 * sizeof(void*)};
+
+    size_t size{0};
+    for (auto const& entry : m_entries) {
+        size += sizeof(Entry) + cListNodeOverhead + entry.key.capacity()
+                + entry.log_event_indices.capacity() * sizeof(size_t);
+    }
+    return size;
+}
+
+auto FilterCache::shrink_to_fit(FilteredLogEventsMap& filtered_log_event_map) -> void {
+    m_entries.resize(m_has_active_entry ? 1 : 0);
+    if (filtered_log_event_map.has_value()
+        && filtered_log_event_map->capacity() != filtered_log_event_map->size())
+    {
+        filtered_log_event_map->shrink_to_fit();
+        ++m_generation;
+    }
+}
+}  // namespace clp_ffi_js::ir
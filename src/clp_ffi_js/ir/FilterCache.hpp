@@ -0,0 +1,259 @@
+#ifndef CLP_FFI_JS_IR_FILTERCACHE_HPP
+#define CLP_FFI_JS_IR_FILTERCACHE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Function that appends the indices of the log events in `[begin_idx, end_idx)` that pass a filter
+ * to `log_event_indices`, in ascending order.
+ */
+using FilterFunc = std::function<
+        void(size_t begin_idx, size_t end_idx, std::vector<size_t>& log_event_indices)>;
+
+/**
+ * Cache of the results of the most recently applied filters, keyed by a description of each
+ * filter (e.g., its log levels or query), so that switching back to a previous filter doesn't
+ * evaluate it again.
+ *
+ * At most one filter is active: the one whose result is the reader's filtered log events map. The
+ * active filter's result lives in the map rather than in the cache, so switching between cached
+ * filters only moves vectors.
+ *
+ * Results are kept up to date with log events deserialized after they were computed by evaluating
+ * the filter on only the new log events: for the active filter, after each deserialization (see
+ * `update_active`), and for other filters, when they're activated again.
+ *
+ * The cache also counts the changes made to the filtered log events map through it (see
+ * `get_generation`), so that JS can tell whether a view of the map is stale.
+ *
+ * Lastly, the cache holds the components of the reader's filter, which are set separately so that
+ * each can be replaced without the others: a base filter (log levels or a search), a predicate, and
+ * a time range. The active filter passes the log events that pass all of them.
+ *
+ * NOTE: Filters may reference the reader's members, so they must not outlive the reader.
+ */
+class FilterCache {
+public:
+    // Types
+    using FilteredLogEventsMap = std::optional<std::vector<size_t>>;
+    // Function that returns whether the log event with the given index passes a predicate
+    using PredicateFunc = std::function<bool(size_t log_event_idx)>;
+    using TimeRange = std::pair<clp::ir::epoch_time_ms_t, clp::ir::epoch_time_ms_t>;
+
+    // Constants
+    static constexpr size_t cMaxNumEntries{8};
+
+    // Methods
+    /**
+     * Activates the cached filter with the given key, if any, moving its result into
+     * `filtered_log_event_map` and bringing it up to date. The previously active filter's result is
+     * moved back into the cache.
+     *
+     * @param key
+     * @param num_log_events The number of log events deserialized so far.
+     * @param[in,out] filtered_log_event_map
+     * @return Whether the filter was cached.
+     */
+    auto activate(
+            std::string_view key,
+            size_t num_log_events,
+            FilteredLogEventsMap& filtered_log_event_map
+    ) -> bool;
+
+    /**
+     * Deactivates the active filter, if any, moving its result from `filtered_log_event_map` back
+     * into the cache.
+     *
+     * @param[in,out] filtered_log_event_map Returns an empty map.
+     */
+    auto deactivate(FilteredLogEventsMap& filtered_log_event_map) -> void;
+
+    /**
+     * Deactivates the active filter, if any, and then caches the given filter and makes it the
+     * active filter, evicting the least recently used filters as necessary.
+     *
+     * @param key
+     * @param filter
+     * @param log_event_indices The filter's result.
+     * @param num_log_events The number of log events the result was computed from.
+     * @param[out] filtered_log_event_map Returns the filter's result.
+     */
+    auto insert(
+            std::string key,
+            FilterFunc filter,
+            std::vector<size_t>&& log_event_indices,
+            size_t num_log_events,
+            FilteredLogEventsMap& filtered_log_event_map
+    ) -> void;
+
+    /**
+     * Evaluates the active filter, if any, on the log events deserialized since it was last
+     * evaluated, appending those that pass to `filtered_log_event_map`.
+     *
+     * @param num_log_events The number of log events deserialized so far.
+     * @param[in,out] filtered_log_event_map
+     */
+    auto update_active(size_t num_log_events, FilteredLogEventsMap& filtered_log_event_map)
+            -> void;
+
+    /**
+     * Sets the base filter, without changing the active filter.
+     *
+     * @param key The key under which the filter's result is cached.
+     * @param filter
+     */
+    auto set_base_filter(std::string key, FilterFunc filter) -> void {
+        m_base_filter_key = std::move(key);
+        m_base_filter = std::move(filter);
+    }
+
+    /**
+     * Removes the base filter, without changing the active filter.
+     */
+    auto reset_base_filter() -> void { set_base_filter({}, nullptr); }
+
+    /**
+     * @return The base filter's key, or an empty string if there's no base filter.
+     */
+    [[nodiscard]] auto get_base_filter_key() const -> std::string const& {
+        return m_base_filter_key;
+    }
+
+    /**
+     * @return The base filter, or nullptr if there's no base filter.
+     */
+    [[nodiscard]] auto get_base_filter() const -> FilterFunc const& { return m_base_filter; }
+
+    /**
+     * Sets the predicate, replacing any previous predicate, without changing the active filter.
+     *
+     * @param key The key that identifies the predicate within the keys of the cached results.
+     * @param predicate
+     */
+    auto set_predicate(std::string key, PredicateFunc predicate) -> void {
+        m_predicate_key = std::move(key);
+        m_predicate = std::move(predicate);
+    }
+
+    /**
+     * Removes the predicate, without changing the active filter.
+     */
+    auto reset_predicate() -> void { set_predicate({}, nullptr); }
+
+    /**
+     * @return The predicate's key, or an empty string if there's no predicate.
+     */
+    [[nodiscard]] auto get_predicate_key() const -> std::string const& {
+        return m_predicate_key;
+    }
+
+    /**
+     * @return The predicate, or nullptr if there's no predicate.
+     */
+    [[nodiscard]] auto get_predicate() const -> PredicateFunc const& { return m_predicate; }
+
+    /**
+     * Sets (or removes) the time range, without changing the active filter.
+     *
+     * @param time_range The range `[begin_ts, end_ts)`, or std::nullopt to remove it.
+     */
+    auto set_time_range(std::optional<TimeRange> time_range) -> void { m_time_range = time_range; }
+
+    [[nodiscard]] auto get_time_range() const -> std::optional<TimeRange> const& {
+        return m_time_range;
+    }
+
+    /**
+     * @return The number of times the filtered log events map has been changed through the cache.
+     * Any view of the map taken before the number last changed is stale.
+     */
+    [[nodiscard]] auto get_generation() const -> size_t { return m_generation; }
+
+    /**
+     * @return The number of bytes held by the cached results.
+     */
+    [[nodiscard]] auto get_heap_size() const -> size_t;
+
+    /**
+     * Evicts every filter except the active one, and releases the capacity reserved but unused by
+     * `filtered_log_event_map`.
+     *
+     * @param[in,out] filtered_log_event_map
+     */
+    auto shrink_to_fit(FilteredLogEventsMap& filtered_log_event_map) -> void;
+
+private:
+    // Types
+    struct Entry {
+        std::string key;
+        FilterFunc filter;
+        // The filter's result, unless the filter is active
+        std::vector<size_t> log_event_indices;
+        // The number of log events the result was computed from
+        size_t num_log_events;
+    };
+
+    // Variables
+    // From most to least recently used. If a filter is active, it's the first entry.
+    std::list<Entry> m_entries;
+    bool m_has_active_entry{false};
+    size_t m_generation{0};
+    std::string m_base_filter_key;
+    FilterFunc m_base_filter;
+    std::string m_predicate_key;
+    PredicateFunc m_predicate;
+    std::optional<TimeRange> m_time_range;
+};
+
+/**
+ * Creates a filter that passes the log events passing `base_filter` (or every log event, if
+ * `base_filter` is empty) for which `matches` returns true.
+ *
+ * @tparam MatchFunc
+ * @param base_filter
+ * @param matches
+ * @return The created filter.
+ */
+template <typename MatchFunc>
+requires std::is_invocable_r_v<bool, MatchFunc&, size_t>
+[[nodiscard]] auto compose_filter(FilterFunc base_filter, MatchFunc matches) -> FilterFunc {
+    return [base_filter = std::move(base_filter), matches = std::move(matches)](
+                   size_t begin_idx,
+                   size_t end_idx,
+                   std::vector<size_t>& log_event_indices
+           ) mutable {
+        if (nullptr == base_filter) {
+            for (auto log_event_idx{begin_idx}; log_event_idx < end_idx; ++log_event_idx) {
+                if (matches(log_event_idx)) {
+                    log_event_indices.emplace_back(log_event_idx);
+                }
+            }
+            return;
+        }
+
+        auto const num_log_event_indices_before{log_event_indices.size()};
+        base_filter(begin_idx, end_idx, log_event_indices);
+        auto const removed{std::ranges::remove_if(
+                log_event_indices.begin()
+                        + static_cast<std::ptrdiff_t>(num_log_event_indices_before),
+                log_event_indices.end(),
+                [&](size_t log_event_idx) { return false == matches(log_event_idx); }
+        )};
+        log_event_indices.erase(removed.begin(), removed.end());
+    };
+}
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_FILTERCACHE_HPP
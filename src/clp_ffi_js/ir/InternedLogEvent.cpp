@@ -0,0 +1,146 @@
+#include "InternedLogEvent.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <clp/ffi/encoding_methods.hpp>
+#include <clp/ir/types.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+using encoded_variable_t = InternedLogEvent::encoded_variable_t;
+
+/**
+ * Decodes the given encoded integer variable, appending it to `output`.
+ *
+ * Equivalent to `clp::ffi::decode_integer_var`, except the variable is decoded without a temporary
+ * string.
+ * @param encoded_var
+ * @param output
+ */
+auto append_decoded_integer_var(encoded_variable_t encoded_var, std::string& output) -> void;
+
+/**
+ * Decodes the given encoded float variable, appending it to `output`.
+ *
+ * Equivalent to `clp::ffi::decode_float_var`, except the variable is decoded directly into
+ * `output` rather than into a temporary string.
+ * @param encoded_var
+ * @param output
+ * @return Whether the variable was decoded successfully, i.e., whether its encoded properties are
+ * consistent.
+ */
+[[nodiscard]] auto append_decoded_float_var(encoded_variable_t encoded_var, std::string& output)
+        -> bool;
+
+auto append_decoded_integer_var(encoded_variable_t encoded_var, std::string& output) -> void {
+    // Enough for every digit and the sign.
+    std::array<char, std::numeric_limits<encoded_variable_t>::digits10 + 2> buf{};
+    auto const result{std::to_chars(buf.data(), buf.data() + buf.size(), encoded_var)};
+    output.append(buf.data(), result.ptr);
+}
+
+auto append_decoded_float_var(encoded_variable_t encoded_var, std::string& output) -> bool {
+    bool is_negative{false};
+    uint32_t digits{0};
+    size_t num_digits{0};
+    size_t decimal_point_pos{0};
+    clp::ffi::decode_float_properties(
+            encoded_var,
+            is_negative,
+            digits,
+            num_digits,
+            decimal_point_pos
+    );
+    if (num_digits < decimal_point_pos) {
+        return false;
+    }
+
+    // Reserve space for the sign, digits, and decimal point, padding the digits with zeros, then
+    // write the digits backwards from the least significant one.
+    auto const begin_pos{output.size()};
+    auto const sign_len{static_cast<size_t>(is_negative)};
+    output.resize(begin_pos + sign_len + num_digits + 1, '0');
+    if (is_negative) {
+        output[begin_pos] = '-';
+    }
+    auto const decimal_point_idx{output.size() - 1 - decimal_point_pos};
+    output[decimal_point_idx] = '.';
+    auto const digits_begin_pos{begin_pos + sign_len};
+    auto pos{output.size()};
+    while (digits > 0) {
+        if (digits_begin_pos == pos) {
+            // There are more digits than `num_digits`.
+            return false;
+        }
+        --pos;
+        if (decimal_point_idx == pos) {
+            continue;
+        }
+        output[pos] = static_cast<char>('0' + digits % 10);
+        digits /= 10;
+    }
+    return true;
+}
+}  // namespace
+
+auto InternedLogEvent::append_decoded_message(std::string_view logtype, std::string& output) const
+        -> bool {
+    size_t next_dict_var_idx{0};
+    size_t next_encoded_var_idx{0};
+
+    // Copy constant text in runs rather than one character at a time.
+    size_t constant_begin_pos{0};
+    for (size_t i{0}; i < logtype.size(); ++i) {
+        auto const placeholder{static_cast<clp::ir::VariablePlaceholder>(logtype[i])};
+        switch (placeholder) {
+            case clp::ir::VariablePlaceholder::Integer:
+            case clp::ir::VariablePlaceholder::Float:
+                output.append(logtype, constant_begin_pos, i - constant_begin_pos);
+                if (next_encoded_var_idx >= m_encoded_vars.size()) {
+                    return false;
+                }
+                if (clp::ir::VariablePlaceholder::Integer == placeholder) {
+                    append_decoded_integer_var(m_encoded_vars[next_encoded_var_idx], output);
+                } else if (false
+                           == append_decoded_float_var(
+                                   m_encoded_vars[next_encoded_var_idx],
+                                   output
+                           ))
+                {
+                    return false;
+                }
+                ++next_encoded_var_idx;
+                constant_begin_pos = i + 1;
+                break;
+            case clp::ir::VariablePlaceholder::Dictionary:
+                output.append(logtype, constant_begin_pos, i - constant_begin_pos);
+                if (next_dict_var_idx >= m_dict_vars.size()) {
+                    return false;
+                }
+                output += m_dict_vars[next_dict_var_idx];
+                ++next_dict_var_idx;
+                constant_begin_pos = i + 1;
+                break;
+            case clp::ir::VariablePlaceholder::Escape:
+                // Skip the escape character and copy the escaped character as constant text.
+                if (i + 1 == logtype.size()) {
+                    return false;
+                }
+                output.append(logtype, constant_begin_pos, i - constant_begin_pos);
+                constant_begin_pos = i + 1;
+                ++i;
+                break;
+            default:
+                break;
+        }
+    }
+    output.append(logtype, constant_begin_pos);
+    return true;
+}
+}  // namespace clp_ffi_js::ir
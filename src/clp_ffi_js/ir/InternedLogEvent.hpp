@@ -0,0 +1,74 @@
+#ifndef CLP_FFI_JS_IR_INTERNEDLOGEVENT_HPP
+#define CLP_FFI_JS_IR_INTERNEDLOGEVENT_HPP
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_js/ir/LogtypeTable.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * An unstructured log event whose logtype is stored in a `LogtypeTable`, leaving only its
+ * variables and a logtype ID per event.
+ */
+class InternedLogEvent {
+public:
+    // Types
+    using encoded_variable_t = clp::ir::four_byte_encoded_variable_t;
+
+    // Constructor
+    InternedLogEvent(
+            logtype_id_t logtype_id,
+            std::vector<std::string> dict_vars,
+            std::vector<encoded_variable_t> encoded_vars,
+            clp::ir::epoch_time_ms_t timestamp
+    )
+            : m_dict_vars{std::move(dict_vars)},
+              m_encoded_vars{std::move(encoded_vars)},
+              m_timestamp{timestamp},
+              m_logtype_id{logtype_id} {}
+
+    // Methods
+    [[nodiscard]] auto get_logtype_id() const -> logtype_id_t { return m_logtype_id; }
+
+    [[nodiscard]] auto get_dict_vars() const -> std::vector<std::string> const& {
+        return m_dict_vars;
+    }
+
+    [[nodiscard]] auto get_encoded_vars() const -> std::vector<encoded_variable_t> const& {
+        return m_encoded_vars;
+    }
+
+    [[nodiscard]] auto get_timestamp() const -> clp::ir::epoch_time_ms_t { return m_timestamp; }
+
+    /**
+     * Decodes the variables and substitutes them into the given logtype, appending the resulting
+     * message to `output`.
+     *
+     * NOTE: This mirrors how CLP's `clp::ir::EncodedTextAst::decode_and_unparse` substitutes
+     * variables and removes escape characters, without requiring the logtype to be copied into an
+     * `EncodedTextAst`. It must be kept in sync with CLP; `test/unstructured-reader.test.mjs`
+     * checks its output against CLP's.
+     *
+     * @param logtype The event's logtype.
+     * @param output
+     * @return Whether the message was decoded successfully, i.e., whether the logtype's
+     * placeholders match the event's variables.
+     */
+    [[nodiscard]] auto append_decoded_message(std::string_view logtype, std::string& output) const
+            -> bool;
+
+private:
+    // Variables
+    std::vector<std::string> m_dict_vars;
+    std::vector<encoded_variable_t> m_encoded_vars;
+    clp::ir::epoch_time_ms_t m_timestamp;
+    logtype_id_t m_logtype_id;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_INTERNEDLOGEVENT_HPP
@@ -0,0 +1,200 @@
+#include "LazyStructuredLogEvents.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <clp/BufferReader.hpp>
+#include <clp/ErrorCode.hpp>
+#include <clp/ffi/ir_stream/IrUnitType.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+#include <clp_ffi_js/ir/memory_usage.hpp>
+
+namespace clp_ffi_js::ir {
+auto LazyStructuredLogEvents::append(std::span<char const> ir_unit, size_t ir_unit_pos) -> void {
+    if (nullptr != m_packed_log_events) {
+        return;
+    }
+    if (nullptr != m_seekable_input) {
+        m_ir_unit_begin_offsets.emplace_back(ir_unit_pos);
+        m_ir_unit_end_offsets.emplace_back(ir_unit_pos + ir_unit.size());
+        return;
+    }
+    m_ir_units.insert(m_ir_units.end(), ir_unit.begin(), ir_unit.end());
+    m_ir_unit_end_offsets.emplace_back(m_ir_units.size());
+}
+
+auto LazyStructuredLogEvents::append_non_log_event_ir_unit(std::span<char const> ir_unit) -> void {
+    if (nullptr == m_seekable_input) {
+        return;
+    }
+    m_non_log_event_ir_units.insert(m_non_log_event_ir_units.end(), ir_unit.begin(), ir_unit.end());
+}
+
+auto LazyStructuredLogEvents::restore(
+        std::vector<size_t>&& ir_unit_begin_offsets,
+        std::vector<size_t>&& ir_unit_end_offsets,
+        std::vector<char>&& non_log_event_ir_units
+) -> void {
+    if (nullptr == m_seekable_input || false == m_ir_unit_end_offsets.empty()
+        || false == m_non_log_event_ir_units.empty())
+    {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "IR unit positions can only be restored into empty storage over a seekable input."
+        };
+    }
+    m_ir_unit_begin_offsets = std::move(ir_unit_begin_offsets);
+    m_ir_unit_end_offsets = std::move(ir_unit_end_offsets);
+    m_non_log_event_ir_units = std::move(non_log_event_ir_units);
+}
+
+auto LazyStructuredLogEvents::load_pages(
+        std::span<size_t const> page_indices,
+        StructuredIrDeserializer& deserializer
+) -> void {
+    for (auto const page_idx : page_indices) {
+        if (auto const it{m_page_lookup.find(page_idx)}; m_page_lookup.end() != it) {
+            m_pages.splice(m_pages.begin(), m_pages, it->second);
+            continue;
+        }
+        m_pages.emplace_front(Page{page_idx, materialize_page(page_idx, deserializer)});
+        m_page_lookup.emplace(page_idx, m_pages.begin());
+    }
+
+    // The given pages are now the most recently used, so they won't be evicted.
+    auto const max_num_cached_pages{std::max(cMaxNumCachedPages, page_indices.size())};
+    while (m_pages.size() > max_num_cached_pages) {
+        m_page_lookup.erase(m_pages.back().page_idx);
+        m_pages.pop_back();
+    }
+}
+
+auto LazyStructuredLogEvents::load_log_event(
+        size_t log_event_idx,
+        StructuredIrDeserializer& deserializer
+) -> StructuredLogEvent const& {
+    auto const page_idx{get_page_idx(log_event_idx)};
+    if (m_pages.empty() || m_pages.front().page_idx != page_idx) {
+        load_pages({&page_idx, 1}, deserializer);
+    }
+    return get_loaded_log_event(log_event_idx);
+}
+
+auto LazyStructuredLogEvents::get_heap_size() const -> size_t {
+    // Each element of a hash map or list is allocated individually alongside a pointer to the next
+    // element (and, for lists, the previous element).
+    constexpr size_t cHashMapNodeOverhead{sizeof(void*) + sizeof(size_t)};
+    constexpr size_t cListNodeOverhead{2 * sizeof(void*)};
+
+    auto size{m_ir_units.capacity() + m_non_log_event_ir_units.capacity()
+              + (m_ir_unit_begin_offsets.capacity() + m_ir_unit_end_offsets.capacity())
+                        * sizeof(size_t)};
+    if (nullptr != m_seekable_input) {
+        size += m_seekable_input->get_heap_size();
+    }
+    if (nullptr != m_packed_log_events) {
+        size += m_packed_log_events->get_heap_size();
+    }
+    size += m_page_lookup.bucket_count() * sizeof(void*);
+    size += m_page_lookup.size()
+            * (sizeof(decltype(m_page_lookup)::value_type) + cHashMapNodeOverhead);
+    for (auto const& page : m_pages) {
+        size += sizeof(Page) + cListNodeOverhead;
+        size += page.log_events.capacity() * sizeof(StructuredLogEvent);
+        for (auto const& log_event : page.log_events) {
+            size += ir::get_heap_size(log_event);
+        }
+    }
+    return size;
+}
+
+auto LazyStructuredLogEvents::shrink_to_fit() -> void {
+    m_ir_units.shrink_to_fit();
+    m_ir_unit_begin_offsets.shrink_to_fit();
+    m_ir_unit_end_offsets.shrink_to_fit();
+    m_non_log_event_ir_units.shrink_to_fit();
+    m_pages.clear();
+    m_page_lookup.clear();
+    if (nullptr != m_seekable_input) {
+        m_seekable_input->release_buffer();
+    }
+    if (nullptr != m_packed_log_events) {
+        m_packed_log_events->shrink_to_fit();
+    }
+}
+
+auto LazyStructuredLogEvents::materialize_page(
+        size_t page_idx,
+        StructuredIrDeserializer& deserializer
+) -> std::vector<StructuredLogEvent> {
+    auto const begin_idx{page_idx * cNumLogEventsPerPage};
+    auto const end_idx{std::min(begin_idx + cNumLogEventsPerPage, get_num_log_events())};
+    if (begin_idx >= end_idx) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_OutOfBounds,
+                __FILENAME__,
+                __LINE__,
+                std::format("Log event page {} doesn't exist", page_idx)
+        };
+    }
+
+    std::vector<StructuredLogEvent> log_events;
+    log_events.reserve(end_idx - begin_idx);
+    if (nullptr != m_packed_log_events) {
+        for (auto log_event_idx{begin_idx}; log_event_idx < end_idx; ++log_event_idx) {
+            log_events.emplace_back(m_packed_log_events->unpack(log_event_idx));
+        }
+        return log_events;
+    }
+
+    // Position of `ir_units` in the decompressed stream, if the input is seekable
+    size_t ir_units_begin_offset{0};
+    std::span<char const> ir_units{m_ir_units};
+    if (nullptr != m_seekable_input) {
+        ir_units_begin_offset = get_ir_unit_begin_offset(begin_idx);
+        ir_units = m_seekable_input->read(
+                ir_units_begin_offset,
+                m_ir_unit_end_offsets[end_idx - 1] - ir_units_begin_offset
+        );
+    }
+
+    auto& ir_unit_handler{deserializer.get_ir_unit_handler()};
+    ir_unit_handler.set_replayed_log_events(&log_events);
+    for (auto log_event_idx{begin_idx}; log_event_idx < end_idx; ++log_event_idx) {
+        auto const ir_unit_begin_offset{get_ir_unit_begin_offset(log_event_idx)};
+        clp::BufferReader reader{
+                ir_units.data() + (ir_unit_begin_offset - ir_units_begin_offset),
+                m_ir_unit_end_offsets[log_event_idx] - ir_unit_begin_offset
+        };
+        auto const result{deserializer.deserialize_next_ir_unit(reader)};
+        if (result.has_error() || clp::ffi::ir_stream::IrUnitType::LogEvent != result.value()
+            || log_events.size() != log_event_idx - begin_idx + 1)
+        {
+            ir_unit_handler.set_replayed_log_events(nullptr);
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_Corrupt,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format("Failed to deserialize log event {} again", log_event_idx)
+            };
+        }
+    }
+    ir_unit_handler.set_replayed_log_events(nullptr);
+    return log_events;
+}
+
+auto LazyStructuredLogEvents::get_ir_unit_begin_offset(size_t log_event_idx) const -> size_t {
+    if (nullptr != m_seekable_input) {
+        return m_ir_unit_begin_offsets[log_event_idx];
+    }
+    return 0 == log_event_idx ? 0 : m_ir_unit_end_offsets[log_event_idx - 1];
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,249 @@
+#ifndef CLP_FFI_JS_IR_LAZYSTRUCTUREDLOGEVENTS_HPP
+#define CLP_FFI_JS_IR_LAZYSTRUCTUREDLOGEVENTS_HPP
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/ir_stream/Deserializer.hpp>
+
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+#include <clp_ffi_js/ir/PackedStructuredLogEvents.hpp>
+#include <clp_ffi_js/ir/SeekableZstdInput.hpp>
+#include <clp_ffi_js/ir/StructuredIrUnitHandler.hpp>
+
+namespace clp_ffi_js::ir {
+using StructuredIrDeserializer = clp::ffi::ir_stream::Deserializer<StructuredIrUnitHandler>;
+
+/**
+ * Storage for the log events of a structured IR stream that keeps only each log event's serialized
+ * IR unit, and materializes log events on demand, a page at a time.
+ *
+ * The most recently used pages are kept in an LRU cache. Since a stream's schema tree is only ever
+ * appended to, the stream's deserializer can re-deserialize any earlier log event, so the IR units
+ * don't need to be accompanied by snapshots of the schema tree. However, the deserializer must
+ * never be given the end of the stream, after which it refuses to deserialize any more IR units.
+ *
+ * If the stream's compressed input is seekable, the IR units aren't retained at all. Instead, only
+ * their positions in the decompressed stream are kept, and materializing a page decompresses just
+ * the frames containing the page's IR units.
+ *
+ * Alternatively, the log events can be kept packed (see `PackedStructuredLogEvents`), in which case
+ * materializing a page unpacks its log events rather than deserializing them again.
+ */
+class LazyStructuredLogEvents {
+public:
+    // Constants
+    static constexpr size_t cNumLogEventsPerPage{1024};
+    static constexpr size_t cMaxNumCachedPages{8};
+
+    // Constructors
+    /**
+     * @param seekable_input The stream's compressed input, if it's seekable, in which case IR units
+     * are decompressed from it again rather than retained.
+     */
+    explicit LazyStructuredLogEvents(std::unique_ptr<SeekableZstdInput> seekable_input = nullptr)
+            : m_seekable_input{std::move(seekable_input)} {}
+
+    /**
+     * @param packed_log_events The packed log events, which are appended to by the stream's IR
+     * unit handler rather than through this class.
+     */
+    explicit LazyStructuredLogEvents(std::shared_ptr<PackedStructuredLogEvents> packed_log_events)
+            : m_packed_log_events{std::move(packed_log_events)} {}
+
+    // Methods
+    /**
+     * Appends the serialized IR unit of the next log event, unless the log events are packed.
+     *
+     * @param ir_unit
+     * @param ir_unit_pos The position of the IR unit in the decompressed stream.
+     */
+    auto append(std::span<char const> ir_unit, size_t ir_unit_pos) -> void;
+
+    /**
+     * Appends an IR unit that isn't a log event (e.g., a schema-tree node insertion), which is only
+     * retained if the input is seekable, so that the stream's index can be exported.
+     *
+     * NOTE: The end of the stream must not be appended, since the retained IR units are replayed
+     * into the deserializer when an index is imported.
+     *
+     * @param ir_unit
+     */
+    auto append_non_log_event_ir_unit(std::span<char const> ir_unit) -> void;
+
+    /**
+     * Restores the IR units' positions from an imported index.
+     *
+     * @param ir_unit_begin_offsets
+     * @param ir_unit_end_offsets
+     * @param non_log_event_ir_units
+     * @throw ClpFfiJsException if the input isn't seekable or any IR units have been appended.
+     */
+    auto restore(
+            std::vector<size_t>&& ir_unit_begin_offsets,
+            std::vector<size_t>&& ir_unit_end_offsets,
+            std::vector<char>&& non_log_event_ir_units
+    ) -> void;
+
+    /**
+     * @return The seekable input, or nullptr if the IR units are retained instead.
+     */
+    [[nodiscard]] auto get_seekable_input() const -> SeekableZstdInput const* {
+        return m_seekable_input.get();
+    }
+
+    /**
+     * @return The positions of the IR units in the decompressed stream, if the input is seekable.
+     */
+    [[nodiscard]] auto get_ir_unit_begin_offsets() const -> std::span<size_t const> {
+        return m_ir_unit_begin_offsets;
+    }
+
+    /**
+     * @return The positions of the ends of the IR units in the decompressed stream, if the input is
+     * seekable.
+     */
+    [[nodiscard]] auto get_ir_unit_end_offsets() const -> std::span<size_t const> {
+        return m_ir_unit_end_offsets;
+    }
+
+    /**
+     * @return The IR units that aren't log events, if the input is seekable.
+     */
+    [[nodiscard]] auto get_non_log_event_ir_units() const -> std::span<char const> {
+        return m_non_log_event_ir_units;
+    }
+
+    [[nodiscard]] auto get_num_log_events() const -> size_t {
+        if (nullptr != m_packed_log_events) {
+            return m_packed_log_events->get_num_log_events();
+        }
+        return m_ir_unit_end_offsets.size();
+    }
+
+    /**
+     * @return The size of the compressed input retained to decompress IR units again, or 0 if the
+     * IR units are retained instead.
+     */
+    [[nodiscard]] auto get_retained_compressed_input_size() const -> size_t {
+        return nullptr == m_seekable_input ? 0 : m_seekable_input->get_compressed_size();
+    }
+
+    [[nodiscard]] static auto get_page_idx(size_t log_event_idx) -> size_t {
+        return log_event_idx / cNumLogEventsPerPage;
+    }
+
+    /**
+     * Materializes the given pages if they aren't already cached, and then evicts the least
+     * recently used pages until at most `cMaxNumCachedPages` pages (or all the given pages, if
+     * there are more) remain.
+     *
+     * @param page_indices Indices of the pages to load, in ascending order without duplicates.
+     * @param deserializer The stream's deserializer, which must not have deserialized the end of
+     * the stream.
+     * @throw ClpFfiJsException if a log event can't be deserialized again.
+     */
+    auto load_pages(std::span<size_t const> page_indices, StructuredIrDeserializer& deserializer)
+            -> void;
+
+    /**
+     * Loads the page containing the given log event (see `load_pages`).
+     *
+     * @param log_event_idx
+     * @param deserializer The stream's deserializer.
+     * @return The log event, which is only valid until the next call to a method that loads pages.
+     * @throw ClpFfiJsException if a log event can't be deserialized again.
+     */
+    [[nodiscard]] auto
+    load_log_event(size_t log_event_idx, StructuredIrDeserializer& deserializer)
+            -> StructuredLogEvent const&;
+
+    /**
+     * NOTE: This method doesn't modify the cache, so it can be called concurrently from multiple
+     * threads.
+     *
+     * @param log_event_idx
+     * @return The log event, which must be in a loaded page.
+     * @throw std::out_of_range if the log event's page isn't loaded.
+     */
+    [[nodiscard]] auto get_loaded_log_event(size_t log_event_idx) const
+            -> StructuredLogEvent const& {
+        return m_page_lookup.at(get_page_idx(log_event_idx))
+                ->log_events.at(log_event_idx % cNumLogEventsPerPage);
+    }
+
+    /**
+     * @return A log event from any loaded page, or nullptr if no page is loaded.
+     */
+    [[nodiscard]] auto get_any_loaded_log_event() const -> StructuredLogEvent const* {
+        if (m_pages.empty()) {
+            return nullptr;
+        }
+        return &m_pages.front().log_events.front();
+    }
+
+    /**
+     * @return The number of bytes held by the IR units (or their positions, excluding the retained
+     * compressed input, or the packed log events) and the cached pages, including the memory the
+     * cached log events allocate on the heap.
+     */
+    [[nodiscard]] auto get_heap_size() const -> size_t;
+
+    /**
+     * Releases any capacity reserved but unused by the IR units (or packed log events), and evicts
+     * all cached pages along with any decompressed frames.
+     */
+    auto shrink_to_fit() -> void;
+
+private:
+    // Types
+    struct Page {
+        size_t page_idx;
+        std::vector<StructuredLogEvent> log_events;
+    };
+
+    // Methods
+    /**
+     * Deserializes (or unpacks) the log events in the given page again.
+     *
+     * @param page_idx
+     * @param deserializer
+     * @return The page's log events.
+     * @throw ClpFfiJsException if a log event can't be deserialized again.
+     */
+    [[nodiscard]] auto materialize_page(size_t page_idx, StructuredIrDeserializer& deserializer)
+            -> std::vector<StructuredLogEvent>;
+
+    /**
+     * @param log_event_idx
+     * @return The offset of the log event's IR unit in `m_ir_units` or, if the input is seekable,
+     * the position of the IR unit in the decompressed stream.
+     */
+    [[nodiscard]] auto get_ir_unit_begin_offset(size_t log_event_idx) const -> size_t;
+
+    // Variables
+    std::unique_ptr<SeekableZstdInput> m_seekable_input;
+    std::shared_ptr<PackedStructuredLogEvents> m_packed_log_events;
+
+    // The IR units, if the input isn't seekable
+    std::vector<char> m_ir_units;
+    // The IR units' positions in the decompressed stream, if the input is seekable. Since other IR
+    // units are interleaved with the log events, the IR units aren't contiguous in the stream.
+    std::vector<size_t> m_ir_unit_begin_offsets;
+    // The offset (see `get_ir_unit_begin_offset`) of the end of each IR unit
+    std::vector<size_t> m_ir_unit_end_offsets;
+    // The IR units that aren't log events, if the input is seekable
+    std::vector<char> m_non_log_event_ir_units;
+
+    // Cached pages, from most to least recently used.
+    std::list<Page> m_pages;
+    std::unordered_map<size_t, std::list<Page>::iterator> m_page_lookup;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_LAZYSTRUCTUREDLOGEVENTS_HPP
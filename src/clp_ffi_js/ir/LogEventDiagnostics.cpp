@@ -0,0 +1,25 @@
+#include "LogEventDiagnostics.hpp"
+
+#include <cstddef>
+
+#include <clp/type_utils.hpp>
+#include <spdlog/spdlog.h>
+
+namespace clp_ffi_js::ir {
+auto LogEventDiagnostics::record(DiagnosticKind kind, size_t log_event_idx) -> void {
+    auto const kind_idx{clp::enum_to_underlying_type(kind)};
+    auto& diagnostic{m_diagnostics.at(kind_idx)};
+    if (0 == diagnostic.count) {
+        SPDLOG_WARN(
+                "Found {} at log event index {}; further occurrences won't be logged but are "
+                "counted in the reader's diagnostics.",
+                cDiagnosticKindNames.at(kind_idx),
+                log_event_idx
+        );
+    }
+    ++diagnostic.count;
+    if (diagnostic.sampled_log_event_indices.size() < cMaxNumSampledLogEventIndices) {
+        diagnostic.sampled_log_event_indices.push_back(log_event_idx);
+    }
+}
+}  // namespace clp_ffi_js::ir
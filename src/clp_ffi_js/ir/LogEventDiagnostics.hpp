@@ -0,0 +1,93 @@
+#ifndef CLP_FFI_JS_IR_LOGEVENTDIAGNOSTICS_HPP
+#define CLP_FFI_JS_IR_LOGEVENTDIAGNOSTICS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <clp/type_utils.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Enum of problems that can be found in individual log events while deserializing a stream.
+ */
+enum class DiagnosticKind : uint8_t {
+    // The authoritative log level's value isn't an integer or string.
+    InvalidLogLevelType = 0,
+    // The authoritative timestamp's value isn't a number or string.
+    InvalidTimestampType,
+    // The authoritative timestamp's value is a string that can't be parsed as a timestamp.
+    UnparsableTimestamp,
+    // The stream contains a UTC offset change, which isn't applied to the log events after it.
+    UnhandledUtcOffsetChange,
+    LENGTH,  // This isn't a valid kind.
+};
+
+/**
+ * Names of each `DiagnosticKind`, as used by the JS API.
+ *
+ * NOTE: These must be kept in sync manually.
+ */
+constexpr std::array<std::string_view, clp::enum_to_underlying_type(DiagnosticKind::LENGTH)>
+        cDiagnosticKindNames{
+                "invalidLogLevelType",
+                "invalidTimestampType",
+                "unparsableTimestamp",
+                "unhandledUtcOffsetChange",
+        };
+
+/**
+ * Class to aggregate the problems found in individual log events, so that the cost of reporting
+ * them doesn't grow with the number of problematic log events.
+ *
+ * For each kind of problem, the class counts the occurrences and keeps the indices of the first
+ * `cMaxNumSampledLogEventIndices` log events with the problem. Only the first occurrence of each
+ * kind is logged.
+ */
+class LogEventDiagnostics {
+public:
+    // Constants
+    static constexpr size_t cMaxNumSampledLogEventIndices{10};
+
+    // Methods
+    /**
+     * Records an occurrence of a problem.
+     *
+     * @param kind
+     * @param log_event_idx The index of the log event with the problem.
+     */
+    auto record(DiagnosticKind kind, size_t log_event_idx) -> void;
+
+    /**
+     * @param kind
+     * @return The number of occurrences of the given kind of problem.
+     */
+    [[nodiscard]] auto get_count(DiagnosticKind kind) const -> size_t {
+        return m_diagnostics.at(clp::enum_to_underlying_type(kind)).count;
+    }
+
+    /**
+     * @param kind
+     * @return The indices of the first log events (up to `cMaxNumSampledLogEventIndices`) with
+     * the given kind of problem, in ascending order.
+     */
+    [[nodiscard]] auto get_sampled_log_event_indices(DiagnosticKind kind) const
+            -> std::vector<size_t> const& {
+        return m_diagnostics.at(clp::enum_to_underlying_type(kind)).sampled_log_event_indices;
+    }
+
+private:
+    // Types
+    struct Diagnostic {
+        size_t count{0};
+        std::vector<size_t> sampled_log_event_indices;
+    };
+
+    // Variables
+    std::array<Diagnostic, clp::enum_to_underlying_type(DiagnosticKind::LENGTH)> m_diagnostics;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_LOGEVENTDIAGNOSTICS_HPP
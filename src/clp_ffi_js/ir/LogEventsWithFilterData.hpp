@@ -0,0 +1,147 @@
+#ifndef CLP_FFI_JS_IR_LOGEVENTSWITHFILTERDATA_HPP
+#define CLP_FFI_JS_IR_LOGEVENTSWITHFILTERDATA_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/InternedLogEvent.hpp>
+
+namespace clp_ffi_js::ir {
+using clp::ir::four_byte_encoded_variable_t;
+using UnstructuredLogEvent = InternedLogEvent;
+using StructuredLogEvent = clp::ffi::KeyValuePairLogEvent;
+
+/**
+ * A templated collection of log events along with processed versions of some of their fields,
+ * specifically the fields that are used for filtering in the `StreamReader` classes and their
+ * callers.
+ *
+ * The filter fields are stored in their own dense columns, separate from the log events, so that
+ * binary searches and scans over them only touch contiguous memory. The collection can also store
+ * only the filter fields, for callers that materialize the log events themselves on demand.
+ *
+ * @tparam LogEvent The type of the log events.
+ */
+template <typename LogEvent>
+requires std::same_as<LogEvent, UnstructuredLogEvent> || std::same_as<LogEvent, StructuredLogEvent>
+class LogEventsWithFilterData {
+public:
+    // Constructors
+    /**
+     * @param store_log_events Whether to store the log events themselves, or only their filter
+     * fields.
+     */
+    explicit LogEventsWithFilterData(bool store_log_events = true)
+            : m_store_log_events{store_log_events} {}
+
+    // Disable copy constructor and assignment operator
+    LogEventsWithFilterData(LogEventsWithFilterData const&) = delete;
+    auto operator=(LogEventsWithFilterData const&) -> LogEventsWithFilterData& = delete;
+
+    // Default move constructor and assignment operator
+    LogEventsWithFilterData(LogEventsWithFilterData&&) = default;
+    auto operator=(LogEventsWithFilterData&&) -> LogEventsWithFilterData& = default;
+
+    // Destructor
+    ~LogEventsWithFilterData() = default;
+
+    // Methods
+    /**
+     * Appends a log event along with its filter fields.
+     *
+     * NOTE: The collection must've been constructed to store log events.
+     *
+     * @param log_event
+     * @param log_level
+     * @param timestamp
+     */
+    auto emplace_back(LogEvent log_event, LogLevel log_level, clp::ir::epoch_time_ms_t timestamp)
+            -> void {
+        m_log_events.emplace_back(std::move(log_event));
+        emplace_back(log_level, timestamp);
+    }
+
+    /**
+     * Appends the filter fields of a log event that isn't stored in the collection.
+     *
+     * @param log_level
+     * @param timestamp
+     */
+    auto emplace_back(LogLevel log_level, clp::ir::epoch_time_ms_t timestamp) -> void {
+        m_log_levels.emplace_back(log_level);
+        m_timestamps.emplace_back(timestamp);
+    }
+
+    auto reserve(size_t capacity) -> void {
+        if (m_store_log_events) {
+            m_log_events.reserve(capacity);
+        }
+        m_log_levels.reserve(capacity);
+        m_timestamps.reserve(capacity);
+    }
+
+    auto shrink_to_fit() -> void {
+        m_log_events.shrink_to_fit();
+        m_log_levels.shrink_to_fit();
+        m_timestamps.shrink_to_fit();
+    }
+
+    [[nodiscard]] auto size() const -> size_t { return m_timestamps.size(); }
+
+    [[nodiscard]] auto empty() const -> bool { return m_timestamps.empty(); }
+
+    [[nodiscard]] auto capacity() const -> size_t { return m_timestamps.capacity(); }
+
+    [[nodiscard]] auto is_storing_log_events() const -> bool { return m_store_log_events; }
+
+    /**
+     * @param idx
+     * @return The log event at the given index.
+     * @throw std::out_of_range if the collection doesn't contain (or store) the log event.
+     */
+    [[nodiscard]] auto get_log_event(size_t idx) const -> LogEvent const& {
+        return m_log_events.at(idx);
+    }
+
+    [[nodiscard]] auto get_log_level(size_t idx) const -> LogLevel { return m_log_levels.at(idx); }
+
+    [[nodiscard]] auto get_timestamp(size_t idx) const -> clp::ir::epoch_time_ms_t {
+        return m_timestamps.at(idx);
+    }
+
+    [[nodiscard]] auto get_log_events() const -> std::vector<LogEvent> const& {
+        return m_log_events;
+    }
+
+    [[nodiscard]] auto get_log_levels() const -> std::span<LogLevel const> { return m_log_levels; }
+
+    [[nodiscard]] auto get_timestamps() const -> std::span<clp::ir::epoch_time_ms_t const> {
+        return m_timestamps;
+    }
+
+    /**
+     * @return The number of bytes the filter-data columns allocate on the heap, excluding the log
+     * events themselves.
+     */
+    [[nodiscard]] auto get_filter_data_heap_size() const -> size_t {
+        return m_log_levels.capacity() * sizeof(LogLevel)
+               + m_timestamps.capacity() * sizeof(clp::ir::epoch_time_ms_t);
+    }
+
+private:
+    // Variables
+    std::vector<LogEvent> m_log_events;
+    std::vector<LogLevel> m_log_levels;
+    std::vector<clp::ir::epoch_time_ms_t> m_timestamps;
+    bool m_store_log_events;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_LOGEVENTSWITHFILTERDATA_HPP
@@ -0,0 +1,101 @@
+#include "LogLevelIndex.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <clp/type_utils.hpp>
+
+#include <clp_ffi_js/constants.hpp>
+
+namespace clp_ffi_js::ir {
+auto LogLevelIndex::get_log_level_counts() const -> LogLevelCounts {
+    LogLevelCounts counts{};
+    std::ranges::transform(
+            m_posting_lists,
+            counts.begin(),
+            [](std::vector<size_t> const& posting_list) { return posting_list.size(); }
+    );
+    return counts;
+}
+
+auto LogLevelIndex::get_log_event_indices(
+        std::span<std::underlying_type_t<LogLevel> const> log_levels,
+        std::vector<size_t>& log_event_indices
+) const -> void {
+    log_event_indices.clear();
+    append_log_event_indices(log_levels, 0, m_num_indexed_log_events, log_event_indices);
+}
+
+auto LogLevelIndex::append_log_event_indices(
+        std::span<std::underlying_type_t<LogLevel> const> log_levels,
+        size_t begin_log_event_idx,
+        size_t end_log_event_idx,
+        std::vector<size_t>& log_event_indices
+) const -> void {
+    std::array<bool, clp::enum_to_underlying_type(LogLevel::LENGTH)> is_selected{};
+    for (auto const log_level : log_levels) {
+        if (log_level < is_selected.size()) {
+            is_selected.at(log_level) = true;
+        }
+    }
+
+    // The part of each selected posting list in `[begin_log_event_idx, end_log_event_idx)`
+    std::vector<std::span<size_t const>> selected_posting_lists;
+    size_t num_selected_log_events{0};
+    for (size_t i{0}; i < m_posting_lists.size(); ++i) {
+        if (false == is_selected.at(i)) {
+            continue;
+        }
+        auto const& posting_list{m_posting_lists.at(i)};
+        auto const& selected{selected_posting_lists.emplace_back(
+                std::ranges::lower_bound(posting_list, begin_log_event_idx),
+                std::ranges::lower_bound(posting_list, end_log_event_idx)
+        )};
+        num_selected_log_events += selected.size();
+    }
+
+    // Merge directly into `log_event_indices` unless there are indices to append to.
+    std::vector<size_t> appended_log_event_indices;
+    auto& selected_log_event_indices{
+            log_event_indices.empty() ? log_event_indices : appended_log_event_indices
+    };
+    selected_log_event_indices.reserve(num_selected_log_events);
+    std::vector<size_t> merged;
+    for (auto const posting_list : selected_posting_lists) {
+        if (selected_log_event_indices.empty()) {
+            selected_log_event_indices.assign(posting_list.begin(), posting_list.end());
+            continue;
+        }
+        merged.clear();
+        merged.reserve(selected_log_event_indices.size() + posting_list.size());
+        std::ranges::merge(selected_log_event_indices, posting_list, std::back_inserter(merged));
+        selected_log_event_indices.swap(merged);
+    }
+    if (&selected_log_event_indices != &log_event_indices) {
+        log_event_indices.insert(
+                log_event_indices.end(),
+                appended_log_event_indices.begin(),
+                appended_log_event_indices.end()
+        );
+    }
+}
+
+auto LogLevelIndex::get_heap_size() const -> size_t {
+    size_t size{0};
+    for (auto const& posting_list : m_posting_lists) {
+        size += posting_list.capacity() * sizeof(size_t);
+    }
+    return size;
+}
+
+auto LogLevelIndex::shrink_to_fit() -> void {
+    for (auto& posting_list : m_posting_lists) {
+        posting_list.shrink_to_fit();
+    }
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,99 @@
+#ifndef CLP_FFI_JS_IR_LOGLEVELINDEX_HPP
+#define CLP_FFI_JS_IR_LOGLEVELINDEX_HPP
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <clp/type_utils.hpp>
+
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Index of the log events in a stream by log level. For each log level, the index keeps a sorted
+ * list of the indices of the log events with that level, so that filtering by a set of levels is a
+ * union of precomputed lists rather than a scan over every log event.
+ *
+ * The index is built incrementally as log events are deserialized.
+ */
+class LogLevelIndex {
+public:
+    // Types
+    using LogLevelCounts = std::array<size_t, clp::enum_to_underlying_type(LogLevel::LENGTH)>;
+
+    // Methods
+    /**
+     * Indexes the log events in `log_events` that haven't been indexed yet.
+     *
+     * NOTE: `log_events` must be the same collection each time, and it must only ever be appended
+     * to.
+     *
+     * @tparam LogEvent
+     * @param log_events
+     */
+    template <typename LogEvent>
+    auto update(LogEventsWithFilterData<LogEvent> const& log_events) -> void {
+        auto const log_levels{log_events.get_log_levels()};
+        for (auto log_event_idx{m_num_indexed_log_events}; log_event_idx < log_levels.size();
+             ++log_event_idx)
+        {
+            auto const log_level{log_levels[log_event_idx]};
+            m_posting_lists.at(clp::enum_to_underlying_type(log_level)).emplace_back(log_event_idx);
+        }
+        m_num_indexed_log_events = log_levels.size();
+    }
+
+    /**
+     * @return The number of indexed log events with each log level, indexed by `LogLevel`.
+     */
+    [[nodiscard]] auto get_log_level_counts() const -> LogLevelCounts;
+
+    /**
+     * Collects the indices of the log events with any of the given log levels.
+     *
+     * @param log_levels Log levels to select. Invalid and duplicate levels are ignored.
+     * @param[out] log_event_indices Returns the indices of the selected log events, in ascending
+     * order.
+     */
+    auto get_log_event_indices(
+            std::span<std::underlying_type_t<LogLevel> const> log_levels,
+            std::vector<size_t>& log_event_indices
+    ) const -> void;
+
+    /**
+     * Appends the indices of the log events in `[begin_log_event_idx, end_log_event_idx)` with any
+     * of the given log levels.
+     *
+     * @param log_levels Log levels to select. Invalid and duplicate levels are ignored.
+     * @param begin_log_event_idx
+     * @param end_log_event_idx
+     * @param[in,out] log_event_indices The indices to append to, which must all be less than
+     * `begin_log_event_idx` so that the indices remain in ascending order.
+     */
+    auto append_log_event_indices(
+            std::span<std::underlying_type_t<LogLevel> const> log_levels,
+            size_t begin_log_event_idx,
+            size_t end_log_event_idx,
+            std::vector<size_t>& log_event_indices
+    ) const -> void;
+
+    /**
+     * @return The number of bytes the index allocates on the heap.
+     */
+    [[nodiscard]] auto get_heap_size() const -> size_t;
+
+    auto shrink_to_fit() -> void;
+
+private:
+    // Variables
+    std::array<std::vector<size_t>, clp::enum_to_underlying_type(LogLevel::LENGTH)>
+            m_posting_lists;
+    size_t m_num_indexed_log_events{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_LOGLEVELINDEX_HPP
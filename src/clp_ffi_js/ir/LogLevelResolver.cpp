@@ -0,0 +1,112 @@
+#include "LogLevelResolver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_utils.hpp>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ffi/Value.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/constants.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+/**
+ * @param c
+ * @return The upper-case form of `c` if it's an ASCII lower-case letter, or `c` otherwise.
+ */
+[[nodiscard]] constexpr auto to_upper(char c) -> char {
+    return ('a' <= c && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+/**
+ * @param str
+ * @return The upper-case form of `str`.
+ */
+[[nodiscard]] auto to_upper(std::string_view str) -> std::string;
+
+auto to_upper(std::string_view str) -> std::string {
+    std::string upper_case_str(str.size(), '\0');
+    for (size_t i{0}; i < str.size(); ++i) {
+        upper_case_str[i] = to_upper(str[i]);
+    }
+    return upper_case_str;
+}
+}  // namespace
+
+LogLevelResolver::LogLevelResolver(std::span<Alias const> aliases) {
+    for (auto log_level_idx{clp::enum_to_underlying_type(cValidLogLevelsBeginIdx)};
+         log_level_idx < clp::enum_to_underlying_type(LogLevel::LENGTH);
+         ++log_level_idx)
+    {
+        auto const& name{cLogLevelNames.at(log_level_idx)};
+        m_names.emplace(name, static_cast<LogLevel>(log_level_idx));
+        m_max_name_length = std::max(m_max_name_length, name.size());
+    }
+
+    for (auto const& [name, log_level] : aliases) {
+        if (name.empty() || name.size() > cMaxNameLength || log_level < cValidLogLevelsBeginIdx
+            || log_level >= LogLevel::LENGTH)
+        {
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_BadParam,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format(
+                            "Invalid log level alias \"{}\" for log level {}",
+                            name,
+                            clp::enum_to_underlying_type(log_level)
+                    )
+            };
+        }
+        m_names.insert_or_assign(to_upper(name), log_level);
+        m_max_name_length = std::max(m_max_name_length, name.size());
+
+        clp::ffi::value_int_t value{0};
+        auto const* name_end{name.data() + name.size()};
+        auto const [ptr, ec]{std::from_chars(name.data(), name_end, value)};
+        if (std::errc{} == ec && name_end == ptr) {
+            m_numeric_aliases.insert_or_assign(value, log_level);
+        }
+    }
+}
+
+auto LogLevelResolver::resolve(std::string_view name) const -> LogLevel {
+    if (name.size() > m_max_name_length) {
+        return LogLevel::NONE;
+    }
+
+    std::array<char, cMaxNameLength> upper_case_name_buf{};
+    for (size_t i{0}; i < name.size(); ++i) {
+        upper_case_name_buf.at(i) = to_upper(name[i]);
+    }
+    auto const it{m_names.find(std::string_view{upper_case_name_buf.data(), name.size()})};
+    if (m_names.end() == it) {
+        return LogLevel::NONE;
+    }
+    return it->second;
+}
+
+auto LogLevelResolver::resolve(clp::ffi::value_int_t value) const -> LogLevel {
+    if (false == m_numeric_aliases.empty()) {
+        if (auto const it{m_numeric_aliases.find(value)}; m_numeric_aliases.end() != it) {
+            return it->second;
+        }
+    }
+
+    if (value >= clp::enum_to_underlying_type(cValidLogLevelsBeginIdx)
+        && value < clp::enum_to_underlying_type(LogLevel::LENGTH))
+    {
+        return static_cast<LogLevel>(value);
+    }
+    return LogLevel::NONE;
+}
+}  // namespace clp_ffi_js::ir
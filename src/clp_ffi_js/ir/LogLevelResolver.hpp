@@ -0,0 +1,77 @@
+#ifndef CLP_FFI_JS_IR_LOGLEVELRESOLVER_HPP
+#define CLP_FFI_JS_IR_LOGLEVELRESOLVER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include <clp/ffi/Value.hpp>
+
+#include <clp_ffi_js/constants.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Class to resolve the values of structured log events' log level kv-pairs into `LogLevel`s.
+ *
+ * String values are matched case-insensitively against a table of the names in `cLogLevelNames`
+ * and any configured aliases (e.g., "WARNING" or "CRITICAL"). Alias names that are decimal
+ * integers (e.g., syslog severities) also apply to integer values; other integer values are
+ * interpreted as `LogLevel`s directly.
+ *
+ * Resolving a value doesn't allocate, since the table is built once and string values are
+ * normalized into a fixed-size buffer before being looked up.
+ */
+class LogLevelResolver {
+public:
+    // Constants
+    static constexpr size_t cMaxNameLength{64};
+
+    // Types
+    using Alias = std::pair<std::string, LogLevel>;
+
+    // Constructor
+    /**
+     * @param aliases Alternative names for log levels. Each name is case-insensitive, and any
+     * alias with the same name as a log level or an earlier alias overrides it.
+     * @throw ClpFfiJsException if any alias's name is empty or longer than `cMaxNameLength`, or its
+     * log level isn't valid.
+     */
+    explicit LogLevelResolver(std::span<Alias const> aliases);
+
+    // Methods
+    /**
+     * @param name
+     * @return The `LogLevel` corresponding to `name`, or `LogLevel::NONE` if there's none.
+     */
+    [[nodiscard]] auto resolve(std::string_view name) const -> LogLevel;
+
+    /**
+     * @param value
+     * @return The `LogLevel` corresponding to `value`, or `LogLevel::NONE` if there's none.
+     */
+    [[nodiscard]] auto resolve(clp::ffi::value_int_t value) const -> LogLevel;
+
+private:
+    // Types
+    // Hash that allows looking up `std::string` keys using `std::string_view`s.
+    struct StringHash {
+        using is_transparent = void;
+
+        [[nodiscard]] auto operator()(std::string_view str) const -> size_t {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    // Variables
+    // Maps upper-case names to log levels.
+    std::unordered_map<std::string, LogLevel, StringHash, std::equal_to<>> m_names;
+    std::unordered_map<clp::ffi::value_int_t, LogLevel> m_numeric_aliases;
+    size_t m_max_name_length{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_LOGLEVELRESOLVER_HPP
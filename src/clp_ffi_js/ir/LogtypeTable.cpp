@@ -0,0 +1,71 @@
+#include "LogtypeTable.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/memory_usage.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+/**
+ * Parses the log level from a logtype, assuming the level's name immediately follows the
+ * message's leading character (typically a space after the timestamp).
+ * @param logtype
+ * @return The log level in `logtype` if there's one.
+ * @return `LogLevel::NONE` otherwise.
+ */
+auto parse_log_level(std::string_view logtype) -> LogLevel;
+
+auto parse_log_level(std::string_view logtype) -> LogLevel {
+    constexpr size_t cLogLevelPositionInMessages{1};
+    if (logtype.length() <= cLogLevelPositionInMessages) {
+        return LogLevel::NONE;
+    }
+
+    // NOLINTNEXTLINE(readability-qualified-auto)
+    auto const log_level_name_it{std::find_if(
+            cLogLevelNames.begin() + static_cast<size_t>(cValidLogLevelsBeginIdx),
+            cLogLevelNames.end(),
+            [&](std::string_view level) {
+                return logtype.substr(cLogLevelPositionInMessages).starts_with(level);
+            }
+    )};
+    if (log_level_name_it == cLogLevelNames.end()) {
+        return LogLevel::NONE;
+    }
+    return static_cast<LogLevel>(std::distance(cLogLevelNames.begin(), log_level_name_it));
+}
+}  // namespace
+
+auto LogtypeTable::intern(std::string_view logtype) -> logtype_id_t {
+    if (auto const it{m_logtype_ids.find(logtype)}; m_logtype_ids.end() != it) {
+        return it->second;
+    }
+
+    auto const logtype_id{static_cast<logtype_id_t>(m_logtypes.size())};
+    auto const& stored_logtype{m_logtypes.emplace_back(logtype)};
+    m_log_levels.emplace_back(parse_log_level(stored_logtype));
+    m_logtype_ids.emplace(stored_logtype, logtype_id);
+    return logtype_id;
+}
+
+auto LogtypeTable::get_heap_size() const -> size_t {
+    // Each element of a node-based hash map is allocated individually alongside its hash and a
+    // pointer to the next element in its bucket.
+    constexpr size_t cHashMapNodeOverhead{sizeof(void*) + sizeof(size_t)};
+
+    auto size{m_logtypes.size() * sizeof(std::string)};
+    for (auto const& logtype : m_logtypes) {
+        size += get_string_heap_size(logtype.size());
+    }
+    size += m_log_levels.capacity() * sizeof(LogLevel);
+    size += m_logtype_ids.bucket_count() * sizeof(void*);
+    size += m_logtype_ids.size()
+            * (sizeof(decltype(m_logtype_ids)::value_type) + cHashMapNodeOverhead);
+    return size;
+}
+}  // namespace clp_ffi_js::ir
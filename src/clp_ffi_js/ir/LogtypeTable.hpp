@@ -0,0 +1,58 @@
+#ifndef CLP_FFI_JS_IR_LOGTYPETABLE_HPP
+#define CLP_FFI_JS_IR_LOGTYPETABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <clp_ffi_js/constants.hpp>
+
+namespace clp_ffi_js::ir {
+using logtype_id_t = uint32_t;
+
+/**
+ * Table of the distinct logtypes in an unstructured stream, so that each log event can store a
+ * small logtype ID rather than its own copy of the logtype.
+ *
+ * The table also caches each logtype's log level, since it's derived from the logtype alone.
+ */
+class LogtypeTable {
+public:
+    // Methods
+    /**
+     * Adds the given logtype to the table if it isn't already in it.
+     *
+     * @param logtype
+     * @return The logtype's ID.
+     */
+    [[nodiscard]] auto intern(std::string_view logtype) -> logtype_id_t;
+
+    [[nodiscard]] auto get_logtype(logtype_id_t logtype_id) const -> std::string const& {
+        return m_logtypes.at(logtype_id);
+    }
+
+    [[nodiscard]] auto get_log_level(logtype_id_t logtype_id) const -> LogLevel {
+        return m_log_levels.at(logtype_id);
+    }
+
+    [[nodiscard]] auto get_num_logtypes() const -> size_t { return m_logtypes.size(); }
+
+    /**
+     * @return The number of bytes the table allocates on the heap.
+     */
+    [[nodiscard]] auto get_heap_size() const -> size_t;
+
+private:
+    // Variables
+    // NOTE: We use a deque so that the keys in `m_logtype_ids` remain valid as logtypes are added.
+    std::deque<std::string> m_logtypes;
+    std::vector<LogLevel> m_log_levels;
+    std::unordered_map<std::string_view, logtype_id_t> m_logtype_ids;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_LOGTYPETABLE_HPP
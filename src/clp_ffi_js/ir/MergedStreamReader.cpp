@@ -0,0 +1,264 @@
+#include "MergedStreamReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+#include <emscripten/bind.h>
+#include <emscripten/em_asm.h>
+#include <emscripten/val.h>
+#include <spdlog/spdlog.h>
+
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/StreamReader.hpp>
+
+namespace clp_ffi_js::ir {
+auto MergedStreamReader::create(
+        DataArraysTsType const& data_arrays,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<MergedStreamReader> {
+    auto const num_sources{data_arrays["length"].as<size_t>()};
+    std::vector<std::unique_ptr<StreamReader>> sources;
+    sources.reserve(num_sources);
+    for (size_t i{0}; i < num_sources; ++i) {
+        sources.emplace_back(StreamReader::create(DataArrayTsType{data_arrays[i]}, reader_options));
+    }
+    return std::unique_ptr<MergedStreamReader>(new MergedStreamReader{std::move(sources)});
+}
+
+auto MergedStreamReader::get_filtered_log_event_map() const -> FilteredLogEventMapTsType {
+    if (false == m_filtered_log_event_map.has_value()) {
+        return FilteredLogEventMapTsType{emscripten::val::null()};
+    }
+
+    return FilteredLogEventMapTsType{emscripten::val::array(m_filtered_log_event_map.value())};
+}
+
+void MergedStreamReader::filter_log_events(LogLevelFilterTsType const& log_level_filter) {
+    ++m_filtered_log_event_map_generation;
+    if (log_level_filter.isNull()) {
+        m_filtered_log_event_map.reset();
+        return;
+    }
+
+    auto const log_levels{
+            emscripten::vecFromJSArray<std::underlying_type_t<LogLevel>>(log_level_filter)
+    };
+    auto& filtered_log_event_map{m_filtered_log_event_map.emplace()};
+    std::vector<size_t> selected_log_event_indices;
+    std::vector<size_t> merged;
+    for (size_t source_idx{0}; source_idx < m_sources.size(); ++source_idx) {
+        m_sources[source_idx]->get_log_level_index().get_log_event_indices(
+                log_levels,
+                selected_log_event_indices
+        );
+
+        // Map the stream's selected log events into the merged collection. They're only out of
+        // order if the stream's log events aren't in timestamp order.
+        auto const& merged_log_event_indices{m_merged_log_event_indices[source_idx]};
+        for (auto& log_event_idx : selected_log_event_indices) {
+            log_event_idx = merged_log_event_indices[log_event_idx];
+        }
+        if (false == std::ranges::is_sorted(selected_log_event_indices)) {
+            std::ranges::sort(selected_log_event_indices);
+        }
+
+        merged.clear();
+        merged.reserve(filtered_log_event_map.size() + selected_log_event_indices.size());
+        std::ranges::merge(
+                filtered_log_event_map,
+                selected_log_event_indices,
+                std::back_inserter(merged)
+        );
+        filtered_log_event_map.swap(merged);
+    }
+}
+
+auto MergedStreamReader::deserialize_stream() -> size_t {
+    for (auto const& source : m_sources) {
+        std::ignore = source->deserialize_stream();
+    }
+    merge();
+    m_filtered_log_event_map.reset();
+    ++m_filtered_log_event_map_generation;
+    return m_merged_log_events.size();
+}
+
+auto MergedStreamReader::decode_range(size_t begin_idx, size_t end_idx, bool use_filter)
+        -> MergedDecodedResultsTsType {
+    if (use_filter && false == m_filtered_log_event_map.has_value()) {
+        return MergedDecodedResultsTsType{emscripten::val::null()};
+    }
+    auto const length{use_filter ? m_filtered_log_event_map->size() : m_merged_log_events.size()};
+    if (length < end_idx || begin_idx > end_idx) {
+        SPDLOG_ERROR("Invalid log event index range: {}-{}", begin_idx, end_idx);
+        return MergedDecodedResultsTsType{emscripten::val::null()};
+    }
+
+    auto get_merged_log_event = [&](size_t idx) -> MergedLogEvent const& {
+        return m_merged_log_events[use_filter ? m_filtered_log_event_map->at(idx) : idx];
+    };
+
+    // Decode each stream's log events in a single batch, so that each reader can load (and decode
+    // in parallel) all of the log events it needs at once.
+    std::vector<std::vector<size_t>> source_log_event_indices(m_sources.size());
+    for (auto idx{begin_idx}; idx < end_idx; ++idx) {
+        auto const& [log_event_idx, source_idx]{get_merged_log_event(idx)};
+        source_log_event_indices[source_idx].emplace_back(log_event_idx);
+    }
+    std::vector<std::vector<std::string>> source_messages;
+    source_messages.reserve(m_sources.size());
+    for (size_t source_idx{0}; source_idx < m_sources.size(); ++source_idx) {
+        source_messages.emplace_back(
+                m_sources[source_idx]->decode_log_events(source_log_event_indices[source_idx])
+        );
+    }
+
+    auto const results{emscripten::val::array()};
+    std::vector<size_t> next_message_positions(m_sources.size(), 0);
+    for (auto idx{begin_idx}; idx < end_idx; ++idx) {
+        auto const& merged_log_event{get_merged_log_event(idx)};
+        auto const& [log_event_idx, source_idx]{merged_log_event};
+        auto const& message{source_messages[source_idx][next_message_positions[source_idx]++]};
+        EM_ASM(
+                { Emval.toValue($0).push([UTF8ToString($1), $2, $3, $4, $5]); },
+                results.as_handle(),
+                message.c_str(),
+                get_timestamp(merged_log_event),
+                static_cast<std::underlying_type_t<LogLevel>>(
+                        m_sources[source_idx]->get_log_levels()[log_event_idx]
+                ),
+                log_event_idx + 1,
+                source_idx
+        );
+    }
+
+    return MergedDecodedResultsTsType(results);
+}
+
+auto MergedStreamReader::find_nearest_log_event_by_timestamp(clp::ir::epoch_time_ms_t target_ts
+) const -> NullableLogEventIdx {
+    if (m_merged_log_events.empty()) {
+        return NullableLogEventIdx{emscripten::val::null()};
+    }
+
+    auto const it{std::ranges::upper_bound(
+            m_merged_log_events,
+            target_ts,
+            std::less{},
+            [&](MergedLogEvent const& log_event) { return get_timestamp(log_event); }
+    )};
+    auto const num_preceding_log_events{
+            static_cast<size_t>(std::distance(m_merged_log_events.begin(), it))
+    };
+    return NullableLogEventIdx{
+            emscripten::val(0 == num_preceding_log_events ? 0 : num_preceding_log_events - 1)
+    };
+}
+
+auto MergedStreamReader::merge() -> void {
+    // Each cursor walks one stream in timestamp order (see `TimestampIndex`).
+    struct Cursor {
+        clp::ir::epoch_time_ms_t timestamp;
+        uint32_t source_idx;
+        size_t pos;
+    };
+    auto is_later = [](Cursor const& lhs, Cursor const& rhs) {
+        return std::tie(lhs.timestamp, lhs.source_idx) > std::tie(rhs.timestamp, rhs.source_idx);
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(is_later)> cursors{is_later};
+
+    size_t num_log_events{0};
+    for (size_t source_idx{0}; source_idx < m_sources.size(); ++source_idx) {
+        auto const& source{*m_sources[source_idx]};
+        auto const& timestamp_index{source.get_timestamp_index()};
+        num_log_events += timestamp_index.get_num_indexed_log_events();
+        m_merged_log_event_indices[source_idx].resize(timestamp_index.get_num_indexed_log_events());
+        if (0 != timestamp_index.get_num_indexed_log_events()) {
+            cursors.push(
+                    {source.get_timestamps()[timestamp_index.get_log_event_idx(0)],
+                     static_cast<uint32_t>(source_idx),
+                     0}
+            );
+        }
+    }
+
+    m_merged_log_events.clear();
+    m_merged_log_events.reserve(num_log_events);
+    while (false == cursors.empty()) {
+        auto cursor{cursors.top()};
+        cursors.pop();
+        auto const& source{*m_sources[cursor.source_idx]};
+        auto const& timestamp_index{source.get_timestamp_index()};
+        auto const log_event_idx{timestamp_index.get_log_event_idx(cursor.pos)};
+        m_merged_log_event_indices[cursor.source_idx][log_event_idx] = m_merged_log_events.size();
+        m_merged_log_events.push_back({log_event_idx, cursor.source_idx});
+
+        ++cursor.pos;
+        if (cursor.pos < timestamp_index.get_num_indexed_log_events()) {
+            cursor.timestamp
+                    = source.get_timestamps()[timestamp_index.get_log_event_idx(cursor.pos)];
+            cursors.push(cursor);
+        }
+    }
+}
+}  // namespace clp_ffi_js::ir
+
+namespace {
+EMSCRIPTEN_BINDINGS(ClpMergedStreamReader) {
+    // JS types used as inputs
+    emscripten::register_type<clp_ffi_js::ir::DataArraysTsType>("Uint8Array[]");
+
+    // JS types used as outputs
+    emscripten::register_type<clp_ffi_js::ir::MergedDecodedResultsTsType>(
+            "Array<[string, bigint, number, number, number]> | null"
+    );
+    emscripten::class_<clp_ffi_js::ir::MergedStreamReader>("ClpMergedStreamReader")
+            .constructor(
+                    &clp_ffi_js::ir::MergedStreamReader::create,
+                    emscripten::return_value_policy::take_ownership()
+            )
+            .function("getNumSources", &clp_ffi_js::ir::MergedStreamReader::get_num_sources)
+            .function(
+                    "getNumEventsBuffered",
+                    &clp_ffi_js::ir::MergedStreamReader::get_num_events_buffered
+            )
+            .function(
+                    "getFilteredLogEventMap",
+                    &clp_ffi_js::ir::MergedStreamReader::get_filtered_log_event_map
+            )
+            .function(
+                    "getFilteredLogEventMapView",
+                    &clp_ffi_js::ir::MergedStreamReader::get_filtered_log_event_map_view
+            )
+            .function(
+                    "getFilteredLogEventMapGeneration",
+                    &clp_ffi_js::ir::MergedStreamReader::get_filtered_log_event_map_generation
+            )
+            .function(
+                    "filteredIdxToEventIdx",
+                    &clp_ffi_js::ir::MergedStreamReader::get_log_event_idx
+            )
+            .function(
+                    "eventIdxToFilteredIdx",
+                    &clp_ffi_js::ir::MergedStreamReader::get_filtered_log_event_idx
+            )
+            .function("filterLogEvents", &clp_ffi_js::ir::MergedStreamReader::filter_log_events)
+            .function("deserializeStream", &clp_ffi_js::ir::MergedStreamReader::deserialize_stream)
+            .function("decodeRange", &clp_ffi_js::ir::MergedStreamReader::decode_range)
+            .function(
+                    "findNearestLogEventByTimestamp",
+                    &clp_ffi_js::ir::MergedStreamReader::find_nearest_log_event_by_timestamp
+            );
+}
+}  // namespace
@@ -0,0 +1,188 @@
+#ifndef CLP_FFI_JS_IR_MERGEDSTREAMREADER_HPP
+#define CLP_FFI_JS_IR_MERGEDSTREAMREADER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+#include <emscripten/val.h>
+
+#include <clp_ffi_js/ir/StreamReader.hpp>
+
+namespace clp_ffi_js::ir {
+// JS types used as inputs
+EMSCRIPTEN_DECLARE_VAL_TYPE(DataArraysTsType);
+
+// JS types used as outputs
+EMSCRIPTEN_DECLARE_VAL_TYPE(MergedDecodedResultsTsType);
+
+/**
+ * Class to read multiple IR streams (e.g., one per host or service) as a single collection of log
+ * events ordered by timestamp.
+ *
+ * Each stream is read by its own `StreamReader`, and the merged order is built by k-way merging the
+ * streams' timestamp indices, so the log events themselves are never copied. Log events with equal
+ * timestamps are ordered by their stream's position in the input array, and then by their order in
+ * the stream. Indices into the merged collection are only valid until the next call to
+ * `deserialize_stream`.
+ */
+class MergedStreamReader {
+public:
+    /**
+     * Creates a `MergedStreamReader` to read from the given arrays.
+     *
+     * @param data_arrays An array of arrays, each containing a Zstandard-compressed IR stream.
+     * @param reader_options The options for reading every stream (see `StreamReader::create`).
+     * @return The created instance.
+     * @throw ClpFfiJsException if any stream's reader can't be created.
+     */
+    [[nodiscard]] static auto
+    create(DataArraysTsType const& data_arrays, ReaderOptions const& reader_options)
+            -> std::unique_ptr<MergedStreamReader>;
+
+    // Destructor
+    ~MergedStreamReader() = default;
+
+    // Disable copy/move constructors and assignment operators since instances are only ever owned
+    // through a `std::unique_ptr`.
+    MergedStreamReader(MergedStreamReader const&) = delete;
+    MergedStreamReader(MergedStreamReader&&) = delete;
+    auto operator=(MergedStreamReader const&) -> MergedStreamReader& = delete;
+    auto operator=(MergedStreamReader&&) -> MergedStreamReader& = delete;
+
+    // Methods
+    [[nodiscard]] auto get_num_sources() const -> size_t { return m_sources.size(); }
+
+    /**
+     * @return The number of log events buffered so far across all streams.
+     */
+    [[nodiscard]] auto get_num_events_buffered() const -> size_t {
+        return m_merged_log_events.size();
+    }
+
+    /**
+     * @return The filtered log events map, as indices into the merged collection.
+     */
+    [[nodiscard]] auto get_filtered_log_event_map() const -> FilteredLogEventMapTsType;
+
+    /**
+     * @return See `StreamReader::get_filtered_log_event_map_view`.
+     */
+    [[nodiscard]] auto get_filtered_log_event_map_view() const -> FilteredLogEventMapViewTsType {
+        return StreamReader::create_filtered_log_event_map_view(m_filtered_log_event_map);
+    }
+
+    /**
+     * @return A number that changes whenever the filtered log events map changes.
+     */
+    [[nodiscard]] auto get_filtered_log_event_map_generation() const -> size_t {
+        return m_filtered_log_event_map_generation;
+    }
+
+    /**
+     * @param filtered_log_event_idx
+     * @return See `StreamReader::get_log_event_idx`.
+     */
+    [[nodiscard]] auto get_log_event_idx(size_t filtered_log_event_idx) const
+            -> NullableLogEventIdx {
+        return StreamReader::generic_get_log_event_idx(
+                m_filtered_log_event_map,
+                filtered_log_event_idx
+        );
+    }
+
+    /**
+     * @param log_event_idx
+     * @return See `StreamReader::get_filtered_log_event_idx`.
+     */
+    [[nodiscard]] auto get_filtered_log_event_idx(size_t log_event_idx) const
+            -> NullableLogEventIdx {
+        return StreamReader::generic_get_filtered_log_event_idx(
+                m_filtered_log_event_map,
+                log_event_idx
+        );
+    }
+
+    /**
+     * Generates a filtered collection from all log events.
+     *
+     * The collection is generated by merging the log events that each stream's log level index
+     * selects, rather than by scanning every log event.
+     *
+     * @param log_level_filter Array of selected log levels, or null to remove the filter.
+     */
+    void filter_log_events(LogLevelFilterTsType const& log_level_filter);
+
+    /**
+     * Deserializes every stream, and then rebuilds the merged collection and removes the filter.
+     *
+     * @return The number of log events buffered across all streams.
+     * @throw ClpFfiJsException if any stream can't be deserialized.
+     */
+    [[nodiscard]] auto deserialize_stream() -> size_t;
+
+    /**
+     * Decodes log events in the range `[beginIdx, endIdx)` of the merged or filtered collection.
+     *
+     * @param begin_idx
+     * @param end_idx
+     * @param use_filter Whether to decode from the filtered collection.
+     * @return An array of decoded log events, each of the form `[message, timestamp, logLevel,
+     * logEventNum, sourceIdx]`, where `logEventNum` is the 1-based number of the log event within
+     * its stream, and `sourceIdx` is the index of the stream in the input array.
+     * @return null if any error occurs.
+     * @throw ClpFfiJsException if any message cannot be decoded.
+     */
+    [[nodiscard]] auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter)
+            -> MergedDecodedResultsTsType;
+
+    /**
+     * Finds the log event whose timestamp is the last one less than or equal to the target, or the
+     * first log event if every timestamp is greater than the target.
+     *
+     * @param target_ts
+     * @return The index of the log event in the merged collection, or null if there are no log
+     * events.
+     */
+    [[nodiscard]] auto find_nearest_log_event_by_timestamp(clp::ir::epoch_time_ms_t target_ts
+    ) const -> NullableLogEventIdx;
+
+private:
+    // Types
+    struct MergedLogEvent {
+        size_t log_event_idx;
+        uint32_t source_idx;
+    };
+
+    // Constructor
+    explicit MergedStreamReader(std::vector<std::unique_ptr<StreamReader>> sources)
+            : m_sources{std::move(sources)},
+              m_merged_log_event_indices(m_sources.size()) {}
+
+    // Methods
+    /**
+     * Rebuilds `m_merged_log_events` (and `m_merged_log_event_indices`) from the streams' timestamp
+     * indices.
+     */
+    auto merge() -> void;
+
+    [[nodiscard]] auto get_timestamp(MergedLogEvent const& log_event) const
+            -> clp::ir::epoch_time_ms_t {
+        return m_sources[log_event.source_idx]->get_timestamps()[log_event.log_event_idx];
+    }
+
+    // Variables
+    std::vector<std::unique_ptr<StreamReader>> m_sources;
+    std::vector<MergedLogEvent> m_merged_log_events;
+    // The index in `m_merged_log_events` of each stream's log events, indexed by source index and
+    // then by log event index.
+    std::vector<std::vector<size_t>> m_merged_log_event_indices;
+    FilteredLogEventsMap m_filtered_log_event_map;
+    size_t m_filtered_log_event_map_generation{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_MERGEDSTREAMREADER_HPP
@@ -0,0 +1,260 @@
+#include "PackedStructuredLogEvents.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+#include <clp/ir/EncodedTextAst.hpp>
+#include <clp/time_types.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+
+namespace clp_ffi_js::ir {
+auto PackedStructuredLogEvents::append(StructuredLogEvent const& log_event) -> void {
+    auto const log_event_idx{get_num_log_events()};
+    if (m_utc_offsets.empty() || m_utc_offsets.back().second != log_event.get_utc_offset()) {
+        m_utc_offsets.emplace_back(log_event_idx, log_event.get_utc_offset());
+    }
+    for (auto const& [node_id, value] : log_event.get_node_id_value_pairs()) {
+        m_values.emplace_back(pack_value(node_id, value));
+    }
+    m_log_event_end_offsets.emplace_back(m_values.size());
+}
+
+auto PackedStructuredLogEvents::unpack(size_t log_event_idx) const -> StructuredLogEvent {
+    if (log_event_idx >= get_num_log_events()) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_OutOfBounds,
+                __FILENAME__,
+                __LINE__,
+                std::format("Packed log event {} doesn't exist", log_event_idx)
+        };
+    }
+
+    auto const begin_offset{0 == log_event_idx ? 0 : m_log_event_end_offsets[log_event_idx - 1]};
+    auto const packed_values{std::span{m_values}.subspan(
+            begin_offset,
+            m_log_event_end_offsets[log_event_idx] - begin_offset
+    )};
+    StructuredLogEvent::NodeIdValuePairs id_value_pairs;
+    id_value_pairs.reserve(packed_values.size());
+    for (auto const& packed_value : packed_values) {
+        id_value_pairs.emplace(packed_value.node_id, unpack_value(packed_value));
+    }
+
+    // The log event's UTC offset is that of the last change at or before it.
+    auto const utc_offset_it{std::ranges::upper_bound(
+            m_utc_offsets,
+            log_event_idx,
+            {},
+            &std::pair<size_t, clp::UtcOffset>::first
+    )};
+    auto result{StructuredLogEvent::create(
+            m_schema_tree,
+            std::move(id_value_pairs),
+            std::prev(utc_offset_it)->second
+    )};
+    if (result.has_error()) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Corrupt,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Failed to unpack log event {}: {}",
+                        log_event_idx,
+                        result.error().message()
+                )
+        };
+    }
+    return std::move(result.value());
+}
+
+auto PackedStructuredLogEvents::get_heap_size() const -> size_t {
+    // Each element of a hash map is allocated individually alongside a pointer to the next element
+    // and the element's hash.
+    constexpr size_t cHashMapNodeOverhead{sizeof(void*) + sizeof(size_t)};
+
+    auto size{m_values.capacity() * sizeof(PackedValue)
+              + m_log_event_end_offsets.capacity() * sizeof(size_t)
+              + m_encoded_text_ast_words.capacity() * sizeof(uint64_t)
+              + m_utc_offsets.capacity() * sizeof(decltype(m_utc_offsets)::value_type)
+              + m_string_blocks.capacity() * sizeof(std::vector<char>)
+              + m_strings.capacity() * sizeof(std::string_view)};
+    for (auto const& block : m_string_blocks) {
+        size += block.capacity();
+    }
+    size += m_interned_string_ids.bucket_count() * sizeof(void*);
+    size += m_interned_string_ids.size()
+            * (sizeof(decltype(m_interned_string_ids)::value_type) + cHashMapNodeOverhead);
+    return size;
+}
+
+auto PackedStructuredLogEvents::shrink_to_fit() -> void {
+    m_values.shrink_to_fit();
+    m_log_event_end_offsets.shrink_to_fit();
+    m_encoded_text_ast_words.shrink_to_fit();
+    m_utc_offsets.shrink_to_fit();
+    m_string_blocks.shrink_to_fit();
+    m_strings.shrink_to_fit();
+}
+
+auto PackedStructuredLogEvents::pack_value(
+        clp::ffi::SchemaTree::Node::id_t node_id,
+        std::optional<clp::ffi::Value> const& value
+) -> PackedValue {
+    if (false == value.has_value()) {
+        return {0, node_id, ValueType::Empty};
+    }
+    if (value->is_null()) {
+        return {0, node_id, ValueType::Null};
+    }
+    if (value->is<clp::ffi::value_int_t>()) {
+        return {std::bit_cast<uint64_t>(value->get_immutable_view<clp::ffi::value_int_t>()),
+                node_id,
+                ValueType::Int};
+    }
+    if (value->is<clp::ffi::value_float_t>()) {
+        return {std::bit_cast<uint64_t>(value->get_immutable_view<clp::ffi::value_float_t>()),
+                node_id,
+                ValueType::Float};
+    }
+    if (value->is<clp::ffi::value_bool_t>()) {
+        return {value->get_immutable_view<clp::ffi::value_bool_t>() ? uint64_t{1} : uint64_t{0},
+                node_id,
+                ValueType::Bool};
+    }
+    if (value->is<std::string>()) {
+        auto const str{value->get_immutable_view<std::string>()};
+        return {add_string(str, str.size() <= cMaxInternedStringSize), node_id, ValueType::String};
+    }
+    if (value->is<clp::ir::FourByteEncodedTextAst>()) {
+        return {pack_encoded_text_ast(value->get_immutable_view<clp::ir::FourByteEncodedTextAst>()),
+                node_id,
+                ValueType::FourByteEncodedTextAst};
+    }
+    return {pack_encoded_text_ast(value->get_immutable_view<clp::ir::EightByteEncodedTextAst>()),
+            node_id,
+            ValueType::EightByteEncodedTextAst};
+}
+
+auto PackedStructuredLogEvents::unpack_value(PackedValue const& packed_value) const
+        -> std::optional<clp::ffi::Value> {
+    switch (packed_value.type) {
+        case ValueType::Empty:
+            return std::nullopt;
+        case ValueType::Null:
+            return clp::ffi::Value{};
+        case ValueType::Int:
+            return clp::ffi::Value{std::bit_cast<clp::ffi::value_int_t>(packed_value.payload)};
+        case ValueType::Float:
+            return clp::ffi::Value{std::bit_cast<clp::ffi::value_float_t>(packed_value.payload)};
+        case ValueType::Bool:
+            return clp::ffi::Value{clp::ffi::value_bool_t{0 != packed_value.payload}};
+        case ValueType::String:
+            return clp::ffi::Value{std::string{m_strings[packed_value.payload]}};
+        case ValueType::FourByteEncodedTextAst:
+            return clp::ffi::Value{unpack_encoded_text_ast<int32_t>(packed_value.payload)};
+        case ValueType::EightByteEncodedTextAst:
+        default:
+            return clp::ffi::Value{unpack_encoded_text_ast<int64_t>(packed_value.payload)};
+    }
+}
+
+template <typename encoded_variable_t>
+auto PackedStructuredLogEvents::pack_encoded_text_ast(
+        clp::ir::EncodedTextAst<encoded_variable_t> const& encoded_text_ast
+) -> uint64_t {
+    auto const offset{m_encoded_text_ast_words.size()};
+    // Logtypes are interned regardless of their size since a stream only has a few of them.
+    m_encoded_text_ast_words.emplace_back(add_string(encoded_text_ast.get_logtype(), true));
+
+    auto const& dict_vars{encoded_text_ast.get_dict_vars()};
+    m_encoded_text_ast_words.emplace_back(dict_vars.size());
+    for (auto const& dict_var : dict_vars) {
+        m_encoded_text_ast_words.emplace_back(
+                add_string(dict_var, dict_var.size() <= cMaxInternedStringSize)
+        );
+    }
+
+    auto const& encoded_vars{encoded_text_ast.get_encoded_vars()};
+    m_encoded_text_ast_words.emplace_back(encoded_vars.size());
+    for (auto const encoded_var : encoded_vars) {
+        m_encoded_text_ast_words.emplace_back(
+                std::bit_cast<uint64_t>(static_cast<int64_t>(encoded_var))
+        );
+    }
+    return offset;
+}
+
+template <typename encoded_variable_t>
+auto PackedStructuredLogEvents::unpack_encoded_text_ast(uint64_t offset) const
+        -> clp::ir::EncodedTextAst<encoded_variable_t> {
+    auto next_word_it{m_encoded_text_ast_words.begin() + static_cast<std::ptrdiff_t>(offset)};
+    std::string logtype{m_strings[*next_word_it++]};
+
+    std::vector<std::string> dict_vars(*next_word_it++);
+    for (auto& dict_var : dict_vars) {
+        dict_var = m_strings[*next_word_it++];
+    }
+
+    std::vector<encoded_variable_t> encoded_vars(*next_word_it++);
+    for (auto& encoded_var : encoded_vars) {
+        encoded_var = static_cast<encoded_variable_t>(std::bit_cast<int64_t>(*next_word_it++));
+    }
+    return {std::move(logtype), std::move(dict_vars), std::move(encoded_vars)};
+}
+
+auto PackedStructuredLogEvents::add_string(std::string_view str, bool intern) -> uint64_t {
+    if (intern) {
+        if (auto const it{m_interned_string_ids.find(str)}; m_interned_string_ids.end() != it) {
+            return it->second;
+        }
+    }
+
+    auto const id{m_strings.size()};
+    auto const stored_str{store_string(str)};
+    m_strings.emplace_back(stored_str);
+    if (intern && m_interned_string_ids.size() < cMaxNumInternedStrings) {
+        m_interned_string_ids.emplace(stored_str, id);
+    }
+    return id;
+}
+
+auto PackedStructuredLogEvents::store_string(std::string_view str) -> std::string_view {
+    if (str.size() > cStringBlockSize) {
+        // Give the string its own block, inserted before the current block so that the current
+        // block's remaining space isn't wasted.
+        // NOTE: Moving the current block doesn't reallocate its data.
+        auto const block_it{m_string_blocks.emplace(
+                m_string_blocks.empty() ? m_string_blocks.end() : std::prev(m_string_blocks.end()),
+                str.begin(),
+                str.end()
+        )};
+        return {block_it->data(), block_it->size()};
+    }
+
+    if (m_string_blocks.empty()
+        || m_string_blocks.back().capacity() - m_string_blocks.back().size() < str.size())
+    {
+        m_string_blocks.emplace_back().reserve(cStringBlockSize);
+    }
+    auto& block{m_string_blocks.back()};
+    auto const begin_pos{block.size()};
+    // NOTE: The block's capacity suffices, so it isn't reallocated.
+    block.insert(block.end(), str.begin(), str.end());
+    return {block.data() + begin_pos, str.size()};
+}
+}  // namespace clp_ffi_js::ir
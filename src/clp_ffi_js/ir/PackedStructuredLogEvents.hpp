@@ -0,0 +1,173 @@
+#ifndef CLP_FFI_JS_IR_PACKEDSTRUCTUREDLOGEVENTS_HPP
+#define CLP_FFI_JS_IR_PACKEDSTRUCTUREDLOGEVENTS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+#include <clp/ir/EncodedTextAst.hpp>
+#include <clp/time_types.hpp>
+
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Storage for the log events of a structured IR stream that packs every log event's kv-pairs into
+ * a few contiguous buffers instead of keeping each log event's map and strings as individual heap
+ * allocations, and unpacks log events on demand.
+ *
+ * Strings (string values, and the logtypes and dictionary variables of encoded text ASTs) are
+ * stored in large blocks. Logtypes and short strings are interned, so repeated values such as
+ * hostnames or service names are only stored once. Since interning unique strings (e.g., request
+ * IDs) would only grow the intern table, at most `cMaxNumInternedStrings` distinct strings are
+ * interned, after which new strings are just appended.
+ *
+ * Since log events can only be unpacked with the stream's schema tree, the schema-tree node
+ * insertions must be mirrored into the storage as they're deserialized.
+ */
+class PackedStructuredLogEvents {
+public:
+    // Constants
+    static constexpr size_t cMaxInternedStringSize{64};
+    static constexpr size_t cMaxNumInternedStrings{size_t{1} << 16U};
+    static constexpr size_t cStringBlockSize{size_t{64} * 1024};
+
+    // Constructors
+    PackedStructuredLogEvents() : m_schema_tree{std::make_shared<clp::ffi::SchemaTree>()} {}
+
+    // Methods
+    /**
+     * Inserts a node into the storage's copy of the stream's schema tree.
+     *
+     * @param locator
+     */
+    auto insert_schema_tree_node(clp::ffi::SchemaTree::NodeLocator const& locator) -> void {
+        m_schema_tree->insert_node(locator);
+    }
+
+    /**
+     * Packs the next log event.
+     *
+     * @param log_event
+     */
+    auto append(StructuredLogEvent const& log_event) -> void;
+
+    [[nodiscard]] auto get_num_log_events() const -> size_t {
+        return m_log_event_end_offsets.size();
+    }
+
+    /**
+     * @param log_event_idx
+     * @return The unpacked log event.
+     * @throw ClpFfiJsException if the log event doesn't exist or can't be unpacked.
+     */
+    [[nodiscard]] auto unpack(size_t log_event_idx) const -> StructuredLogEvent;
+
+    /**
+     * @return The number of bytes held by the packed log events and their strings, excluding the
+     * copy of the schema tree.
+     */
+    [[nodiscard]] auto get_heap_size() const -> size_t;
+
+    /**
+     * Releases any capacity reserved but unused by the packed log events.
+     *
+     * NOTE: The string blocks aren't shrunk, since the stored strings are referenced by address.
+     */
+    auto shrink_to_fit() -> void;
+
+private:
+    // Types
+    enum class ValueType : uint8_t {
+        // The key exists but has no value (e.g., an empty object).
+        Empty,
+        Null,
+        Int,
+        Float,
+        Bool,
+        String,
+        FourByteEncodedTextAst,
+        EightByteEncodedTextAst,
+    };
+
+    /**
+     * A kv-pair, where `payload` holds the bits of an integer, float, or bool; the ID of a string;
+     * or the offset of an encoded text AST in `m_encoded_text_ast_words`.
+     */
+    struct PackedValue {
+        uint64_t payload;
+        clp::ffi::SchemaTree::Node::id_t node_id;
+        ValueType type;
+    };
+
+    // Methods
+    [[nodiscard]] auto pack_value(
+            clp::ffi::SchemaTree::Node::id_t node_id,
+            std::optional<clp::ffi::Value> const& value
+    ) -> PackedValue;
+
+    [[nodiscard]] auto unpack_value(PackedValue const& packed_value) const
+            -> std::optional<clp::ffi::Value>;
+
+    /**
+     * Packs an encoded text AST into `m_encoded_text_ast_words` as its logtype's string ID, the
+     * number of dictionary variables, the variables' string IDs, the number of encoded variables,
+     * and the encoded variables.
+     *
+     * @tparam encoded_variable_t
+     * @param encoded_text_ast
+     * @return The offset of the packed encoded text AST.
+     */
+    template <typename encoded_variable_t>
+    [[nodiscard]] auto
+    pack_encoded_text_ast(clp::ir::EncodedTextAst<encoded_variable_t> const& encoded_text_ast)
+            -> uint64_t;
+
+    template <typename encoded_variable_t>
+    [[nodiscard]] auto unpack_encoded_text_ast(uint64_t offset) const
+            -> clp::ir::EncodedTextAst<encoded_variable_t>;
+
+    /**
+     * Stores a string, or finds the stored copy of it if it's interned.
+     *
+     * @param str
+     * @param intern Whether to intern the string.
+     * @return The string's ID.
+     */
+    [[nodiscard]] auto add_string(std::string_view str, bool intern) -> uint64_t;
+
+    /**
+     * Copies a string into the string blocks.
+     *
+     * @param str
+     * @return A view of the copy.
+     */
+    [[nodiscard]] auto store_string(std::string_view str) -> std::string_view;
+
+    // Variables
+    std::shared_ptr<clp::ffi::SchemaTree> m_schema_tree;
+
+    std::vector<PackedValue> m_values;
+    // The offset of the end of each log event's kv-pairs in `m_values`
+    std::vector<size_t> m_log_event_end_offsets;
+    std::vector<uint64_t> m_encoded_text_ast_words;
+    // The index of the first log event with each UTC offset, which rarely changes within a stream
+    std::vector<std::pair<size_t, clp::UtcOffset>> m_utc_offsets;
+
+    // Blocks that stored strings are copied into. Blocks are never reallocated, so views of the
+    // stored strings remain valid.
+    std::vector<std::vector<char>> m_string_blocks;
+    // Each stored string, indexed by ID
+    std::vector<std::string_view> m_strings;
+    std::unordered_map<std::string_view, uint64_t> m_interned_string_ids;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_PACKEDSTRUCTUREDLOGEVENTS_HPP
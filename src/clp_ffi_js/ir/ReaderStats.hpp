@@ -0,0 +1,210 @@
+#ifndef CLP_FFI_JS_IR_READERSTATS_HPP
+#define CLP_FFI_JS_IR_READERSTATS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <clp/ffi/ir_stream/IrUnitType.hpp>
+#include <clp/type_utils.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Phases of reading a stream that `ReaderStats` attributes time to.
+ */
+enum class ReaderPhase : uint8_t {
+    // Reading bytes from the Zstandard decompressor.
+    Decompression,
+    // Parsing IR units, excluding the time spent in the other phases.
+    IrUnitParsing,
+    // Extracting log events' filter fields (log level and timestamp) and buffering the log events.
+    LogEventHandling,
+    // Reserving more capacity for the buffered log events.
+    BufferGrowth,
+    // Updating the log level and timestamp indices.
+    Indexing,
+    LENGTH,  // This isn't a valid phase.
+};
+
+/**
+ * Counters that `ReaderStats` keeps.
+ */
+enum class ReaderCounter : uint8_t {
+    NumBytesDecompressed,
+    NumLogEventIrUnits,
+    NumSchemaTreeNodeInsertionIrUnits,
+    NumUtcOffsetChangeIrUnits,
+    NumEndOfStreamIrUnits,
+    // Log events emitted by the deserializer, including those deserialized again to materialize
+    // lazy log events.
+    NumEventsEmitted,
+    NumBufferGrowths,
+    LENGTH,  // This isn't a valid counter.
+};
+
+constexpr size_t cNumReaderPhases{clp::enum_to_underlying_type(ReaderPhase::LENGTH)};
+constexpr size_t cNumReaderCounters{clp::enum_to_underlying_type(ReaderCounter::LENGTH)};
+
+/**
+ * Class to collect counters and per-phase timings of a `StreamReader`, so that slow reads can be
+ * attributed to a specific phase.
+ *
+ * Collection is only compiled in if `CLP_FFI_JS_ENABLE_STATS` is set, since timing phases costs a
+ * few clock reads per IR unit. Otherwise, every method is a no-op and every value is 0.
+ *
+ * Time is attributed to the innermost active phase (see `ScopedPhase`), so nested phases don't
+ * double count: e.g., time spent decompressing while parsing an IR unit is only attributed to
+ * `ReaderPhase::Decompression`.
+ */
+class ReaderStats {
+public:
+    /**
+     * RAII object that makes a phase the active phase for its lifetime, restoring the previously
+     * active phase (if any) when destroyed.
+     */
+    class ScopedPhase {
+    public:
+        // Constructor
+        ScopedPhase([[maybe_unused]] ReaderStats& stats, [[maybe_unused]] ReaderPhase phase)
+#if CLP_FFI_JS_ENABLE_STATS
+                : m_stats{stats},
+                  m_prev_phase{stats.enter_phase(phase)}
+#endif
+        {
+        }
+
+        // Destructor
+        ~ScopedPhase() {
+#if CLP_FFI_JS_ENABLE_STATS
+            m_stats.exit_phase(m_prev_phase);
+#endif
+        }
+
+        // Disable copy/move constructors and assignment operators
+        ScopedPhase(ScopedPhase const&) = delete;
+        ScopedPhase(ScopedPhase&&) = delete;
+        auto operator=(ScopedPhase const&) -> ScopedPhase& = delete;
+        auto operator=(ScopedPhase&&) -> ScopedPhase& = delete;
+
+#if CLP_FFI_JS_ENABLE_STATS
+
+    private:
+        ReaderStats& m_stats;
+        std::optional<ReaderPhase> m_prev_phase;
+#endif
+    };
+
+    // Methods
+    /**
+     * @return Whether stats are collected in this build.
+     */
+    [[nodiscard]] static constexpr auto is_enabled() -> bool {
+#if CLP_FFI_JS_ENABLE_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    auto increment([[maybe_unused]] ReaderCounter counter, [[maybe_unused]] uint64_t value = 1)
+            -> void {
+#if CLP_FFI_JS_ENABLE_STATS
+        m_counters.at(clp::enum_to_underlying_type(counter)) += value;
+#endif
+    }
+
+    /**
+     * Increments the counter of the given type of IR unit. Unknown types aren't counted.
+     *
+     * @param ir_unit_type
+     */
+    auto increment(clp::ffi::ir_stream::IrUnitType ir_unit_type) -> void {
+        switch (ir_unit_type) {
+            case clp::ffi::ir_stream::IrUnitType::LogEvent:
+                increment(ReaderCounter::NumLogEventIrUnits);
+                break;
+            case clp::ffi::ir_stream::IrUnitType::SchemaTreeNodeInsertion:
+                increment(ReaderCounter::NumSchemaTreeNodeInsertionIrUnits);
+                break;
+            case clp::ffi::ir_stream::IrUnitType::UtcOffsetChange:
+                increment(ReaderCounter::NumUtcOffsetChangeIrUnits);
+                break;
+            case clp::ffi::ir_stream::IrUnitType::EndOfStream:
+                increment(ReaderCounter::NumEndOfStreamIrUnits);
+                break;
+            default:
+                break;
+        }
+    }
+
+    [[nodiscard]] auto get_count([[maybe_unused]] ReaderCounter counter) const -> uint64_t {
+#if CLP_FFI_JS_ENABLE_STATS
+        return m_counters.at(clp::enum_to_underlying_type(counter));
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @param phase
+     * @return The total time attributed to the phase, in milliseconds.
+     */
+    [[nodiscard]] auto get_duration_ms([[maybe_unused]] ReaderPhase phase) const -> double {
+#if CLP_FFI_JS_ENABLE_STATS
+        return std::chrono::duration<double, std::milli>{
+                m_durations.at(clp::enum_to_underlying_type(phase))
+        }
+                .count();
+#else
+        return 0;
+#endif
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+#if CLP_FFI_JS_ENABLE_STATS
+    // Methods
+    /**
+     * Attributes the time since the last phase change to the active phase, and then makes `phase`
+     * the active phase.
+     *
+     * @param phase
+     * @return The previously active phase, if any.
+     */
+    auto enter_phase(ReaderPhase phase) -> std::optional<ReaderPhase> {
+        auto const prev_phase{m_active_phase};
+        change_phase(phase);
+        return prev_phase;
+    }
+
+    /**
+     * Attributes the time since the last phase change to the active phase, and then makes
+     * `prev_phase` the active phase.
+     *
+     * @param prev_phase
+     */
+    auto exit_phase(std::optional<ReaderPhase> prev_phase) -> void { change_phase(prev_phase); }
+
+    auto change_phase(std::optional<ReaderPhase> phase) -> void {
+        auto const now{Clock::now()};
+        if (m_active_phase.has_value()) {
+            m_durations.at(clp::enum_to_underlying_type(m_active_phase.value()))
+                    += now - m_active_phase_begin_time;
+        }
+        m_active_phase = phase;
+        m_active_phase_begin_time = now;
+    }
+
+    // Variables
+    std::array<uint64_t, cNumReaderCounters> m_counters{};
+    std::array<Clock::duration, cNumReaderPhases> m_durations{};
+    std::optional<ReaderPhase> m_active_phase;
+    Clock::time_point m_active_phase_begin_time;
+#endif
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_READERSTATS_HPP
@@ -0,0 +1,100 @@
+#include "RewindableReader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include <clp/ErrorCode.hpp>
+
+#include <clp_ffi_js/ir/ReaderStats.hpp>
+
+namespace clp_ffi_js::ir {
+auto RewindableReader::try_seek_from_begin(size_t pos) -> clp::ErrorCode {
+    // The read head can't be moved back if any byte it passed wasn't retained.
+    auto const retained_end_pos{m_checkpoint_pos + m_retained_bytes.size()};
+    if (pos < m_checkpoint_pos || (pos < m_pos && m_pos > retained_end_pos)) {
+        return clp::ErrorCode::ErrorCode_Unsupported;
+    }
+
+    constexpr size_t cDiscardBufferSize{4096};
+    std::array<char, cDiscardBufferSize> discard_buffer{};
+    while (m_pos < pos) {
+        size_t num_bytes_read{0};
+        auto const error_code{try_read(
+                discard_buffer.data(),
+                std::min(discard_buffer.size(), pos - m_pos),
+                num_bytes_read
+        )};
+        if (clp::ErrorCode::ErrorCode_Success != error_code) {
+            return error_code;
+        }
+    }
+    m_pos = pos;
+    return clp::ErrorCode::ErrorCode_Success;
+}
+
+auto RewindableReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    num_bytes_read = 0;
+
+    // Serve as much as possible from the retained bytes
+    auto const retained_end_pos{m_checkpoint_pos + m_retained_bytes.size()};
+    if (m_pos < retained_end_pos) {
+        num_bytes_read = std::min(retained_end_pos - m_pos, num_bytes_to_read);
+        std::memcpy(buf, m_retained_bytes.data() + (m_pos - m_checkpoint_pos), num_bytes_read);
+        m_pos += num_bytes_read;
+    }
+    if (num_bytes_read == num_bytes_to_read) {
+        return clp::ErrorCode::ErrorCode_Success;
+    }
+
+    // Read the rest from the wrapped reader
+    size_t num_bytes_read_from_reader{0};
+    clp::ErrorCode error_code{};
+    {
+        ReaderStats::ScopedPhase const decompression_phase{*m_stats, ReaderPhase::Decompression};
+        error_code = m_reader.try_read(
+                buf + num_bytes_read,
+                num_bytes_to_read - num_bytes_read,
+                num_bytes_read_from_reader
+        );
+    }
+    m_stats->increment(ReaderCounter::NumBytesDecompressed, num_bytes_read_from_reader);
+    if (clp::ErrorCode::ErrorCode_Success != error_code
+        && clp::ErrorCode::ErrorCode_EndOfFile != error_code)
+    {
+        return error_code;
+    }
+    if (m_is_retaining_bytes) {
+        m_retained_bytes.insert(
+                m_retained_bytes.end(),
+                buf + num_bytes_read,
+                buf + num_bytes_read + num_bytes_read_from_reader
+        );
+    }
+    num_bytes_read += num_bytes_read_from_reader;
+    m_pos += num_bytes_read_from_reader;
+
+    if (0 == num_bytes_read && 0 != num_bytes_to_read) {
+        return clp::ErrorCode::ErrorCode_EndOfFile;
+    }
+    return clp::ErrorCode::ErrorCode_Success;
+}
+
+auto RewindableReader::set_checkpoint(bool retain_bytes) -> void {
+    // NOTE: If bytes weren't retained since the last checkpoint, fewer bytes than were read may be
+    // retained.
+    auto const num_bytes_to_release{m_pos - m_checkpoint_pos};
+    if (num_bytes_to_release >= m_retained_bytes.size()) {
+        m_retained_bytes.clear();
+    } else {
+        m_retained_bytes.erase(
+                m_retained_bytes.begin(),
+                m_retained_bytes.begin() + static_cast<std::ptrdiff_t>(num_bytes_to_release)
+        );
+    }
+    m_checkpoint_pos = m_pos;
+    m_is_retaining_bytes = retain_bytes;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,119 @@
+#ifndef CLP_FFI_JS_IR_REWINDABLEREADER_HPP
+#define CLP_FFI_JS_IR_REWINDABLEREADER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+
+#include <clp_ffi_js/ir/ReaderStats.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * A `clp::ReaderInterface` that wraps another (forward-only) reader and can retain every byte read
+ * since the last checkpoint, so that the read head can be moved back anywhere between the
+ * checkpoint and the furthest position read.
+ *
+ * This allows a deserializer to retry an IR unit that was truncated because the underlying input
+ * hasn't been fully supplied yet. Since retaining bytes costs a copy of every byte read, callers
+ * choose at each checkpoint whether the bytes after it need to be retained (e.g., only while the
+ * input is incomplete).
+ */
+class RewindableReader : public clp::ReaderInterface {
+public:
+    // Constructors
+    /**
+     * @param reader
+     * @param stats The stats in which to record the bytes read from `reader` (the decompressor)
+     * and the time spent reading them.
+     */
+    RewindableReader(clp::ReaderInterface& reader, std::shared_ptr<ReaderStats> stats)
+            : m_reader{reader},
+              m_stats{std::move(stats)} {}
+
+    // Disable copy/move constructors and assignment operators since deserializers hold references
+    // to this instance.
+    RewindableReader(RewindableReader const&) = delete;
+    RewindableReader(RewindableReader&&) = delete;
+    auto operator=(RewindableReader const&) -> RewindableReader& = delete;
+    auto operator=(RewindableReader&&) -> RewindableReader& = delete;
+
+    // Destructor
+    ~RewindableReader() override = default;
+
+    // Methods implementing `clp::ReaderInterface`
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        pos = m_pos;
+        return clp::ErrorCode::ErrorCode_Success;
+    }
+
+    /**
+     * @param pos
+     * @return ErrorCode_Unsupported if `pos` is before the last checkpoint, or is before the read
+     * head and the bytes up to the read head weren't all retained.
+     * @return Forwards `try_read`'s return values if the reader needs to read forward to `pos`.
+     * @return ErrorCode_Success otherwise.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override;
+
+    /**
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return ErrorCode_EndOfFile if there are no more bytes to read.
+     * @return Forwards the wrapped reader's `try_read` return values on any other failure.
+     * @return ErrorCode_Success otherwise.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    // Methods
+    /**
+     * Sets a checkpoint at the current position, releasing all retained bytes before it.
+     *
+     * Bytes that were already retained past the checkpoint (i.e., after a rewind) are still read
+     * back even if `retain_bytes` is false.
+     *
+     * @param retain_bytes Whether to retain the bytes read after the checkpoint. If false, the read
+     * head can't be moved back to the checkpoint, and `get_bytes_since_checkpoint` can't be used,
+     * until the next checkpoint.
+     */
+    auto set_checkpoint(bool retain_bytes) -> void;
+
+    /**
+     * Moves the read head back to the last checkpoint.
+     *
+     * NOTE: The checkpoint must have been set with `retain_bytes` enabled.
+     */
+    auto rewind_to_checkpoint() -> void { m_pos = m_checkpoint_pos; }
+
+    [[nodiscard]] auto get_checkpoint_pos() const -> size_t { return m_checkpoint_pos; }
+
+    /**
+     * NOTE: The checkpoint must have been set with `retain_bytes` enabled.
+     *
+     * @return A view of the bytes between the last checkpoint and the read head. The view is
+     * invalidated by any subsequent read or checkpoint.
+     */
+    [[nodiscard]] auto get_bytes_since_checkpoint() const -> std::span<char const> {
+        return {m_retained_bytes.data(), m_pos - m_checkpoint_pos};
+    }
+
+private:
+    // Variables
+    clp::ReaderInterface& m_reader;
+    std::shared_ptr<ReaderStats> m_stats;
+    // Bytes read from `m_reader` since `m_checkpoint_pos`, if `m_is_retaining_bytes`
+    std::vector<char> m_retained_bytes;
+    size_t m_checkpoint_pos{0};
+    size_t m_pos{0};
+    // Bytes are retained until the first checkpoint so that the stream's header can be read again.
+    bool m_is_retaining_bytes{true};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_REWINDABLEREADER_HPP
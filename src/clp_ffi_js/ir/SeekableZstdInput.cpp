@@ -0,0 +1,144 @@
+#include "SeekableZstdInput.hpp"
+
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <clp/Array.hpp>
+#include <clp/ErrorCode.hpp>
+#include <clp/TraceableException.hpp>
+#include <zstd.h>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/ir/ZstdFrameIndex.hpp>
+
+namespace clp_ffi_js::ir {
+auto SeekableZstdInput::create(
+        std::shared_ptr<clp::Array<char> const> compressed_input,
+        std::optional<std::span<char const>> seek_table
+) -> std::unique_ptr<SeekableZstdInput> {
+    std::span<char const> const input{compressed_input->data(), compressed_input->size()};
+    auto frame_index{
+            seek_table.has_value()
+                    ? ZstdFrameIndex::create_from_seek_table(seek_table.value(), input)
+                    : ZstdFrameIndex::create(input)
+    };
+    if (false == frame_index.has_value() || frame_index->get_num_frames() <= 1
+        || frame_index->get_max_frame_decompressed_size() > cMaxFrameDecompressedSize)
+    {
+        return nullptr;
+    }
+    // NOTE: The constructor is private, so `std::make_unique` can't be used.
+    return std::unique_ptr<SeekableZstdInput>{
+            new SeekableZstdInput{std::move(compressed_input), std::move(frame_index.value())}
+    };
+}
+
+auto SeekableZstdInput::read(size_t begin_pos, size_t size) -> std::span<char const> {
+    auto const decompressed_size{m_frame_index.get_decompressed_size()};
+    if (begin_pos > decompressed_size || size > decompressed_size - begin_pos) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_OutOfBounds,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Range [{}, {}) exceeds the decompressed size {}",
+                        begin_pos,
+                        begin_pos + size,
+                        decompressed_size
+                )
+        };
+    }
+    if (0 == size) {
+        return {};
+    }
+
+    auto const begin_frame_idx{m_frame_index.find_frame_idx(begin_pos)};
+    auto const end_frame_idx{m_frame_index.find_frame_idx(begin_pos + size - 1) + 1};
+    if (begin_frame_idx < m_buffer_begin_frame_idx || end_frame_idx > m_buffer_end_frame_idx) {
+        decompress_frames(begin_frame_idx, end_frame_idx);
+    }
+    auto const buffer_begin_pos{
+            m_frame_index.get_frames()[m_buffer_begin_frame_idx].decompressed_begin_pos
+    };
+    return std::span<char const>{m_buffer}.subspan(begin_pos - buffer_begin_pos, size);
+}
+
+auto SeekableZstdInput::release_buffer() -> void {
+    m_buffer = {};
+    m_buffer_begin_frame_idx = 0;
+    m_buffer_end_frame_idx = 0;
+}
+
+SeekableZstdInput::SeekableZstdInput(
+        std::shared_ptr<clp::Array<char> const> compressed_input,
+        ZstdFrameIndex frame_index
+)
+        : m_compressed_input{std::move(compressed_input)},
+          m_frame_index{std::move(frame_index)},
+          m_dctx{ZSTD_createDCtx()} {
+    if (nullptr == m_dctx) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_NoMem,
+                __FILENAME__,
+                __LINE__,
+                "Failed to create Zstandard decompression context."
+        };
+    }
+}
+
+auto SeekableZstdInput::decompress_frames(size_t begin_frame_idx, size_t end_frame_idx) -> void {
+    auto const frames{
+            m_frame_index.get_frames().subspan(begin_frame_idx, end_frame_idx - begin_frame_idx)
+    };
+    auto const& last_frame{frames.back()};
+    auto const buffer_begin_pos{frames.front().decompressed_begin_pos};
+    auto const buffer_end_pos{last_frame.decompressed_begin_pos + last_frame.decompressed_size};
+
+    // Invalidate the buffer first in case decompression fails.
+    m_buffer_begin_frame_idx = 0;
+    m_buffer_end_frame_idx = 0;
+    m_buffer.resize(buffer_end_pos - buffer_begin_pos);
+    for (size_t i{0}; i < frames.size(); ++i) {
+        auto const& frame{frames[i]};
+        auto const num_bytes_decompressed{ZSTD_decompressDCtx(
+                m_dctx.get(),
+                m_buffer.data() + (frame.decompressed_begin_pos - buffer_begin_pos),
+                frame.decompressed_size,
+                m_compressed_input->data() + frame.compressed_begin_pos,
+                frame.compressed_size
+        )};
+        if (ZSTD_isError(num_bytes_decompressed)) {
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_Corrupt,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format(
+                            "Failed to decompress Zstandard frame {}: {}",
+                            begin_frame_idx + i,
+                            ZSTD_getErrorName(num_bytes_decompressed)
+                    )
+            };
+        }
+        if (frame.decompressed_size != num_bytes_decompressed) {
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_Corrupt,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format(
+                            "Zstandard frame {} decompressed to {} bytes rather than {}",
+                            begin_frame_idx + i,
+                            num_bytes_decompressed,
+                            frame.decompressed_size
+                    )
+            };
+        }
+    }
+    m_buffer_begin_frame_idx = begin_frame_idx;
+    m_buffer_end_frame_idx = end_frame_idx;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,120 @@
+#ifndef CLP_FFI_JS_IR_SEEKABLEZSTDINPUT_HPP
+#define CLP_FFI_JS_IR_SEEKABLEZSTDINPUT_HPP
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <clp/Array.hpp>
+#include <zstd.h>
+
+#include <clp_ffi_js/ir/ZstdFrameIndex.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * A complete multi-frame Zstandard input that supports decompressing any range of its output by
+ * decompressing only the frames overlapping the range (see `ZstdFrameIndex`).
+ *
+ * The most recently decompressed frames are kept, so that consecutive reads within the same frames
+ * don't decompress them again.
+ */
+class SeekableZstdInput {
+public:
+    // Constants
+    // Inputs with larger frames aren't considered seekable, since reading any part of such a frame
+    // would cost nearly as much as decompressing the input linearly.
+    static constexpr size_t cMaxFrameDecompressedSize{16UL * 1024 * 1024};
+
+    // Factory functions
+    /**
+     * @param compressed_input
+     * @param seek_table A seek table supplied separately from the input, if any.
+     * @return The seekable input, or nullptr if the input doesn't contain more than one frame, any
+     * frame's decompressed size exceeds `cMaxFrameDecompressedSize`, or the input can't be indexed
+     * (see `ZstdFrameIndex`).
+     */
+    [[nodiscard]] static auto create(
+            std::shared_ptr<clp::Array<char> const> compressed_input,
+            std::optional<std::span<char const>> seek_table
+    ) -> std::unique_ptr<SeekableZstdInput>;
+
+    // Disable copy/move constructors and assignment operators since instances are only ever owned
+    // through a `std::unique_ptr`.
+    SeekableZstdInput(SeekableZstdInput const&) = delete;
+    SeekableZstdInput(SeekableZstdInput&&) = delete;
+    auto operator=(SeekableZstdInput const&) -> SeekableZstdInput& = delete;
+    auto operator=(SeekableZstdInput&&) -> SeekableZstdInput& = delete;
+
+    // Destructor
+    ~SeekableZstdInput() = default;
+
+    // Methods
+    [[nodiscard]] auto get_frame_index() const -> ZstdFrameIndex const& { return m_frame_index; }
+
+    [[nodiscard]] auto get_compressed_input() const -> std::span<char const> {
+        return {m_compressed_input->data(), m_compressed_input->size()};
+    }
+
+    [[nodiscard]] auto get_compressed_size() const -> size_t { return m_compressed_input->size(); }
+
+    /**
+     * Decompresses the given range of the output.
+     *
+     * @param begin_pos
+     * @param size
+     * @return A view of the range, which is invalidated by the next call to `read` or
+     * `release_buffer`.
+     * @throw ClpFfiJsException if the range is out of bounds or a frame can't be decompressed.
+     */
+    [[nodiscard]] auto read(size_t begin_pos, size_t size) -> std::span<char const>;
+
+    /**
+     * @return The number of bytes held by the frame index and the decompressed frames. The
+     * compressed input is excluded since it may be shared.
+     */
+    [[nodiscard]] auto get_heap_size() const -> size_t {
+        return m_frame_index.get_heap_size() + m_buffer.capacity();
+    }
+
+    /**
+     * Releases the decompressed frames.
+     */
+    auto release_buffer() -> void;
+
+private:
+    // Types
+    struct DecompressionContextDeleter {
+        auto operator()(ZSTD_DCtx* dctx) const -> void { ZSTD_freeDCtx(dctx); }
+    };
+
+    // Constructors
+    SeekableZstdInput(
+            std::shared_ptr<clp::Array<char> const> compressed_input,
+            ZstdFrameIndex frame_index
+    );
+
+    // Methods
+    /**
+     * Decompresses the frames in the range `[begin_frame_idx, end_frame_idx)` into the buffer.
+     *
+     * @param begin_frame_idx
+     * @param end_frame_idx
+     * @throw ClpFfiJsException if a frame can't be decompressed.
+     */
+    auto decompress_frames(size_t begin_frame_idx, size_t end_frame_idx) -> void;
+
+    // Variables
+    std::shared_ptr<clp::Array<char> const> m_compressed_input;
+    ZstdFrameIndex m_frame_index;
+    std::unique_ptr<ZSTD_DCtx, DecompressionContextDeleter> m_dctx;
+
+    // The decompressed frames in the range `[m_buffer_begin_frame_idx, m_buffer_end_frame_idx)`
+    std::vector<char> m_buffer;
+    size_t m_buffer_begin_frame_idx{0};
+    size_t m_buffer_end_frame_idx{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_SEEKABLEZSTDINPUT_HPP
@@ -1,11 +1,15 @@
 #include "StreamReader.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <format>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -13,23 +17,80 @@
 #include <clp/ErrorCode.hpp>
 #include <clp/ffi/ir_stream/decoding_methods.hpp>
 #include <clp/ffi/ir_stream/protocol_constants.hpp>
+#include <clp/ir/types.hpp>
 #include <clp/ReaderInterface.hpp>
 #include <clp/streaming_compression/zstd/Decompressor.hpp>
 #include <clp/TraceableException.hpp>
 #include <clp/type_utils.hpp>
 #include <emscripten/bind.h>
+#include <emscripten/val.h>
 #include <json/single_include/nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
 #include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/ChunkedReader.hpp>
+#include <clp_ffi_js/ir/FilterCache.hpp>
+#include <clp_ffi_js/ir/LogEventDiagnostics.hpp>
+#include <clp_ffi_js/ir/LogLevelIndex.hpp>
+#include <clp_ffi_js/ir/ReaderStats.hpp>
+#include <clp_ffi_js/ir/RewindableReader.hpp>
+#include <clp_ffi_js/ir/SeekableZstdInput.hpp>
 #include <clp_ffi_js/ir/StructuredIrStreamReader.hpp>
+#include <clp_ffi_js/ir/TextQuery.hpp>
+#include <clp_ffi_js/ir/TimestampIndex.hpp>
+#include <clp_ffi_js/ir/typed_array.hpp>
 #include <clp_ffi_js/ir/UnstructuredIrStreamReader.hpp>
 
 namespace {
 using ClpFfiJsException = clp_ffi_js::ClpFfiJsException;
 using IRErrorCode = clp::ffi::ir_stream::IRErrorCode;
 
+// Capacity of the buffer the Zstandard decompressor uses to read compressed input.
+constexpr size_t cZstdReadBufferCapacity{128UL * 1024};
+
+// Parameters used to estimate how many log events to reserve space for.
+constexpr size_t cMinNumReservedLogEvents{256};
+// Before any log event has been deserialized, the number of log events is estimated from the size
+// of the input using this ratio. The ratio is on the low end for compressed IR, so the estimate
+// tends to exceed the actual number of log events. The first reservation is therefore capped at
+// `cMaxInitialNumReservedLogEvents`, so that large inputs can't exhaust the wasm heap before any
+// log event has been read. Later reservations extrapolate the observed ratio instead.
+constexpr size_t cEstimatedCompressedBytesPerLogEvent{16};
+constexpr size_t cMaxInitialNumReservedLogEvents{size_t{64} * 1024};
+// Fraction (1/x) of the extrapolated number of log events to reserve as headroom.
+constexpr size_t cReservedLogEventsHeadroomDivisor{8};
+
+// Keys in `ReaderOptions`
+constexpr std::string_view cReaderOptionsZstdSeekTableKey{"zstdSeekTable"};
+
+// Keys in `SearchOptionsTsType`
+constexpr std::string_view cSearchOptionsCaseSensitiveKey{"caseSensitive"};
+constexpr std::string_view cSearchOptionsLogLevelFilterKey{"logLevelFilter"};
+constexpr std::string_view cSearchOptionsRegexKey{"regex"};
+
 // Function declarations
+/**
+ * Copies an array from JavaScript into C++.
+ * @param data_array
+ * @return The copied array.
+ */
+auto copy_data_array(clp_ffi_js::ir::DataArrayTsType const& data_array) -> clp::Array<char>;
+
+/**
+ * Indexes the frames of the input so that it can be decompressed from any frame, which only lazy
+ * structured IR stream readers do (see `StructuredIrStreamReader::is_lazy`).
+ *
+ * @param compressed_input A complete compressed input.
+ * @param reader_options
+ * @return The seekable input, or nullptr if `reader_options` don't set `lazy` or the input isn't
+ * seekable (see `SeekableZstdInput::create`).
+ */
+auto create_seekable_input(
+        std::shared_ptr<clp::Array<char> const> compressed_input,
+        clp_ffi_js::ir::ReaderOptions const& reader_options
+) -> std::unique_ptr<clp_ffi_js::ir::SeekableZstdInput>;
+
 /**
  * Rewinds the reader to the beginning then validates the CLP IR data encoding type.
  * @param reader
@@ -46,6 +107,48 @@ auto rewind_reader_and_validate_encoding_type(clp::ReaderInterface& reader) -> v
  */
 auto get_version(clp::ReaderInterface& reader) -> std::string;
 
+auto copy_data_array(clp_ffi_js::ir::DataArrayTsType const& data_array) -> clp::Array<char> {
+    auto const length{data_array["length"].as<size_t>()};
+    clp::Array<char> data_buffer{length};
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    emscripten::val::module_property("HEAPU8")
+            .call<void>("set", data_array, reinterpret_cast<uintptr_t>(data_buffer.data()));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    return data_buffer;
+}
+
+auto create_seekable_input(
+        std::shared_ptr<clp::Array<char> const> compressed_input,
+        clp_ffi_js::ir::ReaderOptions const& reader_options
+) -> std::unique_ptr<clp_ffi_js::ir::SeekableZstdInput> {
+    if (false == clp_ffi_js::ir::StructuredIrStreamReader::is_lazy(reader_options)) {
+        return nullptr;
+    }
+
+    std::optional<clp::Array<char>> seek_table;
+    auto const seek_table_option{reader_options[cReaderOptionsZstdSeekTableKey.data()]};
+    if (false == seek_table_option.isUndefined()) {
+        seek_table.emplace(copy_data_array(clp_ffi_js::ir::DataArrayTsType{seek_table_option}));
+    }
+
+    std::optional<std::span<char const>> seek_table_view;
+    if (seek_table.has_value()) {
+        seek_table_view.emplace(seek_table->data(), seek_table->size());
+    }
+    auto seekable_input{
+            clp_ffi_js::ir::SeekableZstdInput::create(std::move(compressed_input), seek_table_view)
+    };
+    if (nullptr != seekable_input) {
+        SPDLOG_INFO(
+                "Indexed {} Zstandard frames in the input",
+                seekable_input->get_frame_index().get_num_frames()
+        );
+    } else if (seek_table.has_value()) {
+        SPDLOG_WARN("Ignoring Zstandard seek table that doesn't match the input");
+    }
+    return seekable_input;
+}
+
 auto rewind_reader_and_validate_encoding_type(clp::ReaderInterface& reader) -> void {
     reader.seek_from_begin(0);
 
@@ -116,26 +219,70 @@ auto get_version(clp::ReaderInterface& reader) -> std::string {
 EMSCRIPTEN_BINDINGS(ClpStreamReader) {
     // JS types used as inputs
     emscripten::register_type<clp_ffi_js::ir::DataArrayTsType>("Uint8Array");
+    emscripten::register_type<clp_ffi_js::ir::KeyPathsTsType>("string[][]");
     emscripten::register_type<clp_ffi_js::ir::LogLevelFilterTsType>("number[] | null");
+    emscripten::register_type<clp_ffi_js::ir::PredicateTsType>("string | null");
     emscripten::register_type<clp_ffi_js::ir::ReaderOptions>(
-            "{logLevelKey: string, timestampKey: string} | null"
+            "{logLevelKey: string, timestampKey: string, lazy?: boolean, packed?: boolean, "
+            "logLevelAliases?: Record<string, number>, zstdSeekTable?: Uint8Array} | null"
+    );
+    emscripten::register_type<clp_ffi_js::ir::SearchOptionsTsType>(
+            "{caseSensitive: boolean, regex: boolean, logLevelFilter?: number[] | null}"
     );
 
     // JS types used as outputs
     emscripten::enum_<clp_ffi_js::ir::StreamType>("IrStreamType")
             .value("STRUCTURED", clp_ffi_js::ir::StreamType::Structured)
             .value("UNSTRUCTURED", clp_ffi_js::ir::StreamType::Unstructured);
+    emscripten::register_type<clp_ffi_js::ir::DecodedColumnarResultsTsType>(
+            "{messages: Uint8Array, messageOffsets: Uint32Array, timestamps: BigInt64Array, "
+            "logLevels: Uint8Array, logEventNums: Uint32Array} | null"
+    );
     emscripten::register_type<clp_ffi_js::ir::DecodedResultsTsType>(
             "Array<[string, bigint, number, number]>"
     );
+    emscripten::register_type<clp_ffi_js::ir::DeserializationProgressTsType>(
+            "{numEventsBuffered: number, numBytesDeserialized: number, "
+            "numCompressedBytesConsumed: number, isStreamCompleted: boolean}"
+    );
+    emscripten::register_type<clp_ffi_js::ir::DiagnosticsTsType>(
+            "Record<\"invalidLogLevelType\" | \"invalidTimestampType\" | "
+            "\"unparsableTimestamp\" | \"unhandledUtcOffsetChange\", "
+            "{count: number, firstLogEventIndices: number[]}>"
+    );
+    emscripten::register_type<clp_ffi_js::ir::ExportChunkTsType>("Uint8Array | null");
     emscripten::register_type<clp_ffi_js::ir::FilteredLogEventMapTsType>("number[] | null");
+    emscripten::register_type<clp_ffi_js::ir::FilteredLogEventMapViewTsType>(
+            "Uint32Array | null"
+    );
+    emscripten::register_type<clp_ffi_js::ir::LogLevelCountsTsType>("number[]");
+    emscripten::register_type<clp_ffi_js::ir::MemoryUsageTsType>(
+            "{eventStorage: number, schemaTree: number, filterMap: number, "
+            "compressedInput: number, total: number}"
+    );
     emscripten::register_type<clp_ffi_js::ir::NullableLogEventIdx>("number | null");
+    emscripten::register_type<clp_ffi_js::ir::StatsTsType>(
+            "{counters: {bytesDecompressed: number, irUnits: {logEvent: number, "
+            "schemaTreeNodeInsertion: number, utcOffsetChange: number, endOfStream: number}, "
+            "eventsEmitted: number, bufferGrowths: number}, phaseMs: {decompression: number, "
+            "irUnitParsing: number, logEventHandling: number, bufferGrowth: number, "
+            "indexing: number}} | null"
+    );
+    emscripten::register_type<clp_ffi_js::ir::TimeHistogramTsType>("number[]");
     emscripten::class_<clp_ffi_js::ir::StreamReader>("ClpStreamReader")
             .constructor(
                     &clp_ffi_js::ir::StreamReader::create,
                     emscripten::return_value_policy::take_ownership()
             )
+            .class_function(
+                    "createChunked",
+                    &clp_ffi_js::ir::StreamReader::create_chunked,
+                    emscripten::return_value_policy::take_ownership()
+            )
             .function("getIrStreamType", &clp_ffi_js::ir::StreamReader::get_ir_stream_type)
+            .function("pushChunk", &clp_ffi_js::ir::StreamReader::push_chunk)
+            .function("markInputComplete", &clp_ffi_js::ir::StreamReader::mark_input_complete)
+            .function("appendData", &clp_ffi_js::ir::StreamReader::append_data)
             .function(
                     "getNumEventsBuffered",
                     &clp_ffi_js::ir::StreamReader::get_num_events_buffered
@@ -144,63 +291,188 @@ EMSCRIPTEN_BINDINGS(ClpStreamReader) {
                     "getFilteredLogEventMap",
                     &clp_ffi_js::ir::StreamReader::get_filtered_log_event_map
             )
+            .function(
+                    "getFilteredLogEventMapView",
+                    &clp_ffi_js::ir::StreamReader::get_filtered_log_event_map_view
+            )
+            .function(
+                    "getFilteredLogEventMapGeneration",
+                    &clp_ffi_js::ir::StreamReader::get_filtered_log_event_map_generation
+            )
+            .function(
+                    "filteredIdxToEventIdx",
+                    &clp_ffi_js::ir::StreamReader::get_log_event_idx
+            )
+            .function(
+                    "eventIdxToFilteredIdx",
+                    &clp_ffi_js::ir::StreamReader::get_filtered_log_event_idx
+            )
+            .function("getMemoryUsage", &clp_ffi_js::ir::StreamReader::get_memory_usage)
+            .function("getStats", &clp_ffi_js::ir::StreamReader::get_stats)
+            .function("getDiagnostics", &clp_ffi_js::ir::StreamReader::get_diagnostics)
+            .function("shrinkToFit", &clp_ffi_js::ir::StreamReader::shrink_to_fit)
             .function("filterLogEvents", &clp_ffi_js::ir::StreamReader::filter_log_events)
+            .function("searchLogEvents", &clp_ffi_js::ir::StreamReader::search_log_events)
+            .function(
+                    "getLogLevelCounts",
+                    &clp_ffi_js::ir::StreamReader::get_log_level_counts
+            )
+            .function(
+                    "filterByTimeRange",
+                    &clp_ffi_js::ir::StreamReader::filter_log_events_by_time_range
+            )
+            .function(
+                    "filterByPredicate",
+                    &clp_ffi_js::ir::StreamReader::filter_log_events_by_predicate
+            )
+            .function("clearTimeRange", &clp_ffi_js::ir::StreamReader::clear_time_range)
+            .function("getTimeHistogram", &clp_ffi_js::ir::StreamReader::get_time_histogram)
             .function("deserializeStream", &clp_ffi_js::ir::StreamReader::deserialize_stream)
+            .function("deserializeNext", &clp_ffi_js::ir::StreamReader::deserialize_next)
             .function("decodeRange", &clp_ffi_js::ir::StreamReader::decode_range)
+            .function(
+                    "decodeRangeColumnar",
+                    &clp_ffi_js::ir::StreamReader::decode_range_columnar
+            )
+            .function(
+                    "decodeRangeProjected",
+                    &clp_ffi_js::ir::StreamReader::decode_range_projected
+            )
+            .function("beginExport", &clp_ffi_js::ir::StreamReader::begin_export)
+            .function("exportNextChunk", &clp_ffi_js::ir::StreamReader::export_next_chunk)
             .function(
                     "findNearestLogEventByTimestamp",
                     &clp_ffi_js::ir::StreamReader::find_nearest_log_event_by_timestamp
-            );
+            )
+            .function("exportIndex", &clp_ffi_js::ir::StreamReader::export_index)
+            .function("importIndex", &clp_ffi_js::ir::StreamReader::import_index);
 }
 }  // namespace
 
 namespace clp_ffi_js::ir {
 auto StreamReader::create(DataArrayTsType const& data_array, ReaderOptions const& reader_options)
         -> std::unique_ptr<StreamReader> {
-    auto const length{data_array["length"].as<size_t>()};
-    SPDLOG_INFO("StreamReader::create: got buffer of length={}", length);
+    auto compressed_input{std::make_shared<clp::Array<char> const>(copy_data_array(data_array))};
+    auto input_reader{std::make_unique<ChunkedReader>()};
+    input_reader->push_chunk(compressed_input);
+    input_reader->mark_input_complete();
+    SPDLOG_INFO(
+            "StreamReader::create: got buffer of length={}",
+            input_reader->get_num_bytes_pushed()
+    );
+    return create_from_input_reader(
+            std::move(input_reader),
+            reader_options,
+            create_seekable_input(std::move(compressed_input), reader_options)
+    );
+}
 
-    // Copy array from JavaScript to C++.
-    clp::Array<char> data_buffer{length};
-    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
-    emscripten::val::module_property("HEAPU8")
-            .call<void>("set", data_array, reinterpret_cast<uintptr_t>(data_buffer.data()));
-    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+auto StreamReader::create_chunked(
+        DataArrayTsType const& first_chunk,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<StreamReader> {
+    auto input_reader{std::make_unique<ChunkedReader>()};
+    input_reader->push_chunk(copy_data_array(first_chunk));
+    SPDLOG_INFO(
+            "StreamReader::create_chunked: got first chunk of length={}",
+            input_reader->get_num_bytes_pushed()
+    );
+    // The chunks are released as they're consumed, so the input can't be seekable.
+    return create_from_input_reader(std::move(input_reader), reader_options, nullptr);
+}
+
+auto StreamReader::push_chunk(DataArrayTsType const& chunk) -> void {
+    auto* input_reader{get_input_reader()};
+    if (nullptr == input_reader) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "Cannot push a chunk after the stream has been exhausted."
+        };
+    }
+    input_reader->push_chunk(copy_data_array(chunk));
+}
+
+auto StreamReader::mark_input_complete() -> void {
+    auto* input_reader{get_input_reader()};
+    if (nullptr == input_reader) {
+        return;
+    }
+    input_reader->mark_input_complete();
+}
 
+auto StreamReader::append_data(DataArrayTsType const& chunk) -> size_t {
+    push_chunk(chunk);
+    auto const num_events_before{get_num_events_buffered()};
+    return deserialize_stream() - num_events_before;
+}
+
+auto StreamReader::export_index() const -> DataArrayTsType {
+    auto const blob{export_index_blob()};
+    auto const array{emscripten::val::global("Uint8Array").new_(blob.size())};
+    array.call<void>(
+            "set",
+            emscripten::typed_memory_view(
+                    blob.size(),
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                    reinterpret_cast<uint8_t const*>(blob.data())
+            )
+    );
+    return DataArrayTsType{array};
+}
+
+auto StreamReader::import_index(DataArrayTsType const& index) -> bool {
+    auto const blob{copy_data_array(index)};
+    return import_index_blob({blob.data(), blob.size()});
+}
+
+auto StreamReader::create_from_input_reader(
+        std::unique_ptr<ChunkedReader>&& input_reader,
+        ReaderOptions const& reader_options,
+        std::unique_ptr<SeekableZstdInput>&& seekable_input
+) -> std::unique_ptr<StreamReader> {
     auto zstd_decompressor{std::make_unique<ZstdDecompressor>()};
-    zstd_decompressor->open(data_buffer.data(), length);
+    zstd_decompressor->open(*input_reader, cZstdReadBufferCapacity);
+    auto stats{std::make_shared<ReaderStats>()};
+    auto reader{std::make_unique<RewindableReader>(*zstd_decompressor, stats)};
 
-    rewind_reader_and_validate_encoding_type(*zstd_decompressor);
+    rewind_reader_and_validate_encoding_type(*reader);
 
     // Validate the stream's version and decide which type of IR stream reader to create.
-    auto pos = zstd_decompressor->get_pos();
-    auto const version{get_version(*zstd_decompressor)};
+    auto pos = reader->get_pos();
+    auto const version{get_version(*reader)};
     try {
         auto const version_validation_result{clp::ffi::ir_stream::validate_protocol_version(version)
         };
         if (clp::ffi::ir_stream::IRProtocolErrorCode::Supported == version_validation_result) {
-            zstd_decompressor->seek_from_begin(0);
+            reader->seek_from_begin(0);
             return std::make_unique<StructuredIrStreamReader>(StructuredIrStreamReader::create(
+                    std::move(input_reader),
                     std::move(zstd_decompressor),
-                    std::move(data_buffer),
-                    reader_options
+                    std::move(reader),
+                    reader_options,
+                    std::move(seekable_input),
+                    std::move(stats)
             ));
         }
         if (clp::ffi::ir_stream::IRProtocolErrorCode::BackwardCompatible
             == version_validation_result)
         {
-            zstd_decompressor->seek_from_begin(pos);
+            reader->seek_from_begin(pos);
             return std::make_unique<UnstructuredIrStreamReader>(UnstructuredIrStreamReader::create(
+                    std::move(input_reader),
                     std::move(zstd_decompressor),
-                    std::move(data_buffer)
+                    std::move(reader),
+                    std::move(stats)
             ));
         }
-    } catch (ZstdDecompressor::OperationFailed const& e) {
+    } catch (clp::ReaderInterface::OperationFailed const& e) {
         throw ClpFfiJsException{
                 clp::ErrorCode::ErrorCode_Failure,
                 __FILENAME__,
                 __LINE__,
-                std::format("Unable to rewind zstd decompressor: {}", e.what())
+                std::format("Unable to rewind IR stream: {}", e.what())
         };
     }
 
@@ -211,4 +483,316 @@ auto StreamReader::create(DataArrayTsType const& data_array, ReaderOptions const
             std::format("Unable to create reader for IR stream with version {}.", version)
     };
 }
+
+auto StreamReader::create_deserialization_progress(
+        size_t num_events_buffered,
+        size_t num_bytes_deserialized,
+        size_t num_compressed_bytes_consumed,
+        bool is_stream_completed
+) -> DeserializationProgressTsType {
+    auto progress{emscripten::val::object()};
+    progress.set("numEventsBuffered", num_events_buffered);
+    progress.set("numBytesDeserialized", num_bytes_deserialized);
+    progress.set("numCompressedBytesConsumed", num_compressed_bytes_consumed);
+    progress.set("isStreamCompleted", is_stream_completed);
+    return DeserializationProgressTsType{progress};
+}
+
+auto StreamReader::validate_log_event_indices(
+        std::span<size_t const> log_event_indices,
+        size_t num_log_events
+) -> void {
+    auto const invalid_it{std::ranges::find_if(log_event_indices, [&](size_t log_event_idx) {
+        return log_event_idx >= num_log_events;
+    })};
+    if (log_event_indices.end() != invalid_it) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_OutOfBounds,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Log event index {} exceeds the number of log events {}",
+                        *invalid_it,
+                        num_log_events
+                )
+        };
+    }
+}
+
+auto StreamReader::estimate_log_events_capacity(
+        size_t num_log_events,
+        ChunkedReader& input_reader
+) -> size_t {
+    // Grow geometrically if the size of the input isn't known yet.
+    auto const min_capacity{
+            std::max(cMinNumReservedLogEvents, num_log_events + num_log_events / 2)
+    };
+    if (false == input_reader.is_input_complete()) {
+        return min_capacity;
+    }
+
+    auto const num_compressed_bytes_total{input_reader.get_num_bytes_pushed()};
+    auto const num_compressed_bytes_consumed{input_reader.get_pos()};
+    size_t estimated_num_log_events{0};
+    if (0 == num_log_events || 0 == num_compressed_bytes_consumed) {
+        estimated_num_log_events = std::min(
+                num_compressed_bytes_total / cEstimatedCompressedBytesPerLogEvent,
+                cMaxInitialNumReservedLogEvents
+        );
+    } else {
+        // NOTE: The decompressor reads ahead of the deserializer, so this underestimates, which
+        // is preferable to overestimating.
+        estimated_num_log_events = static_cast<size_t>(
+                static_cast<double>(num_log_events)
+                * (static_cast<double>(num_compressed_bytes_total)
+                   / static_cast<double>(num_compressed_bytes_consumed))
+        );
+        estimated_num_log_events += estimated_num_log_events / cReservedLogEventsHeadroomDivisor;
+    }
+    return std::max(min_capacity, estimated_num_log_events);
+}
+
+auto StreamReader::create_memory_usage(
+        size_t log_events_size,
+        size_t schema_tree_size,
+        size_t filtered_log_event_map_size,
+        size_t compressed_input_size
+) -> MemoryUsageTsType {
+    auto memory_usage{emscripten::val::object()};
+    memory_usage.set("eventStorage", log_events_size);
+    memory_usage.set("schemaTree", schema_tree_size);
+    memory_usage.set("filterMap", filtered_log_event_map_size);
+    memory_usage.set("compressedInput", compressed_input_size);
+    memory_usage.set(
+            "total",
+            log_events_size + schema_tree_size + filtered_log_event_map_size
+                    + compressed_input_size
+    );
+    return MemoryUsageTsType{memory_usage};
+}
+
+auto StreamReader::create_stats(ReaderStats const& stats) -> StatsTsType {
+    if constexpr (false == ReaderStats::is_enabled()) {
+        return StatsTsType{emscripten::val::null()};
+    }
+
+    // Counts are converted to `double`s since `uint64_t`s would be converted to `BigInt`s.
+    auto const get_count{[&](ReaderCounter counter) -> double {
+        return static_cast<double>(stats.get_count(counter));
+    }};
+
+    auto ir_units{emscripten::val::object()};
+    ir_units.set("logEvent", get_count(ReaderCounter::NumLogEventIrUnits));
+    ir_units.set(
+            "schemaTreeNodeInsertion",
+            get_count(ReaderCounter::NumSchemaTreeNodeInsertionIrUnits)
+    );
+    ir_units.set("utcOffsetChange", get_count(ReaderCounter::NumUtcOffsetChangeIrUnits));
+    ir_units.set("endOfStream", get_count(ReaderCounter::NumEndOfStreamIrUnits));
+
+    auto counters{emscripten::val::object()};
+    counters.set("bytesDecompressed", get_count(ReaderCounter::NumBytesDecompressed));
+    counters.set("irUnits", ir_units);
+    counters.set("eventsEmitted", get_count(ReaderCounter::NumEventsEmitted));
+    counters.set("bufferGrowths", get_count(ReaderCounter::NumBufferGrowths));
+
+    auto phase_ms{emscripten::val::object()};
+    phase_ms.set("decompression", stats.get_duration_ms(ReaderPhase::Decompression));
+    phase_ms.set("irUnitParsing", stats.get_duration_ms(ReaderPhase::IrUnitParsing));
+    phase_ms.set("logEventHandling", stats.get_duration_ms(ReaderPhase::LogEventHandling));
+    phase_ms.set("bufferGrowth", stats.get_duration_ms(ReaderPhase::BufferGrowth));
+    phase_ms.set("indexing", stats.get_duration_ms(ReaderPhase::Indexing));
+
+    auto result{emscripten::val::object()};
+    result.set("counters", counters);
+    result.set("phaseMs", phase_ms);
+    return StatsTsType{result};
+}
+
+auto StreamReader::create_diagnostics(LogEventDiagnostics const& diagnostics)
+        -> DiagnosticsTsType {
+    auto result{emscripten::val::object()};
+    for (size_t i{0}; i < cDiagnosticKindNames.size(); ++i) {
+        auto const kind{static_cast<DiagnosticKind>(i)};
+        auto diagnostic{emscripten::val::object()};
+        diagnostic.set("count", diagnostics.get_count(kind));
+        diagnostic.set(
+                "firstLogEventIndices",
+                emscripten::val::array(diagnostics.get_sampled_log_event_indices(kind))
+        );
+        result.set(cDiagnosticKindNames.at(i).data(), diagnostic);
+    }
+    return DiagnosticsTsType{result};
+}
+
+auto StreamReader::generic_begin_export(
+        size_t begin_idx,
+        size_t end_idx,
+        bool use_filter,
+        FilteredLogEventsMap const& filtered_log_event_map,
+        size_t filtered_log_event_map_generation,
+        size_t num_log_events,
+        ExportBuffer& buffer
+) -> bool {
+    if (false
+        == is_valid_decode_range(
+                begin_idx,
+                end_idx,
+                filtered_log_event_map,
+                num_log_events,
+                use_filter
+        ))
+    {
+        buffer.release();
+        return false;
+    }
+    buffer.reset(begin_idx, end_idx, use_filter, filtered_log_event_map_generation);
+    return true;
+}
+
+auto StreamReader::create_filtered_log_event_map_view(
+        FilteredLogEventsMap const& filtered_log_event_map
+) -> FilteredLogEventMapViewTsType {
+    if (false == filtered_log_event_map.has_value()) {
+        return FilteredLogEventMapViewTsType{emscripten::val::null()};
+    }
+    // NOTE: `size_t` is 32 bits wide in wasm32, so the view is a `Uint32Array`.
+    return FilteredLogEventMapViewTsType{
+            create_typed_array(filtered_log_event_map->size(), filtered_log_event_map->data())
+    };
+}
+
+auto StreamReader::generic_get_log_event_idx(
+        FilteredLogEventsMap const& filtered_log_event_map,
+        size_t filtered_log_event_idx
+) -> NullableLogEventIdx {
+    if (false == filtered_log_event_map.has_value()
+        || filtered_log_event_idx >= filtered_log_event_map->size())
+    {
+        return NullableLogEventIdx{emscripten::val::null()};
+    }
+    return NullableLogEventIdx{emscripten::val(filtered_log_event_map->at(filtered_log_event_idx))};
+}
+
+auto StreamReader::generic_get_filtered_log_event_idx(
+        FilteredLogEventsMap const& filtered_log_event_map,
+        size_t log_event_idx
+) -> NullableLogEventIdx {
+    if (false == filtered_log_event_map.has_value()) {
+        return NullableLogEventIdx{emscripten::val::null()};
+    }
+    // The map is sorted in ascending order.
+    auto const it{std::ranges::lower_bound(filtered_log_event_map.value(), log_event_idx)};
+    if (filtered_log_event_map->end() == it) {
+        return NullableLogEventIdx{emscripten::val::null()};
+    }
+    return NullableLogEventIdx{
+            emscripten::val(static_cast<size_t>(it - filtered_log_event_map->begin()))
+    };
+}
+
+auto StreamReader::create_text_query(
+        std::string const& query,
+        SearchOptionsTsType const& options
+) -> TextQuery {
+    return TextQuery{
+            query,
+            options[cSearchOptionsCaseSensitiveKey.data()].as<bool>(),
+            options[cSearchOptionsRegexKey.data()].as<bool>()
+    };
+}
+
+auto StreamReader::get_filter_log_levels(emscripten::val const& log_level_filter)
+        -> std::vector<std::underlying_type_t<LogLevel>> {
+    auto log_levels{emscripten::vecFromJSArray<std::underlying_type_t<LogLevel>>(log_level_filter)};
+    std::ranges::sort(log_levels);
+    auto const duplicates{std::ranges::unique(log_levels)};
+    log_levels.erase(duplicates.begin(), duplicates.end());
+    return log_levels;
+}
+
+auto StreamReader::get_log_level_filter_key(
+        std::span<std::underlying_type_t<LogLevel> const> log_levels
+) -> std::string {
+    std::string key{"levels:"};
+    for (auto const log_level : log_levels) {
+        key += std::format("{},", log_level);
+    }
+    return key;
+}
+
+auto StreamReader::create_log_level_filter(
+        std::vector<std::underlying_type_t<LogLevel>> log_levels,
+        LogLevelIndex const& log_level_index
+) -> FilterFunc {
+    return [&log_level_index, log_levels = std::move(log_levels)](
+                   size_t begin_idx,
+                   size_t end_idx,
+                   std::vector<size_t>& log_event_indices
+           ) {
+        log_level_index.append_log_event_indices(log_levels, begin_idx, end_idx, log_event_indices);
+    };
+}
+
+auto StreamReader::get_search_filter_key(
+        std::string const& query,
+        SearchOptionsTsType const& options
+) -> std::string {
+    auto const log_level_filter{options[cSearchOptionsLogLevelFilterKey.data()]};
+    auto const log_level_filter_key{
+            log_level_filter.isUndefined() || log_level_filter.isNull()
+                    ? std::string{}
+                    : get_log_level_filter_key(get_filter_log_levels(log_level_filter))
+    };
+    // The query is length-prefixed so that no query can produce the key of another filter (e.g.,
+    // one composed with this search).
+    return std::format(
+            "search:{:d}{:d}:{}:{}:{}",
+            options[cSearchOptionsCaseSensitiveKey.data()].as<bool>(),
+            options[cSearchOptionsRegexKey.data()].as<bool>(),
+            log_level_filter_key,
+            query.size(),
+            query
+    );
+}
+
+auto StreamReader::create_search_log_level_filter(
+        SearchOptionsTsType const& options,
+        LogLevelIndex const& log_level_index
+) -> FilterFunc {
+    auto const log_level_filter{options[cSearchOptionsLogLevelFilterKey.data()]};
+    if (log_level_filter.isUndefined() || log_level_filter.isNull()) {
+        return nullptr;
+    }
+    return create_log_level_filter(get_filter_log_levels(log_level_filter), log_level_index);
+}
+
+auto StreamReader::generic_get_log_level_counts(LogLevelIndex const& log_level_index)
+        -> LogLevelCountsTsType {
+    auto const counts{log_level_index.get_log_level_counts()};
+    return LogLevelCountsTsType{emscripten::val::array(counts.begin(), counts.end())};
+}
+
+auto StreamReader::generic_get_time_histogram(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        TimestampIndex const& timestamp_index,
+        clp::ir::epoch_time_ms_t begin_ts,
+        clp::ir::epoch_time_ms_t end_ts,
+        size_t num_buckets
+) -> TimeHistogramTsType {
+    auto const counts{timestamp_index.get_histogram(timestamps, begin_ts, end_ts, num_buckets)};
+    return TimeHistogramTsType{emscripten::val::array(counts.begin(), counts.end())};
+}
+
+auto StreamReader::generic_find_nearest_log_event_by_timestamp(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        TimestampIndex const& timestamp_index,
+        clp::ir::epoch_time_ms_t target_ts
+) -> NullableLogEventIdx {
+    auto const log_event_idx{timestamp_index.find_nearest_log_event(timestamps, target_ts)};
+    if (false == log_event_idx.has_value()) {
+        return NullableLogEventIdx{emscripten::val::null()};
+    }
+    return NullableLogEventIdx{emscripten::val(log_event_idx.value())};
+}
 }  // namespace clp_ffi_js::ir
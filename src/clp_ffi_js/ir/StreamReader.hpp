@@ -2,15 +2,21 @@
 #define CLP_FFI_JS_IR_STREAMREADER_HPP
 
 #include <algorithm>
+#include <chrono>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <format>
+#include <iterator>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <clp/ErrorCode.hpp>
 #include <clp/ir/types.hpp>
 #include <clp/streaming_compression/zstd/Decompressor.hpp>
 #include <clp/type_utils.hpp>
@@ -18,19 +24,44 @@
 #include <emscripten/val.h>
 #include <spdlog/spdlog.h>
 
+#include <clp_ffi_js/ClpFfiJsException.hpp>
 #include <clp_ffi_js/constants.hpp>
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/ChunkedReader.hpp>
+#include <clp_ffi_js/ir/ColumnarDecodeBuffers.hpp>
+#include <clp_ffi_js/ir/ExportBuffer.hpp>
+#include <clp_ffi_js/ir/FilterCache.hpp>
+#include <clp_ffi_js/ir/LogEventDiagnostics.hpp>
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+#include <clp_ffi_js/ir/LogLevelIndex.hpp>
+#include <clp_ffi_js/ir/memory_usage.hpp>
+#include <clp_ffi_js/ir/parallel_decode.hpp>
+#include <clp_ffi_js/ir/ReaderStats.hpp>
+#include <clp_ffi_js/ir/SeekableZstdInput.hpp>
+#include <clp_ffi_js/ir/TextQuery.hpp>
+#include <clp_ffi_js/ir/TimestampIndex.hpp>
 
 namespace clp_ffi_js::ir {
 // JS types used as inputs
 EMSCRIPTEN_DECLARE_VAL_TYPE(DataArrayTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(KeyPathsTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(LogLevelFilterTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(PredicateTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(ReaderOptions);
+EMSCRIPTEN_DECLARE_VAL_TYPE(SearchOptionsTsType);
 
 // JS types used as outputs
+EMSCRIPTEN_DECLARE_VAL_TYPE(DecodedColumnarResultsTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(DecodedResultsTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(DeserializationProgressTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(DiagnosticsTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(ExportChunkTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(FilteredLogEventMapTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(FilteredLogEventMapViewTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(LogLevelCountsTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(MemoryUsageTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(NullableLogEventIdx);
+EMSCRIPTEN_DECLARE_VAL_TYPE(StatsTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(TimeHistogramTsType);
 
 enum class StreamType : uint8_t {
     Structured,
@@ -38,7 +69,7 @@ enum class StreamType : uint8_t {
 };
 
 template <typename LogEvent>
-using LogEvents = std::vector<LogEventWithFilterData<LogEvent>>;
+using LogEvents = LogEventsWithFilterData<LogEvent>;
 
 /**
  * Mapping between an index in the filtered log events collection to an index in the unfiltered
@@ -46,6 +77,45 @@ using LogEvents = std::vector<LogEventWithFilterData<LogEvent>>;
  */
 using FilteredLogEventsMap = std::optional<std::vector<size_t>>;
 
+/**
+ * Limits on the amount of work done by a single call to `StreamReader::deserialize_next`.
+ */
+class DeserializationBudget {
+public:
+    // Constructor
+    /**
+     * @param max_num_events The maximum number of log events to deserialize, or 0 for no limit.
+     * @param max_duration_ms The maximum time to spend deserializing (in milliseconds), or 0 for
+     * no limit.
+     */
+    DeserializationBudget(size_t max_num_events, size_t max_duration_ms)
+            : m_max_num_events{max_num_events},
+              m_max_duration_ms{max_duration_ms},
+              m_begin_time{std::chrono::steady_clock::now()} {}
+
+    // Methods
+    /**
+     * @param num_events_deserialized The number of log events deserialized since the budget was
+     * created.
+     * @return Whether any of the limits has been reached.
+     */
+    [[nodiscard]] auto is_exhausted(size_t num_events_deserialized) const -> bool {
+        if (0 != m_max_num_events && num_events_deserialized >= m_max_num_events) {
+            return true;
+        }
+        if (0 == m_max_duration_ms) {
+            return false;
+        }
+        auto const elapsed{std::chrono::steady_clock::now() - m_begin_time};
+        return elapsed >= std::chrono::milliseconds{m_max_duration_ms};
+    }
+
+private:
+    size_t m_max_num_events;
+    size_t m_max_duration_ms;
+    std::chrono::steady_clock::time_point m_begin_time;
+};
+
 /**
  * Class to deserialize and decode Zstandard-compressed CLP IR streams as well as format decoded
  * log events.
@@ -67,6 +137,22 @@ public:
             ReaderOptions const& reader_options
     ) -> std::unique_ptr<StreamReader>;
 
+    /**
+     * Creates a `StreamReader` whose input is supplied incrementally through `push_chunk`, so that
+     * the full compressed stream never has to be resident in memory at once. The input must be
+     * marked as complete using `mark_input_complete` once all chunks have been pushed.
+     *
+     * @param first_chunk The first chunk of a Zstandard-compressed IR stream. It must contain at
+     * least the stream's encoding type and preamble.
+     * @param reader_options
+     * @return The created instance.
+     * @throw ClpFfiJsException if any error occurs.
+     */
+    [[nodiscard]] static auto create_chunked(
+            DataArrayTsType const& first_chunk,
+            ReaderOptions const& reader_options
+    ) -> std::unique_ptr<StreamReader>;
+
     // Destructor
     virtual ~StreamReader() = default;
 
@@ -82,6 +168,42 @@ public:
     // Methods
     [[nodiscard]] virtual auto get_ir_stream_type() const -> StreamType = 0;
 
+    /**
+     * Appends a chunk of the compressed stream to the reader's input. Log events in the chunk are
+     * deserialized by subsequent calls to `deserialize_next` or `deserialize_stream`.
+     *
+     * @param chunk
+     * @throw ClpFfiJsException if the input has already been marked as complete or the stream has
+     * already been exhausted.
+     */
+    auto push_chunk(DataArrayTsType const& chunk) -> void;
+
+    /**
+     * Marks that no more chunks will be pushed into the reader's input. Until the input is marked
+     * as complete, a truncated IR unit at the end of the input is treated as pending rather than
+     * as a truncated stream.
+     */
+    auto mark_input_complete() -> void;
+
+    /**
+     * Appends a chunk of the compressed stream to the reader's input and deserializes the log
+     * events that are available so far, e.g., to follow a stream that's still being written.
+     *
+     * The deserializer's state is kept between calls, so only the new log events are deserialized,
+     * and the log level and timestamp indices are updated incrementally. If the log events are
+     * filtered, the filter is applied to only the new log events, and those that pass are appended
+     * to the filtered log events map.
+     *
+     * NOTE: To follow a stream, the reader must be created with `create_chunked`, and the input
+     * must not be marked as complete.
+     *
+     * @param chunk
+     * @return The number of log events deserialized from the chunk (and any earlier pending input).
+     * @throw ClpFfiJsException if the chunk can't be pushed (see `push_chunk`) or an error occurs
+     * during deserialization.
+     */
+    auto append_data(DataArrayTsType const& chunk) -> size_t;
+
     /**
      * @return The number of events buffered.
      */
@@ -92,21 +214,205 @@ public:
      */
     [[nodiscard]] virtual auto get_filtered_log_event_map() const -> FilteredLogEventMapTsType = 0;
 
+    /**
+     * Same as `get_filtered_log_event_map`, except the map is returned as a typed-array view over
+     * wasm memory instead of being copied into a JS array.
+     *
+     * NOTE: The view is only valid until the map changes (see
+     * `get_filtered_log_event_map_generation`) or the wasm memory grows, so callers must check the
+     * generation before reusing it. With pthreads, it's a copy in a non-shared buffer instead (see
+     * `create_typed_array`), which doesn't go stale when the wasm memory grows.
+     *
+     * @return A `Uint32Array` view of the filtered log events map, or null if there's no filter.
+     */
+    [[nodiscard]] virtual auto get_filtered_log_event_map_view() const
+            -> FilteredLogEventMapViewTsType = 0;
+
+    /**
+     * @return A number that changes whenever the filtered log events map changes (e.g., when a
+     * filter is applied or extended with newly deserialized log events).
+     */
+    [[nodiscard]] virtual auto get_filtered_log_event_map_generation() const -> size_t = 0;
+
+    /**
+     * @param filtered_log_event_idx
+     * @return The index of the log event at `filtered_log_event_idx` in the filtered collection, or
+     * null if there's no filter or the index is out of bounds.
+     */
+    [[nodiscard]] virtual auto get_log_event_idx(size_t filtered_log_event_idx) const
+            -> NullableLogEventIdx = 0;
+
+    /**
+     * @param log_event_idx
+     * @return The index in the filtered collection of the first log event at or after
+     * `log_event_idx` that passes the filter, or null if there's no filter or no such log event.
+     * The returned index maps back to `log_event_idx` iff the log event passes the filter.
+     */
+    [[nodiscard]] virtual auto get_filtered_log_event_idx(size_t log_event_idx) const
+            -> NullableLogEventIdx = 0;
+
+    /**
+     * Estimates the heap memory held by the reader.
+     *
+     * @return An object containing the number of bytes held by:
+     * - The buffered log events
+     * - The schema tree (structured streams only)
+     * - The filtered log events map and the log level index
+     * - The compressed input that hasn't been freed yet
+     * - All of the above
+     */
+    [[nodiscard]] virtual auto get_memory_usage() const -> MemoryUsageTsType = 0;
+
+    /**
+     * Gets the counters and per-phase timings collected while reading the stream (see
+     * `ReaderStats`), so that slow reads can be attributed to a specific phase.
+     *
+     * @return An object containing:
+     * - `counters`: The number of decompressed bytes read, IR units of each type deserialized, log
+     *   events emitted by the deserializer, and times the log events buffer was grown.
+     * - `phaseMs`: The time spent in each `ReaderPhase`, in milliseconds.
+     * @return null if the library was built without `CLP_FFI_JS_ENABLE_STATS`.
+     */
+    [[nodiscard]] virtual auto get_stats() const -> StatsTsType = 0;
+
+    /**
+     * Gets the problems found in individual log events while deserializing the stream (see
+     * `LogEventDiagnostics`), which are aggregated instead of being logged for every log event.
+     *
+     * @return An object containing, for each kind of problem (see `cDiagnosticKindNames`), an
+     * object containing:
+     * - `count`: The number of log events with the problem.
+     * - `firstLogEventIndices`: The indices of the first log events with the problem (up to
+     *   `LogEventDiagnostics::cMaxNumSampledLogEventIndices`).
+     */
+    [[nodiscard]] virtual auto get_diagnostics() const -> DiagnosticsTsType = 0;
+
+    /**
+     * Releases any capacity reserved but unused by the buffered log events, the filtered log
+     * events map, and the log level and timestamp indices.
+     */
+    virtual auto shrink_to_fit() -> void = 0;
+
     /**
      * Generates a filtered collection from all log events.
      *
-     * @param log_level_filter Array of selected log levels
+     * The filter has three components that are set separately: a base filter, which is set by this
+     * method and `search_log_events`; a predicate, which is set by
+     * `filter_log_events_by_predicate`; and a time range, which is set by
+     * `filter_log_events_by_time_range`. The filtered collection contains the log events that pass
+     * all of them, so changing one component keeps the others.
+     *
+     * @param log_level_filter Array of selected log levels, or null to remove the base filter.
      */
     virtual void filter_log_events(LogLevelFilterTsType const& log_level_filter) = 0;
 
     /**
-     * Deserializes all log events in the stream.
+     * @return An array containing the number of log events buffered so far with each log level,
+     * indexed by the log level's integer value (see `cLogLevelNames`).
+     */
+    [[nodiscard]] virtual auto get_log_level_counts() const -> LogLevelCountsTsType = 0;
+
+    /**
+     * Sets the filter's time range (see `filter_log_events`) to `[begin_ts, end_ts)`, replacing
+     * any previous time range, and regenerates the filtered collection from the log events that
+     * pass the other components (if any) and have timestamps in the range.
+     *
+     * @param begin_ts
+     * @param end_ts
+     * @return The number of log events in the filtered collection.
+     */
+    virtual auto filter_log_events_by_time_range(
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts
+    ) -> size_t = 0;
+
+    /**
+     * Removes the filter's time range (see `filter_log_events`), and regenerates the filtered
+     * collection from the log events that pass the other components, if any.
+     */
+    virtual auto clear_time_range() -> void = 0;
+
+    /**
+     * Sets the filter's predicate (see `filter_log_events`), replacing any previous predicate, and
+     * regenerates the filtered collection from the log events that pass the other components (if
+     * any) and whose kv-pairs match the predicate.
+     *
+     * @param predicate A predicate in a subset of KQL (see `FieldPredicate`), or null to remove the
+     * predicate.
+     * @return The number of log events in the filtered collection.
+     * @throw ClpFfiJsException if the stream isn't structured, `predicate` is invalid, or a log
+     * event can't be deserialized again.
+     */
+    virtual auto filter_log_events_by_predicate(PredicateTsType const& predicate) -> size_t = 0;
+
+    /**
+     * Counts the buffered log events in each of `num_buckets` equal-width time buckets spanning
+     * the range `[begin_ts, end_ts)`, regardless of any filter.
+     *
+     * @param begin_ts
+     * @param end_ts
+     * @param num_buckets
+     * @return An array containing the number of log events in each bucket, in chronological order.
+     * @throw ClpFfiJsException if the range is empty or `num_buckets` is 0 or too large.
+     */
+    [[nodiscard]] virtual auto get_time_histogram(
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts,
+            size_t num_buckets
+    ) const -> TimeHistogramTsType = 0;
+
+    /**
+     * Sets the filter's base filter (see `filter_log_events`) to the log events whose message
+     * matches `query`, and regenerates the filtered collection.
+     *
+     * For unstructured streams, messages are matched without their formatted timestamp, and each
+     * distinct logtype is first matched on its own so that most messages don't need to be decoded.
+     * For structured streams, a log event matches if any of its string values (including encoded
+     * text values) matches; keys and other types of values aren't matched, and values are matched
+     * as they are rather than as escaped JSON strings.
+     *
+     * @param query A substring or, if `options.regex` is true, a regular expression in the dialect
+     * described by `TextQuery`.
+     * @param options An object containing:
+     * - `caseSensitive`: Whether matching is case-sensitive (case folding only covers ASCII).
+     * - `regex`: Whether `query` is a regular expression.
+     * - `logLevelFilter` (optional): If non-null, an array of log levels that matching log events
+     *   must also have.
+     * @return The number of log events in the filtered collection.
+     * @throw ClpFfiJsException if `query` is an invalid regular expression or a message can't be
+     * decoded.
+     */
+    [[nodiscard]] virtual auto
+    search_log_events(std::string const& query, SearchOptionsTsType const& options)
+            -> size_t = 0;
+
+    /**
+     * Deserializes all log events in the stream (or, for a reader whose input is still being
+     * supplied, all log events that are available so far).
      *
      * @return The number of successfully deserialized ("valid") log events.
      * @throw ClpFfiJsException if an error occurs during deserialization.
      */
     [[nodiscard]] virtual auto deserialize_stream() -> size_t = 0;
 
+    /**
+     * Deserializes log events from the stream until either the stream is exhausted or one of the
+     * given limits is reached. Log events deserialized so far can be filtered and decoded between
+     * calls.
+     *
+     * @param max_num_events The maximum number of log events to deserialize, or 0 for no limit.
+     * @param max_duration_ms The maximum time to spend deserializing (in milliseconds), or 0 for
+     * no limit.
+     * @return An object containing:
+     * - The number of log events buffered so far
+     * - The number of (decompressed) stream bytes deserialized so far
+     * - The number of compressed input bytes consumed so far
+     * - Whether the stream has been exhausted
+     * @throw ClpFfiJsException if an error occurs during deserialization.
+     */
+    [[nodiscard]] virtual auto deserialize_next(size_t max_num_events, size_t max_duration_ms)
+            -> DeserializationProgressTsType = 0;
+
     /**
      * Decodes log events in the range `[beginIdx, endIdx)` of the filtered or unfiltered
      * (depending on the value of `useFilter`) log events collection.
@@ -123,23 +429,92 @@ public:
      * of log events in the collection).
      * @throw ClpFfiJsException if a message cannot be decoded.
      */
-    [[nodiscard]] virtual auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
+    [[nodiscard]] virtual auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter)
             -> DecodedResultsTsType = 0;
 
     /**
-     * Finds the log event, L, where if we assume:
+     * Same as `decode_range`, except the log events are returned in a columnar layout, as
+     * typed-array views over wasm memory, so that JS can decode all messages with a single
+     * `TextDecoder` call.
+     *
+     * NOTE: The views are only valid until the next call to this method or until the wasm memory
+     * grows, so callers must consume (or copy) them immediately. With pthreads, they're copies in
+     * non-shared buffers instead (see `create_typed_array`).
+     *
+     * @param begin_idx
+     * @param end_idx
+     * @param use_filter Whether to decode from the filtered or unfiltered log events collection.
+     * @return See `ColumnarDecodeBuffers::create_views`.
+     * @return null if any log event in the range doesn't exist (e.g. the range exceeds the number
+     * of log events in the collection).
+     * @throw ClpFfiJsException if a message cannot be decoded.
+     */
+    [[nodiscard]] virtual auto
+    decode_range_columnar(size_t begin_idx, size_t end_idx, bool use_filter)
+            -> DecodedColumnarResultsTsType = 0;
+
+    /**
+     * Same as `decode_range`, except each log event's message only contains the values of the
+     * given keys, which avoids serializing the whole log event.
      *
-     * - the collection of log events is sorted in chronological order;
-     * - and we insert a marker log event, M, with timestamp `target_ts` into the collection (if log
+     * @param begin_idx
+     * @param end_idx
+     * @param use_filter Whether to decode from the filtered or unfiltered log events collection.
+     * @param key_paths The keys to project, each given as the path of keys from the root of the
+     * log event to the value.
+     * @return Same as `decode_range`, except each message is a JSON array containing the value of
+     * each key in `key_paths` in order, or null if the log event doesn't contain the key.
+     * @throw ClpFfiJsException if the stream isn't structured or a message cannot be decoded.
+     */
+    [[nodiscard]] virtual auto decode_range_projected(
+            size_t begin_idx,
+            size_t end_idx,
+            bool use_filter,
+            KeyPathsTsType const& key_paths
+    ) -> DecodedResultsTsType = 0;
+
+    /**
+     * Starts exporting the log events in the range `[beginIdx, endIdx)` of the filtered or
+     * unfiltered log events collection as text: one JSON object per line (NDJSON) for structured
+     * streams, or one message per line for unstructured streams. The output is retrieved in chunks
+     * using `export_next_chunk`.
+     *
+     * Any unfinished export is discarded.
+     *
+     * @param begin_idx
+     * @param end_idx
+     * @param use_filter Whether to export from the filtered or unfiltered log events collection.
+     * @return Whether the range is valid (see `decode_range`).
+     */
+    virtual auto begin_export(size_t begin_idx, size_t end_idx, bool use_filter) -> bool = 0;
+
+    /**
+     * Decodes the next chunk of the export started by `begin_export`. Each chunk holds whole lines
+     * and at most `ExportBuffer::cChunkSize` bytes, unless it's a single line that's longer.
+     *
+     * NOTE: The chunk is only valid until the next call to this method or until the wasm memory
+     * grows, so callers must consume (or copy) it immediately. With pthreads, it's a copy in a
+     * non-shared buffer instead (see `create_typed_array`).
+     *
+     * @return A `Uint8Array` view of the UTF-8 encoded chunk, or null if the export is complete (or
+     * no export was started).
+     * @throw ClpFfiJsException if the filtered log events map changed while exporting from it, or
+     * a message can't be decoded.
+     */
+    [[nodiscard]] virtual auto export_next_chunk() -> ExportChunkTsType = 0;
+
+    /**
+     * Finds the log event, L, where if we:
+     *
+     * - consider the collection of log events in chronological order (log events with equal
+     *   timestamps stay in stream order);
+     * - and insert a marker log event, M, with timestamp `target_ts` into the collection (if log
      *   events with timestamp `target_ts` already exist in the collection, M should be inserted
      *   after them).
      *
      * L is the event just before M, if M is not the first event in the collection; otherwise L is
      * the event just after M.
      *
-     * NOTE: If the collection of log events isn't in chronological order, this method has undefined
-     * behaviour.
-     *
      * @param target_ts
      * @return The index of the log event L.
      */
@@ -147,15 +522,216 @@ public:
             clp::ir::epoch_time_ms_t target_ts
     ) -> NullableLogEventIdx = 0;
 
+    /**
+     * Exports the reader's index as a compact binary blob that can be stored (e.g., in IndexedDB)
+     * and later imported, using `import_index`, into a new reader over the same input to skip
+     * deserializing the stream again.
+     *
+     * @return The blob.
+     * @throw ClpFfiJsException if the reader doesn't support exporting its index, or the stream
+     * hasn't been fully deserialized yet.
+     */
+    [[nodiscard]] auto export_index() const -> DataArrayTsType;
+
+    /**
+     * Restores the reader's index from a blob exported by `export_index`, after which the stream is
+     * treated as fully deserialized.
+     *
+     * Only lazy structured IR stream readers over a seekable input (see `StructuredIrStreamReader`)
+     * support indices, since only they can decode log events without deserializing the stream.
+     *
+     * @param index
+     * @return Whether the index was imported, which fails if the blob is malformed, was exported by
+     * an incompatible version, or belongs to a different input.
+     * @throw ClpFfiJsException if the reader doesn't support importing an index, deserialization
+     * has already started, or the imported index can't be applied (in which case the reader must
+     * no longer be used).
+     */
+    auto import_index(DataArrayTsType const& index) -> bool;
+
+    // Methods for native consumers that combine multiple readers (see `MergedStreamReader`)
+    /**
+     * @return The timestamp of each log event buffered so far.
+     */
+    [[nodiscard]] virtual auto get_timestamps() const
+            -> std::span<clp::ir::epoch_time_ms_t const> = 0;
+
+    /**
+     * @return The log level of each log event buffered so far.
+     */
+    [[nodiscard]] virtual auto get_log_levels() const -> std::span<LogLevel const> = 0;
+
+    /**
+     * @return The index of the log events buffered so far by timestamp.
+     */
+    [[nodiscard]] virtual auto get_timestamp_index() const -> TimestampIndex const& = 0;
+
+    /**
+     * @return The index of the log events buffered so far by log level.
+     */
+    [[nodiscard]] virtual auto get_log_level_index() const -> LogLevelIndex const& = 0;
+
+    /**
+     * Decodes the messages of the given log events, in the same format as `decode_range`.
+     *
+     * @param log_event_indices Indices of the log events in the unfiltered collection, in any
+     * order.
+     * @return The decoded messages, in the same order as `log_event_indices`.
+     * @throw ClpFfiJsException if any index is out of bounds or a message cannot be decoded.
+     */
+    [[nodiscard]] virtual auto decode_log_events(std::span<size_t const> log_event_indices)
+            -> std::vector<std::string> = 0;
+
+    // Helpers for the filtered log events map that are shared with `MergedStreamReader`
+    /**
+     * @param filtered_log_event_map
+     * @return See `get_filtered_log_event_map_view`.
+     */
+    [[nodiscard]] static auto
+    create_filtered_log_event_map_view(FilteredLogEventsMap const& filtered_log_event_map)
+            -> FilteredLogEventMapViewTsType;
+
+    /**
+     * Generic implementation of `get_log_event_idx`.
+     *
+     * @param filtered_log_event_map
+     * @param filtered_log_event_idx
+     * @return See `get_log_event_idx`.
+     */
+    [[nodiscard]] static auto generic_get_log_event_idx(
+            FilteredLogEventsMap const& filtered_log_event_map,
+            size_t filtered_log_event_idx
+    ) -> NullableLogEventIdx;
+
+    /**
+     * Generic implementation of `get_filtered_log_event_idx`.
+     *
+     * @param filtered_log_event_map
+     * @param log_event_idx
+     * @return See `get_filtered_log_event_idx`.
+     */
+    [[nodiscard]] static auto generic_get_filtered_log_event_idx(
+            FilteredLogEventsMap const& filtered_log_event_map,
+            size_t log_event_idx
+    ) -> NullableLogEventIdx;
+
 protected:
     explicit StreamReader() = default;
 
     /**
-     * Templated implementation of `decode_range` that uses `log_event_to_string` to convert
-     * `log_event` to a string for the returned result.
+     * @return See `export_index`.
+     * @throw ClpFfiJsException See `export_index`.
+     */
+    [[nodiscard]] virtual auto export_index_blob() const -> std::vector<char> = 0;
+
+    /**
+     * @param blob
+     * @return See `import_index`.
+     * @throw ClpFfiJsException See `import_index`.
+     */
+    virtual auto import_index_blob(std::span<char const> blob) -> bool = 0;
+
+    /**
+     * @return The reader holding the compressed input, or nullptr if the stream has been exhausted
+     * and the input has been released.
+     */
+    [[nodiscard]] virtual auto get_input_reader() -> ChunkedReader* = 0;
+
+    /**
+     * @param num_events_buffered
+     * @param num_bytes_deserialized
+     * @param num_compressed_bytes_consumed
+     * @param is_stream_completed
+     * @return See `deserialize_next`.
+     */
+    [[nodiscard]] static auto create_deserialization_progress(
+            size_t num_events_buffered,
+            size_t num_bytes_deserialized,
+            size_t num_compressed_bytes_consumed,
+            bool is_stream_completed
+    ) -> DeserializationProgressTsType;
+
+    /**
+     * Validates that every index in `log_event_indices` refers to a log event.
+     *
+     * @param log_event_indices
+     * @param num_log_events
+     * @throw ClpFfiJsException if any index is out of bounds.
+     */
+    static auto
+    validate_log_event_indices(std::span<size_t const> log_event_indices, size_t num_log_events)
+            -> void;
+
+    /**
+     * Estimates the capacity to reserve for the log events collection once it's full, by
+     * extrapolating the number of log events deserialized so far to the size of the whole input.
      *
+     * @param num_log_events The number of log events deserialized so far.
+     * @param input_reader
+     * @return The capacity to reserve, which is always greater than `num_log_events`.
+     */
+    [[nodiscard]] static auto estimate_log_events_capacity(
+            size_t num_log_events,
+            ChunkedReader& input_reader
+    ) -> size_t;
+
+    /**
+     * @param log_events_size
+     * @param schema_tree_size
+     * @param filtered_log_event_map_size
+     * @param compressed_input_size
+     * @return See `get_memory_usage`.
+     */
+    [[nodiscard]] static auto create_memory_usage(
+            size_t log_events_size,
+            size_t schema_tree_size,
+            size_t filtered_log_event_map_size,
+            size_t compressed_input_size
+    ) -> MemoryUsageTsType;
+
+    /**
+     * @param stats
+     * @return See `get_stats`.
+     */
+    [[nodiscard]] static auto create_stats(ReaderStats const& stats) -> StatsTsType;
+
+    /**
+     * @param diagnostics
+     * @return See `get_diagnostics`.
+     */
+    [[nodiscard]] static auto create_diagnostics(LogEventDiagnostics const& diagnostics)
+            -> DiagnosticsTsType;
+
+    /**
      * @tparam LogEvent
-     * @tparam ToStringFunc Function to convert a log event into a string.
+     * @param log_events
+     * @return The number of bytes held by `log_events`, including the memory its elements
+     * allocate on the heap.
+     */
+    template <typename LogEvent>
+    [[nodiscard]] static auto get_log_events_size(LogEvents<LogEvent> const& log_events)
+            -> size_t;
+
+    /**
+     * @param filtered_log_event_map
+     * @return The number of bytes held by `filtered_log_event_map`.
+     */
+    [[nodiscard]] static auto get_filtered_log_event_map_size(
+            FilteredLogEventsMap const& filtered_log_event_map
+    ) -> size_t {
+        if (false == filtered_log_event_map.has_value()) {
+            return 0;
+        }
+        return filtered_log_event_map->capacity() * sizeof(size_t);
+    }
+
+    /**
+     * Templated implementation of `decode_range` that uses `log_event_to_string` to convert each
+     * log event to a string for the returned result.
+     *
+     * @tparam LogEvent
+     * @tparam ToStringFunc Function to convert the log event at the given index (in the unfiltered
+     * collection) into a string.
      * @param begin_idx
      * @param end_idx
      * @param filtered_log_event_map
@@ -166,9 +742,9 @@ protected:
      * @throws Propagates `ToStringFunc`'s exceptions.
      */
     template <typename LogEvent, typename ToStringFunc>
-    requires requires(ToStringFunc func, LogEvent const& log_event) {
+    requires requires(ToStringFunc func, size_t log_event_idx) {
         {
-            func(log_event)
+            func(log_event_idx)
         } -> std::convertible_to<std::string>;
     }
     static auto generic_decode_range(
@@ -181,40 +757,400 @@ protected:
     ) -> DecodedResultsTsType;
 
     /**
-     * Templated implementation of `filter_log_events`.
+     * Templated implementation of `decode_range_columnar` that uses `log_event_to_string` to
+     * convert each log event to a string for the returned result.
      *
      * @tparam LogEvent
-     * @param log_level_filter
-     * @param log_events Derived class's log events.
+     * @tparam ToStringFunc Function to convert the log event at the given index (in the unfiltered
+     * collection) into a string.
+     * @param begin_idx
+     * @param end_idx
+     * @param filtered_log_event_map
      * @param log_events
+     * @param log_event_to_string
+     * @param use_filter
+     * @param[out] buffers Returns the decoded log events.
+     * @return See `decode_range_columnar`.
+     * @throws Propagates `ToStringFunc`'s exceptions.
+     */
+    template <typename LogEvent, typename ToStringFunc>
+    requires requires(ToStringFunc func, size_t log_event_idx) {
+        {
+            func(log_event_idx)
+        } -> std::convertible_to<std::string>;
+    }
+    static auto generic_decode_range_columnar(
+            size_t begin_idx,
+            size_t end_idx,
+            FilteredLogEventsMap const& filtered_log_event_map,
+            LogEvents<LogEvent> const& log_events,
+            ToStringFunc log_event_to_string,
+            bool use_filter,
+            ColumnarDecodeBuffers& buffers
+    ) -> DecodedColumnarResultsTsType;
+
+    /**
+     * Generic implementation of `begin_export`.
+     *
+     * @param begin_idx
+     * @param end_idx
+     * @param use_filter
+     * @param filtered_log_event_map
+     * @param filtered_log_event_map_generation
+     * @param num_log_events
+     * @param[out] buffer Returns the started export.
+     * @return See `begin_export`.
+     */
+    static auto generic_begin_export(
+            size_t begin_idx,
+            size_t end_idx,
+            bool use_filter,
+            FilteredLogEventsMap const& filtered_log_event_map,
+            size_t filtered_log_event_map_generation,
+            size_t num_log_events,
+            ExportBuffer& buffer
+    ) -> bool;
+
+    /**
+     * Templated implementation of `export_next_chunk`.
+     *
+     * @tparam LoadFunc Function to prepare the log events in the range `[begin_idx, end_idx)` of
+     * the filtered or unfiltered collection for decoding.
+     * @tparam ToStringFunc Function to convert the log event at the given index (in the unfiltered
+     * collection) into a string.
+     * @param filtered_log_event_map
+     * @param filtered_log_event_map_generation
+     * @param load_log_events
+     * @param log_event_to_string
+     * @param[in,out] buffer The export to continue.
+     * @return See `export_next_chunk`.
+     * @throw ClpFfiJsException if the filtered log events map changed while exporting from it.
+     * @throws Propagates `LoadFunc`'s and `ToStringFunc`'s exceptions.
+     */
+    template <typename LoadFunc, typename ToStringFunc>
+    requires requires(
+            LoadFunc load,
+            ToStringFunc func,
+            size_t begin_idx,
+            size_t end_idx,
+            bool use_filter
+    ) {
+        load(begin_idx, end_idx, use_filter);
+        {
+            func(begin_idx)
+        } -> std::convertible_to<std::string>;
+    }
+    static auto generic_export_next_chunk(
+            FilteredLogEventsMap const& filtered_log_event_map,
+            size_t filtered_log_event_map_generation,
+            LoadFunc load_log_events,
+            ToStringFunc log_event_to_string,
+            ExportBuffer& buffer
+    ) -> ExportChunkTsType;
+
+    /**
+     * Templated implementation of `filter_log_events`.
+     *
+     * @tparam LogEvent
+     * @param[in,out] filter_cache Derived class's filter cache.
      * @param[out] filtered_log_event_map Returns the filtered log events.
+     * @param log_level_filter
+     * @param log_events Derived class's log events (only used for their count and timestamps).
+     * @param log_level_index Derived class's log level index.
+     * @param timestamp_index Derived class's timestamp index.
      */
     template <typename LogEvent>
     static auto generic_filter_log_events(
+            FilterCache& filter_cache,
             FilteredLogEventsMap& filtered_log_event_map,
             LogLevelFilterTsType const& log_level_filter,
-            LogEvents<LogEvent> const& log_events
+            LogEvents<LogEvent> const& log_events,
+            LogLevelIndex const& log_level_index,
+            TimestampIndex const& timestamp_index
     ) -> void;
 
     /**
-     * Templated implementation of `find_nearest_log_event_by_timestamp`.
+     * Templated implementation of `search_log_events`.
      *
      * @tparam LogEvent
-     * @param log_events
-     * @param target_ts
-     * @return See `find_nearest_log_event_by_timestamp`.
+     * @tparam MatchFunc Function to determine whether the log event at the given index matches a
+     * `TextQuery`. Since it's reused for log events deserialized later, it must remain valid for
+     * the reader's lifetime.
+     * @param[in,out] filter_cache Derived class's filter cache.
+     * @param[out] filtered_log_event_map Returns the matching log events.
+     * @param query
+     * @param options
+     * @param log_events Derived class's log events (only used for their count and timestamps).
+     * @param log_level_index Derived class's log level index.
+     * @param timestamp_index Derived class's timestamp index.
+     * @param matches
+     * @return See `search_log_events`.
+     * @throws Propagates `MatchFunc`'s exceptions.
+     */
+    template <typename LogEvent, typename MatchFunc>
+    requires requires(MatchFunc func, size_t log_event_idx, TextQuery const& text_query) {
+        {
+            func(log_event_idx, text_query)
+        } -> std::convertible_to<bool>;
+    }
+    static auto generic_search_log_events(
+            FilterCache& filter_cache,
+            FilteredLogEventsMap& filtered_log_event_map,
+            std::string const& query,
+            SearchOptionsTsType const& options,
+            LogEvents<LogEvent> const& log_events,
+            LogLevelIndex const& log_level_index,
+            TimestampIndex const& timestamp_index,
+            MatchFunc matches
+    ) -> size_t;
+
+    /**
+     * Generic implementation of `get_log_level_counts`.
+     *
+     * @param log_level_index Derived class's log level index.
+     * @return See `get_log_level_counts`.
+     */
+    [[nodiscard]] static auto generic_get_log_level_counts(LogLevelIndex const& log_level_index)
+            -> LogLevelCountsTsType;
+
+    /**
+     * Templated implementation of `filter_log_events_by_time_range`.
+     *
+     * @tparam LogEvent
+     * @param[in,out] filter_cache Derived class's filter cache.
+     * @param[out] filtered_log_event_map Returns the filtered log events.
+     * @param log_events Derived class's log events (only used for their count and timestamps).
+     * @param timestamp_index Derived class's timestamp index.
+     * @param time_range The range `[begin_ts, end_ts)`, or std::nullopt to remove the time range.
+     * @return See `filter_log_events_by_time_range`.
+     */
+    template <typename LogEvent>
+    static auto generic_filter_log_events_by_time_range(
+            FilterCache& filter_cache,
+            FilteredLogEventsMap& filtered_log_event_map,
+            LogEvents<LogEvent> const& log_events,
+            TimestampIndex const& timestamp_index,
+            std::optional<FilterCache::TimeRange> time_range
+    ) -> size_t;
+
+    /**
+     * Makes the filter composed of `filter_cache`'s base filter, predicate, and time range the
+     * active filter, evaluating whichever results aren't cached.
+     *
+     * @tparam LogEvent
+     * @param[in,out] filter_cache Derived class's filter cache.
+     * @param[out] filtered_log_event_map Returns the filtered log events, or an empty map if
+     * there are no components.
+     * @param log_events Derived class's log events (only used for their count and timestamps).
+     * @param timestamp_index Derived class's timestamp index.
      */
     template <typename LogEvent>
-    auto generic_find_nearest_log_event_by_timestamp(
+    static auto apply_filter_components(
+            FilterCache& filter_cache,
+            FilteredLogEventsMap& filtered_log_event_map,
             LogEvents<LogEvent> const& log_events,
+            TimestampIndex const& timestamp_index
+    ) -> void;
+
+    /**
+     * Generic implementation of `get_time_histogram`.
+     *
+     * @param timestamps Derived class's timestamp column.
+     * @param timestamp_index Derived class's timestamp index.
+     * @param begin_ts
+     * @param end_ts
+     * @param num_buckets
+     * @return See `get_time_histogram`.
+     * @throw ClpFfiJsException if the range is empty or `num_buckets` is 0 or too large.
+     */
+    [[nodiscard]] static auto generic_get_time_histogram(
+            std::span<clp::ir::epoch_time_ms_t const> timestamps,
+            TimestampIndex const& timestamp_index,
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts,
+            size_t num_buckets
+    ) -> TimeHistogramTsType;
+
+    /**
+     * Generic implementation of `find_nearest_log_event_by_timestamp`.
+     *
+     * @param timestamps Derived class's timestamp column.
+     * @param timestamp_index Derived class's timestamp index.
+     * @param target_ts
+     * @return See `find_nearest_log_event_by_timestamp`.
+     */
+    [[nodiscard]] static auto generic_find_nearest_log_event_by_timestamp(
+            std::span<clp::ir::epoch_time_ms_t const> timestamps,
+            TimestampIndex const& timestamp_index,
             clp::ir::epoch_time_ms_t target_ts
     ) -> NullableLogEventIdx;
+
+private:
+    /**
+     * @param query
+     * @param options See `search_log_events`.
+     * @return The `TextQuery` described by `query` and `options`.
+     * @throw ClpFfiJsException if `query` is an invalid regular expression.
+     */
+    [[nodiscard]] static auto
+    create_text_query(std::string const& query, SearchOptionsTsType const& options) -> TextQuery;
+
+    /**
+     * @param log_level_filter A non-null array of log levels.
+     * @return The log levels in `log_level_filter`, sorted and deduplicated so that equivalent
+     * filters have the same key in a `FilterCache`.
+     */
+    [[nodiscard]] static auto get_filter_log_levels(emscripten::val const& log_level_filter)
+            -> std::vector<std::underlying_type_t<LogLevel>>;
+
+    /**
+     * @param log_levels
+     * @return The key of a filter that passes log events with any of `log_levels`.
+     */
+    [[nodiscard]] static auto
+    get_log_level_filter_key(std::span<std::underlying_type_t<LogLevel> const> log_levels)
+            -> std::string;
+
+    /**
+     * @param log_levels
+     * @param log_level_index
+     * @return A filter that passes log events with any of `log_levels`.
+     */
+    [[nodiscard]] static auto create_log_level_filter(
+            std::vector<std::underlying_type_t<LogLevel>> log_levels,
+            LogLevelIndex const& log_level_index
+    ) -> FilterFunc;
+
+    /**
+     * @param query
+     * @param options See `search_log_events`.
+     * @return The key of the search described by `query` and `options`.
+     */
+    [[nodiscard]] static auto
+    get_search_filter_key(std::string const& query, SearchOptionsTsType const& options)
+            -> std::string;
+
+    /**
+     * @param options See `search_log_events`.
+     * @param log_level_index
+     * @return A filter for the log level filter in `options`, or an empty filter if it has none.
+     */
+    [[nodiscard]] static auto create_search_log_level_filter(
+            SearchOptionsTsType const& options,
+            LogLevelIndex const& log_level_index
+    ) -> FilterFunc;
+
+    /**
+     * Validates that the range `[begin_idx, end_idx)` exists in the filtered or unfiltered log
+     * events collection.
+     *
+     * @param begin_idx
+     * @param end_idx
+     * @param filtered_log_event_map
+     * @param num_log_events
+     * @param use_filter
+     * @return Whether the range is valid.
+     */
+    [[nodiscard]] static auto is_valid_decode_range(
+            size_t begin_idx,
+            size_t end_idx,
+            FilteredLogEventsMap const& filtered_log_event_map,
+            size_t num_log_events,
+            bool use_filter
+    ) -> bool {
+        if (use_filter && false == filtered_log_event_map.has_value()) {
+            return false;
+        }
+
+        size_t length{0};
+        if (use_filter) {
+            length = filtered_log_event_map->size();
+        } else {
+            length = num_log_events;
+        }
+        if (length < end_idx || begin_idx > end_idx) {
+            SPDLOG_ERROR("Invalid log event index range: {}-{}", begin_idx, end_idx);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Decodes each log event in the range `[begin_idx, end_idx)` of the filtered or unfiltered log
+     * events collection, and passes it to `consume` in order.
+     *
+     * When pthreads are enabled, the log events are decoded in parallel before any of them are
+     * consumed; `consume` is always called from the calling thread, so it may touch JS values.
+     *
+     * NOTE: The range must've been validated using `is_valid_decode_range`.
+     *
+     * @tparam ToStringFunc
+     * @tparam ConsumeFunc
+     * @param begin_idx
+     * @param end_idx
+     * @param filtered_log_event_map
+     * @param log_event_to_string
+     * @param use_filter
+     * @param consume Function that takes the log event's index in the unfiltered collection and
+     * the decoded string.
+     * @throws Propagates `ToStringFunc`'s exceptions.
+     */
+    template <typename ToStringFunc, typename ConsumeFunc>
+    static auto for_each_decoded_log_event(
+            size_t begin_idx,
+            size_t end_idx,
+            FilteredLogEventsMap const& filtered_log_event_map,
+            ToStringFunc const& log_event_to_string,
+            bool use_filter,
+            ConsumeFunc consume
+    ) -> void;
+
+    /**
+     * `for_each_decoded_log_event` specialized for the filtered or unfiltered log events
+     * collection, so that the choice of collection is made once rather than per log event.
+     *
+     * NOTE: The range must've been validated using `is_valid_decode_range`, so log event indices
+     * are looked up without bounds checks.
+     *
+     * @tparam cUseFilter Whether the range is in the filtered or unfiltered collection.
+     * @tparam ToStringFunc
+     * @tparam ConsumeFunc
+     * @param begin_idx
+     * @param end_idx
+     * @param filtered_log_event_map
+     * @param log_event_to_string
+     * @param consume
+     * @throws Propagates `ToStringFunc`'s exceptions.
+     */
+    template <bool cUseFilter, typename ToStringFunc, typename ConsumeFunc>
+    static auto for_each_decoded_log_event_in_collection(
+            size_t begin_idx,
+            size_t end_idx,
+            FilteredLogEventsMap const& filtered_log_event_map,
+            ToStringFunc const& log_event_to_string,
+            ConsumeFunc consume
+    ) -> void;
+
+    /**
+     * Creates a `StreamReader` that reads from the given input.
+     *
+     * @param input_reader
+     * @param reader_options
+     * @param seekable_input The same input, if it's complete and seekable, or nullptr.
+     * @return The created instance.
+     * @throw ClpFfiJsException if any error occurs.
+     */
+    [[nodiscard]] static auto create_from_input_reader(
+            std::unique_ptr<ChunkedReader>&& input_reader,
+            ReaderOptions const& reader_options,
+            std::unique_ptr<SeekableZstdInput>&& seekable_input
+    ) -> std::unique_ptr<StreamReader>;
 };
 
 template <typename LogEvent, typename ToStringFunc>
-requires requires(ToStringFunc func, LogEvent const& log_event) {
+requires requires(ToStringFunc func, size_t log_event_idx) {
     {
-        func(log_event)
+        func(log_event_idx)
     } -> std::convertible_to<std::string>;
 }
 auto StreamReader::generic_decode_range(
@@ -225,103 +1161,380 @@ auto StreamReader::generic_decode_range(
         ToStringFunc log_event_to_string,
         bool use_filter
 ) -> DecodedResultsTsType {
-    if (use_filter && false == filtered_log_event_map.has_value()) {
+    if (false
+        == is_valid_decode_range(
+                begin_idx,
+                end_idx,
+                filtered_log_event_map,
+                log_events.size(),
+                use_filter
+        ))
+    {
         return DecodedResultsTsType{emscripten::val::null()};
     }
 
-    size_t length{0};
-    if (use_filter) {
-        length = filtered_log_event_map->size();
-    } else {
-        length = log_events.size();
+    // The range has been validated, so the columns are indexed without bounds checks.
+    auto const timestamps{log_events.get_timestamps()};
+    auto const log_levels{log_events.get_log_levels()};
+    auto const results{emscripten::val::array()};
+    for_each_decoded_log_event(
+            begin_idx,
+            end_idx,
+            filtered_log_event_map,
+            log_event_to_string,
+            use_filter,
+            [&](size_t log_event_idx, std::string const& message) {
+                EM_ASM(
+                        { Emval.toValue($0).push([UTF8ToString($1), $2, $3, $4]); },
+                        results.as_handle(),
+                        message.c_str(),
+                        timestamps[log_event_idx],
+                        log_levels[log_event_idx],
+                        log_event_idx + 1
+                );
+            }
+    );
+
+    return DecodedResultsTsType(results);
+}
+
+template <typename LogEvent, typename ToStringFunc>
+requires requires(ToStringFunc func, size_t log_event_idx) {
+    {
+        func(log_event_idx)
+    } -> std::convertible_to<std::string>;
+}
+auto StreamReader::generic_decode_range_columnar(
+        size_t begin_idx,
+        size_t end_idx,
+        FilteredLogEventsMap const& filtered_log_event_map,
+        LogEvents<LogEvent> const& log_events,
+        ToStringFunc log_event_to_string,
+        bool use_filter,
+        ColumnarDecodeBuffers& buffers
+) -> DecodedColumnarResultsTsType {
+    if (false
+        == is_valid_decode_range(
+                begin_idx,
+                end_idx,
+                filtered_log_event_map,
+                log_events.size(),
+                use_filter
+        ))
+    {
+        return DecodedColumnarResultsTsType{emscripten::val::null()};
     }
-    if (length < end_idx || begin_idx > end_idx) {
-        SPDLOG_ERROR("Invalid log event index range: {}-{}", begin_idx, end_idx);
-        return DecodedResultsTsType{emscripten::val::null()};
+
+    // The range has been validated, so the columns are indexed without bounds checks.
+    auto const timestamps{log_events.get_timestamps()};
+    auto const log_levels{log_events.get_log_levels()};
+    buffers.reset(end_idx - begin_idx);
+    for_each_decoded_log_event(
+            begin_idx,
+            end_idx,
+            filtered_log_event_map,
+            log_event_to_string,
+            use_filter,
+            [&](size_t log_event_idx, std::string const& message) {
+                buffers.append(
+                        message,
+                        timestamps[log_event_idx],
+                        log_levels[log_event_idx],
+                        log_event_idx + 1
+                );
+            }
+    );
+
+    return DecodedColumnarResultsTsType{buffers.create_views()};
+}
+
+template <typename LoadFunc, typename ToStringFunc>
+requires requires(
+        LoadFunc load,
+        ToStringFunc func,
+        size_t begin_idx,
+        size_t end_idx,
+        bool use_filter
+) {
+    load(begin_idx, end_idx, use_filter);
+    {
+        func(begin_idx)
+    } -> std::convertible_to<std::string>;
+}
+auto StreamReader::generic_export_next_chunk(
+        FilteredLogEventsMap const& filtered_log_event_map,
+        size_t filtered_log_event_map_generation,
+        LoadFunc load_log_events,
+        ToStringFunc log_event_to_string,
+        ExportBuffer& buffer
+) -> ExportChunkTsType {
+    if (false == buffer.has_next_log_event()) {
+        buffer.release();
+        return ExportChunkTsType{emscripten::val::null()};
+    }
+    auto const use_filter{buffer.get_use_filter()};
+    if (use_filter
+        && filtered_log_event_map_generation != buffer.get_filtered_log_event_map_generation())
+    {
+        buffer.release();
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                "The filtered log events changed during the export."
+        };
     }
 
-    auto const results{emscripten::val::array()};
+    buffer.begin_chunk();
+    while (buffer.has_next_log_event() && false == buffer.is_chunk_full()) {
+        auto const [begin_idx, end_idx]{buffer.take_next_batch()};
+        load_log_events(begin_idx, end_idx, use_filter);
+        for_each_decoded_log_event(
+                begin_idx,
+                end_idx,
+                filtered_log_event_map,
+                log_event_to_string,
+                use_filter,
+                [&](size_t, std::string const& decoded_log_event) {
+                    buffer.append_line(decoded_log_event);
+                }
+        );
+    }
+    return ExportChunkTsType{buffer.create_view()};
+}
 
-    for (size_t i = begin_idx; i < end_idx; ++i) {
-        size_t log_event_idx{0};
-        if (use_filter) {
-            log_event_idx = filtered_log_event_map->at(i);
+template <typename ToStringFunc, typename ConsumeFunc>
+auto StreamReader::for_each_decoded_log_event(
+        size_t begin_idx,
+        size_t end_idx,
+        FilteredLogEventsMap const& filtered_log_event_map,
+        ToStringFunc const& log_event_to_string,
+        bool use_filter,
+        ConsumeFunc consume
+) -> void {
+    if (use_filter) {
+        for_each_decoded_log_event_in_collection<true>(
+                begin_idx,
+                end_idx,
+                filtered_log_event_map,
+                log_event_to_string,
+                std::move(consume)
+        );
+    } else {
+        for_each_decoded_log_event_in_collection<false>(
+                begin_idx,
+                end_idx,
+                filtered_log_event_map,
+                log_event_to_string,
+                std::move(consume)
+        );
+    }
+}
+
+template <bool cUseFilter, typename ToStringFunc, typename ConsumeFunc>
+auto StreamReader::for_each_decoded_log_event_in_collection(
+        size_t begin_idx,
+        size_t end_idx,
+        FilteredLogEventsMap const& filtered_log_event_map,
+        ToStringFunc const& log_event_to_string,
+        ConsumeFunc consume
+) -> void {
+    std::span<size_t const> filtered_log_event_indices;
+    if constexpr (cUseFilter) {
+        filtered_log_event_indices = filtered_log_event_map.value();
+    }
+    auto get_log_event_idx = [filtered_log_event_indices](size_t i) -> size_t {
+        if constexpr (cUseFilter) {
+            return filtered_log_event_indices[i];
         } else {
-            log_event_idx = i;
+            return i;
         }
+    };
 
-        auto const& log_event_with_filter_data{log_events.at(log_event_idx)};
-        auto const& log_event = log_event_with_filter_data.get_log_event();
-        auto const& timestamp = log_event_with_filter_data.get_timestamp();
-        auto const& log_level = log_event_with_filter_data.get_log_level();
-
-        EM_ASM(
-                { Emval.toValue($0).push([UTF8ToString($1), $2, $3, $4]); },
-                results.as_handle(),
-                log_event_to_string(log_event).c_str(),
-                timestamp,
-                log_level,
-                log_event_idx + 1
-        );
+#if CLP_FFI_JS_ENABLE_PTHREADS
+    auto const messages{parallel_decode(end_idx - begin_idx, [&](size_t i) -> std::string {
+        return log_event_to_string(get_log_event_idx(begin_idx + i));
+    })};
+    for (size_t i = begin_idx; i < end_idx; ++i) {
+        consume(get_log_event_idx(i), messages[i - begin_idx]);
     }
+#else
+    for (size_t i = begin_idx; i < end_idx; ++i) {
+        auto const log_event_idx{get_log_event_idx(i)};
+        consume(log_event_idx, log_event_to_string(log_event_idx));
+    }
+#endif
+}
 
-    return DecodedResultsTsType(results);
+template <typename LogEvent>
+auto StreamReader::get_log_events_size(LogEvents<LogEvent> const& log_events) -> size_t {
+    auto const& log_events_column{log_events.get_log_events()};
+    auto size{
+            log_events_column.capacity() * sizeof(LogEvent)
+            + log_events.get_filter_data_heap_size()
+    };
+    for (auto const& log_event : log_events_column) {
+        size += get_heap_size(log_event);
+    }
+    return size;
+}
+
+template <typename LogEvent, typename MatchFunc>
+requires requires(MatchFunc func, size_t log_event_idx, TextQuery const& text_query) {
+    {
+        func(log_event_idx, text_query)
+    } -> std::convertible_to<bool>;
+}
+auto StreamReader::generic_search_log_events(
+        FilterCache& filter_cache,
+        FilteredLogEventsMap& filtered_log_event_map,
+        std::string const& query,
+        SearchOptionsTsType const& options,
+        LogEvents<LogEvent> const& log_events,
+        LogLevelIndex const& log_level_index,
+        TimestampIndex const& timestamp_index,
+        MatchFunc matches
+) -> size_t {
+    auto text_query{create_text_query(query, options)};
+    filter_cache.set_base_filter(
+            get_search_filter_key(query, options),
+            compose_filter(
+                    create_search_log_level_filter(options, log_level_index),
+                    [text_query = std::move(text_query),
+                     matches = std::move(matches)](size_t log_event_idx) mutable -> bool {
+                        return matches(log_event_idx, text_query);
+                    }
+            )
+    );
+    apply_filter_components(filter_cache, filtered_log_event_map, log_events, timestamp_index);
+    return filtered_log_event_map->size();
 }
 
 template <typename LogEvent>
 auto StreamReader::generic_filter_log_events(
+        FilterCache& filter_cache,
         FilteredLogEventsMap& filtered_log_event_map,
         LogLevelFilterTsType const& log_level_filter,
-        LogEvents<LogEvent> const& log_events
+        LogEvents<LogEvent> const& log_events,
+        LogLevelIndex const& log_level_index,
+        TimestampIndex const& timestamp_index
 ) -> void {
     if (log_level_filter.isNull()) {
-        filtered_log_event_map.reset();
-        return;
-    }
-
-    filtered_log_event_map.emplace();
-    auto filter_levels
-            = emscripten::vecFromJSArray<std::underlying_type_t<LogLevel>>(log_level_filter);
-
-    for (size_t log_event_idx = 0; log_event_idx < log_events.size(); ++log_event_idx) {
-        auto const& log_event = log_events[log_event_idx];
-        if (std::ranges::find(
-                    filter_levels,
-                    clp::enum_to_underlying_type(log_event.get_log_level())
-            )
-            != filter_levels.end())
-        {
-            filtered_log_event_map->emplace_back(log_event_idx);
-        }
+        filter_cache.reset_base_filter();
+    } else {
+        auto log_levels{get_filter_log_levels(log_level_filter)};
+        auto key{get_log_level_filter_key(log_levels)};
+        filter_cache.set_base_filter(
+                std::move(key),
+                create_log_level_filter(std::move(log_levels), log_level_index)
+        );
     }
+    apply_filter_components(filter_cache, filtered_log_event_map, log_events, timestamp_index);
 }
 
 template <typename LogEvent>
-auto StreamReader::generic_find_nearest_log_event_by_timestamp(
+auto StreamReader::generic_filter_log_events_by_time_range(
+        FilterCache& filter_cache,
+        FilteredLogEventsMap& filtered_log_event_map,
         LogEvents<LogEvent> const& log_events,
-        clp::ir::epoch_time_ms_t target_ts
-) -> NullableLogEventIdx {
-    if (log_events.empty()) {
-        return NullableLogEventIdx{emscripten::val::null()};
-    }
+        TimestampIndex const& timestamp_index,
+        std::optional<FilterCache::TimeRange> time_range
+) -> size_t {
+    filter_cache.set_time_range(time_range);
+    apply_filter_components(filter_cache, filtered_log_event_map, log_events, timestamp_index);
+    return filtered_log_event_map.has_value() ? filtered_log_event_map->size() : log_events.size();
+}
 
-    // Find the log event whose timestamp is just after `target_ts`
-    auto first_greater_it{std::upper_bound(
-            log_events.begin(),
-            log_events.end(),
-            target_ts,
-            [](clp::ir::epoch_time_ms_t ts, LogEventWithFilterData<LogEvent> const& log_event) {
-                return ts < log_event.get_timestamp();
-            }
-    )};
+template <typename LogEvent>
+auto StreamReader::apply_filter_components(
+        FilterCache& filter_cache,
+        FilteredLogEventsMap& filtered_log_event_map,
+        LogEvents<LogEvent> const& log_events,
+        TimestampIndex const& timestamp_index
+) -> void {
+    // Each stage composes one more component with the stages before it (in the order base filter,
+    // predicate, time range), and its result is cached under a key that extends theirs.
+    struct Stage {
+        std::string key;
+        FilterFunc filter;
+        // Narrows the previous stage's result; nullptr for the base filter.
+        FilterCache::PredicateFunc matches;
+    };
 
-    if (first_greater_it == log_events.begin()) {
-        return NullableLogEventIdx{emscripten::val(0)};
+    std::vector<Stage> stages;
+    auto add_stage = [&](std::string const& component_key, FilterCache::PredicateFunc matches) {
+        FilterFunc previous_filter;
+        std::string key;
+        if (false == stages.empty()) {
+            previous_filter = stages.back().filter;
+            key = stages.back().key;
+        }
+        key += std::format("|{}", component_key);
+        stages.push_back(
+                Stage{std::move(key), compose_filter(std::move(previous_filter), matches), matches}
+        );
+    };
+    if (auto const& base_filter{filter_cache.get_base_filter()}; nullptr != base_filter) {
+        stages.push_back(Stage{filter_cache.get_base_filter_key(), base_filter, nullptr});
+    }
+    if (auto const& predicate{filter_cache.get_predicate()}; nullptr != predicate) {
+        add_stage(std::format("predicate:{}", filter_cache.get_predicate_key()), predicate);
+    }
+    auto const& time_range{filter_cache.get_time_range()};
+    if (time_range.has_value()) {
+        auto const [begin_ts, end_ts]{time_range.value()};
+        add_stage(
+                std::format("time:{},{}", begin_ts, end_ts),
+                [&log_events, begin_ts, end_ts](size_t log_event_idx) -> bool {
+                    auto const timestamp{log_events.get_timestamps()[log_event_idx]};
+                    return begin_ts <= timestamp && timestamp < end_ts;
+                }
+        );
+    }
+    if (stages.empty()) {
+        filter_cache.deactivate(filtered_log_event_map);
+        return;
     }
 
-    auto const first_greater_idx{std::distance(log_events.begin(), first_greater_it)};
+    // Resume from the last stage whose result is cached.
+    auto const num_log_events{log_events.size()};
+    auto num_cached_stages{stages.size()};
+    for (; num_cached_stages > 0; --num_cached_stages) {
+        auto const& key{stages[num_cached_stages - 1].key};
+        if (filter_cache.activate(key, num_log_events, filtered_log_event_map)) {
+            break;
+        }
+    }
 
-    return NullableLogEventIdx{emscripten::val(first_greater_idx - 1)};
+    for (auto stage_idx{num_cached_stages}; stage_idx < stages.size(); ++stage_idx) {
+        auto& stage{stages[stage_idx]};
+        std::vector<size_t> log_event_indices;
+        if (stage_idx > 0) {
+            std::ranges::copy_if(
+                    filtered_log_event_map.value(),
+                    std::back_inserter(log_event_indices),
+                    stage.matches
+            );
+        } else if (1 == stages.size() && time_range.has_value()) {
+            // The time range is the only component, so its result comes from the index.
+            auto const [begin_ts, end_ts]{time_range.value()};
+            timestamp_index.get_log_event_indices(
+                    log_events.get_timestamps(),
+                    begin_ts,
+                    end_ts,
+                    log_event_indices
+            );
+        } else {
+            stage.filter(0, num_log_events, log_event_indices);
+        }
+        filter_cache.insert(
+                std::move(stage.key),
+                std::move(stage.filter),
+                std::move(log_event_indices),
+                num_log_events,
+                filtered_log_event_map
+        );
+    }
 }
 }  // namespace clp_ffi_js::ir
 
@@ -4,26 +4,32 @@
 #include <memory>
 #include <utility>
 
-#include <clp/Array.hpp>
-#include <clp/ReaderInterface.hpp>
+#include <clp/streaming_compression/zstd/Decompressor.hpp>
+
+#include <clp_ffi_js/ir/ChunkedReader.hpp>
+#include <clp_ffi_js/ir/RewindableReader.hpp>
 
 namespace clp_ffi_js::ir {
 /**
  * The data context for a `StreamReader`. It encapsulates a chain of the following resources:
- * An IR deserializer class that reads from a `clp::ReaderInterface`, which in turn reads from a
- * `clp::Array`.
+ * An IR deserializer class that reads from a `RewindableReader`, which in turn reads from a
+ * Zstandard decompressor, which in turn reads from a `ChunkedReader` holding the compressed input.
  * @tparam Deserializer Type of deserializer.
  */
 template <typename Deserializer>
 class StreamReaderDataContext {
 public:
+    using ZstdDecompressor = clp::streaming_compression::zstd::Decompressor;
+
     // Constructors
     StreamReaderDataContext(
-            clp::Array<char>&& data_buffer,
-            std::unique_ptr<clp::ReaderInterface>&& reader,
+            std::unique_ptr<ChunkedReader>&& input_reader,
+            std::unique_ptr<ZstdDecompressor>&& zstd_decompressor,
+            std::unique_ptr<RewindableReader>&& reader,
             Deserializer deserializer
     )
-            : m_data_buffer{std::move(data_buffer)},
+            : m_input_reader{std::move(input_reader)},
+              m_zstd_decompressor{std::move(zstd_decompressor)},
               m_reader{std::move(reader)},
               m_deserializer{std::move(deserializer)} {}
 
@@ -41,11 +47,14 @@ public:
     // Methods
     [[nodiscard]] auto get_deserializer() -> Deserializer& { return m_deserializer; }
 
-    [[nodiscard]] auto get_reader() -> clp::ReaderInterface& { return *m_reader; }
+    [[nodiscard]] auto get_input_reader() -> ChunkedReader& { return *m_input_reader; }
+
+    [[nodiscard]] auto get_reader() -> RewindableReader& { return *m_reader; }
 
 private:
-    clp::Array<char> m_data_buffer;
-    std::unique_ptr<clp::ReaderInterface> m_reader;
+    std::unique_ptr<ChunkedReader> m_input_reader;
+    std::unique_ptr<ZstdDecompressor> m_zstd_decompressor;
+    std::unique_ptr<RewindableReader> m_reader;
     Deserializer m_deserializer;
 };
 }  // namespace clp_ffi_js::ir
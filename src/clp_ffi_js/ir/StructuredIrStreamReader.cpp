@@ -1,32 +1,67 @@
 #include "StructuredIrStreamReader.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <format>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <type_utils.hpp>
 #include <utility>
+#include <vector>
 
-#include <clp/Array.hpp>
+#include <clp/BufferReader.hpp>
 #include <clp/ErrorCode.hpp>
+#include <clp/ffi/ir_stream/decoding_methods.hpp>
 #include <clp/ffi/ir_stream/Deserializer.hpp>
+#include <clp/ffi/ir_stream/IrUnitType.hpp>
+#include <clp/ffi/ir_stream/protocol_constants.hpp>
+#include <clp/ffi/SchemaTree.hpp>
 #include <clp/ir/types.hpp>
+#include <clp/ReaderInterface.hpp>
 #include <clp/TraceableException.hpp>
+#include <emscripten/bind.h>
 #include <emscripten/val.h>
 #include <json/single_include/nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
 #include <clp_ffi_js/ClpFfiJsException.hpp>
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/ChunkedReader.hpp>
+#include <clp_ffi_js/ir/ColumnarDecodeBuffers.hpp>
+#include <clp_ffi_js/ir/FieldPredicate.hpp>
+#include <clp_ffi_js/ir/kv_pair_values.hpp>
+#include <clp_ffi_js/ir/LazyStructuredLogEvents.hpp>
+#include <clp_ffi_js/ir/LogEventDiagnostics.hpp>
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+#include <clp_ffi_js/ir/LogLevelIndex.hpp>
+#include <clp_ffi_js/ir/LogLevelResolver.hpp>
+#include <clp_ffi_js/ir/memory_usage.hpp>
+#include <clp_ffi_js/ir/PackedStructuredLogEvents.hpp>
+#include <clp_ffi_js/ir/parallel_decode.hpp>
+#include <clp_ffi_js/ir/ReaderStats.hpp>
+#include <clp_ffi_js/ir/RewindableReader.hpp>
+#include <clp_ffi_js/ir/SeekableZstdInput.hpp>
 #include <clp_ffi_js/ir/StreamReader.hpp>
 #include <clp_ffi_js/ir/StreamReaderDataContext.hpp>
+#include <clp_ffi_js/ir/stream_index.hpp>
 #include <clp_ffi_js/ir/StructuredIrUnitHandler.hpp>
+#include <clp_ffi_js/ir/StructuredLogEventJsonSerializer.hpp>
+#include <clp_ffi_js/ir/TextQuery.hpp>
+#include <clp_ffi_js/ir/TimestampIndex.hpp>
 
 namespace clp_ffi_js::ir {
 namespace {
+constexpr std::string_view cEmptyJsonArrayStr{"[]"};
 constexpr std::string_view cEmptyJsonStr{"{}"};
+constexpr std::string_view cReaderOptionsLazyKey{"lazy"};
+constexpr std::string_view cReaderOptionsLogLevelAliasesKey{"logLevelAliases"};
 constexpr std::string_view cReaderOptionsLogLevelKey{"logLevelKey"};
+constexpr std::string_view cReaderOptionsPackedKey{"packed"};
 constexpr std::string_view cReaderOptionsTimestampKey{"timestampKey"};
 
 /**
@@ -42,20 +77,114 @@ auto dump_json_with_replace(nlohmann::json const& json) -> std::string {
     return json.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
 }
 
+/**
+ * @param reader_options
+ * @return The log level aliases in the reader options, mapping each alias to its log level's
+ * integer value, or an empty vector if the option isn't set.
+ * @throw ClpFfiJsException if any alias's log level isn't the integer value of a valid log level.
+ */
+auto get_log_level_aliases(ReaderOptions const& reader_options)
+        -> std::vector<LogLevelResolver::Alias>;
+
+auto get_log_level_aliases(ReaderOptions const& reader_options)
+        -> std::vector<LogLevelResolver::Alias> {
+    constexpr auto cMinAliasLogLevelValue{
+            static_cast<double>(clp::enum_to_underlying_type(cValidLogLevelsBeginIdx))
+    };
+    constexpr auto cMaxAliasLogLevelValue{
+            static_cast<double>(clp::enum_to_underlying_type(LogLevel::LENGTH) - 1)
+    };
+
+    std::vector<LogLevelResolver::Alias> aliases;
+    auto const aliases_option{reader_options[cReaderOptionsLogLevelAliasesKey.data()]};
+    if (aliases_option.isUndefined() || aliases_option.isNull()) {
+        return aliases;
+    }
+
+    auto const names{emscripten::vecFromJSArray<std::string>(
+            emscripten::val::global("Object").call<emscripten::val>("keys", aliases_option)
+    )};
+    aliases.reserve(names.size());
+    for (auto const& name : names) {
+        // Read the log level as a JS number rather than as `LogLevel`'s underlying type, so that
+        // out-of-range values are rejected instead of wrapping around to a valid log level.
+        auto const log_level_option{aliases_option[name]};
+        auto const log_level_value{
+                log_level_option.isNumber() ? log_level_option.as<double>() : 0.0
+        };
+        if (log_level_value < cMinAliasLogLevelValue || log_level_value > cMaxAliasLogLevelValue
+            || std::trunc(log_level_value) != log_level_value)
+        {
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_BadParam,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format("Invalid log level for log level alias \"{}\"", name)
+            };
+        }
+        aliases.emplace_back(name, static_cast<LogLevel>(log_level_value));
+    }
+    return aliases;
+}
+
+/**
+ * Consumes the next IR unit if it's the end of the stream.
+ *
+ * A deserializer that has deserialized the end of the stream refuses to deserialize any more IR
+ * units, so deserializers that are kept to deserialize log events again must never be given it.
+ *
+ * @param reader
+ * @return Whether the next IR unit was the end of the stream. If not, the reader's position is
+ * unchanged.
+ */
+auto try_consume_end_of_stream(clp::ReaderInterface& reader) -> bool;
+
+auto try_consume_end_of_stream(clp::ReaderInterface& reader) -> bool {
+    auto const pos{reader.get_pos()};
+    clp::ffi::ir_stream::encoded_tag_t tag{};
+    if (clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Success
+                == clp::ffi::ir_stream::deserialize_tag(reader, tag)
+        && clp::ffi::ir_stream::cProtocol::Eof == tag)
+    {
+        return true;
+    }
+    reader.seek_from_begin(pos);
+    return false;
+}
 }  // namespace
 
 auto StructuredIrStreamReader::create(
+        std::unique_ptr<ChunkedReader>&& input_reader,
         std::unique_ptr<ZstdDecompressor>&& zstd_decompressor,
-        clp::Array<char> data_array,
-        ReaderOptions const& reader_options
+        std::unique_ptr<RewindableReader>&& reader,
+        ReaderOptions const& reader_options,
+        std::unique_ptr<SeekableZstdInput>&& seekable_input,
+        std::shared_ptr<ReaderStats> stats
 ) -> StructuredIrStreamReader {
-    auto deserialized_log_events{std::make_shared<StructuredLogEvents>()};
+    auto const is_lazy{StructuredIrStreamReader::is_lazy(reader_options)};
+    auto const packed_option{reader_options[cReaderOptionsPackedKey.data()]};
+    // Lazy log events are already kept compact, so `packed` only applies to non-lazy readers.
+    auto const is_packed{
+            false == is_lazy && false == packed_option.isUndefined() && packed_option.as<bool>()
+    };
+    auto deserialized_log_events{
+            std::make_shared<StructuredLogEvents>(false == is_lazy && false == is_packed)
+    };
+    std::shared_ptr<PackedStructuredLogEvents> packed_log_events;
+    if (is_packed) {
+        packed_log_events = std::make_shared<PackedStructuredLogEvents>();
+    }
+    auto diagnostics{std::make_shared<LogEventDiagnostics>()};
     auto result{StructuredIrDeserializer::create(
-            *zstd_decompressor,
+            *reader,
             StructuredIrUnitHandler{
                     deserialized_log_events,
                     reader_options[cReaderOptionsLogLevelKey.data()].as<std::string>(),
-                    reader_options[cReaderOptionsTimestampKey.data()].as<std::string>()
+                    reader_options[cReaderOptionsTimestampKey.data()].as<std::string>(),
+                    LogLevelResolver{get_log_level_aliases(reader_options)},
+                    stats,
+                    diagnostics,
+                    packed_log_events
             }
     )};
     if (result.has_error()) {
@@ -72,11 +201,27 @@ auto StructuredIrStreamReader::create(
         };
     }
     StreamReaderDataContext<StructuredIrDeserializer> data_context{
-            std::move(data_array),
+            std::move(input_reader),
             std::move(zstd_decompressor),
+            std::move(reader),
             std::move(result.value())
     };
-    return StructuredIrStreamReader{std::move(data_context), std::move(deserialized_log_events)};
+    return StructuredIrStreamReader{
+            std::move(data_context),
+            std::move(deserialized_log_events),
+            std::move(seekable_input),
+            std::move(packed_log_events),
+            std::move(stats),
+            std::move(diagnostics)
+    };
+}
+
+auto StructuredIrStreamReader::is_lazy(ReaderOptions const& reader_options) -> bool {
+    if (reader_options.isNull()) {
+        return false;
+    }
+    auto const lazy_option{reader_options[cReaderOptionsLazyKey.data()]};
+    return false == lazy_option.isUndefined() && lazy_option.as<bool>();
 }
 
 auto StructuredIrStreamReader::get_num_events_buffered() const -> size_t {
@@ -91,32 +236,262 @@ auto StructuredIrStreamReader::get_filtered_log_event_map() const -> FilteredLog
     return FilteredLogEventMapTsType{emscripten::val::array(m_filtered_log_event_map.value())};
 }
 
+auto StructuredIrStreamReader::get_filtered_log_event_map_view() const
+        -> FilteredLogEventMapViewTsType {
+    return create_filtered_log_event_map_view(m_filtered_log_event_map);
+}
+
+auto StructuredIrStreamReader::get_log_event_idx(size_t filtered_log_event_idx) const
+        -> NullableLogEventIdx {
+    return generic_get_log_event_idx(m_filtered_log_event_map, filtered_log_event_idx);
+}
+
+auto StructuredIrStreamReader::get_filtered_log_event_idx(size_t log_event_idx) const
+        -> NullableLogEventIdx {
+    return generic_get_filtered_log_event_idx(m_filtered_log_event_map, log_event_idx);
+}
+
+auto StructuredIrStreamReader::get_stats() const -> StatsTsType {
+    return create_stats(*m_stats);
+}
+
+auto StructuredIrStreamReader::get_diagnostics() const -> DiagnosticsTsType {
+    return create_diagnostics(*m_diagnostics);
+}
+
+auto StructuredIrStreamReader::get_memory_usage() const -> MemoryUsageTsType {
+    StructuredLogEvent const* log_event{nullptr};
+    size_t log_events_size{get_log_events_size(*m_deserialized_log_events)};
+    if (m_lazy_log_events.has_value()) {
+        log_event = m_lazy_log_events->get_any_loaded_log_event();
+        log_events_size += m_lazy_log_events->get_heap_size();
+    } else if (false == m_deserialized_log_events->empty()) {
+        log_event = &m_deserialized_log_events->get_log_events().back();
+    }
+    // All log events share the same schema tree.
+    size_t schema_tree_size{0};
+    if (nullptr != log_event) {
+        schema_tree_size = get_heap_size(log_event->get_schema_tree());
+    }
+
+    size_t compressed_input_size{0};
+    if (nullptr != m_stream_reader_data_context) {
+        compressed_input_size
+                = m_stream_reader_data_context->get_input_reader().get_num_bytes_resident();
+    }
+    if (m_lazy_log_events.has_value()) {
+        // NOTE: A retained input is shared with the input reader while the stream is deserialized.
+        compressed_input_size = std::max(
+                compressed_input_size,
+                m_lazy_log_events->get_retained_compressed_input_size()
+        );
+    }
+
+    return create_memory_usage(
+            log_events_size,
+            schema_tree_size,
+            get_filtered_log_event_map_size(m_filtered_log_event_map)
+                    + m_filter_cache.get_heap_size() + m_log_level_index.get_heap_size()
+                    + m_timestamp_index.get_heap_size(),
+            compressed_input_size
+    );
+}
+
+auto StructuredIrStreamReader::shrink_to_fit() -> void {
+    m_deserialized_log_events->shrink_to_fit();
+    if (m_lazy_log_events.has_value()) {
+        m_lazy_log_events->shrink_to_fit();
+    }
+    m_filter_cache.shrink_to_fit(m_filtered_log_event_map);
+    m_log_level_index.shrink_to_fit();
+    m_timestamp_index.shrink_to_fit();
+}
+
 void StructuredIrStreamReader::filter_log_events(LogLevelFilterTsType const& log_level_filter) {
     generic_filter_log_events(
+            m_filter_cache,
             m_filtered_log_event_map,
             log_level_filter,
-            *m_deserialized_log_events
+            *m_deserialized_log_events,
+            m_log_level_index,
+            m_timestamp_index
+    );
+}
+
+auto StructuredIrStreamReader::get_log_level_counts() const -> LogLevelCountsTsType {
+    return generic_get_log_level_counts(m_log_level_index);
+}
+
+auto StructuredIrStreamReader::filter_log_events_by_time_range(
+        clp::ir::epoch_time_ms_t begin_ts,
+        clp::ir::epoch_time_ms_t end_ts
+) -> size_t {
+    return generic_filter_log_events_by_time_range(
+            m_filter_cache,
+            m_filtered_log_event_map,
+            *m_deserialized_log_events,
+            m_timestamp_index,
+            FilterCache::TimeRange{begin_ts, end_ts}
+    );
+}
+
+auto StructuredIrStreamReader::clear_time_range() -> void {
+    generic_filter_log_events_by_time_range(
+            m_filter_cache,
+            m_filtered_log_event_map,
+            *m_deserialized_log_events,
+            m_timestamp_index,
+            std::nullopt
+    );
+}
+
+auto StructuredIrStreamReader::filter_log_events_by_predicate(PredicateTsType const& predicate)
+        -> size_t {
+    if (predicate.isNull()) {
+        m_filter_cache.reset_predicate();
+    } else {
+        auto const predicate_str{predicate.as<std::string>()};
+        FieldPredicate field_predicate{predicate_str};
+        // The predicate is length-prefixed so that no predicate can produce the key of another
+        // filter.
+        m_filter_cache.set_predicate(
+                std::format("{}:{}", predicate_str.size(), predicate_str),
+                [this, field_predicate = std::move(field_predicate)](size_t log_event_idx) mutable
+                -> bool { return field_predicate.matches(load_log_event(log_event_idx)); }
+        );
+    }
+    apply_filter_components(
+            m_filter_cache,
+            m_filtered_log_event_map,
+            *m_deserialized_log_events,
+            m_timestamp_index
+    );
+    return m_filtered_log_event_map.has_value() ? m_filtered_log_event_map->size()
+                                                : m_deserialized_log_events->size();
+}
+
+auto StructuredIrStreamReader::get_time_histogram(
+        clp::ir::epoch_time_ms_t begin_ts,
+        clp::ir::epoch_time_ms_t end_ts,
+        size_t num_buckets
+) const -> TimeHistogramTsType {
+    return generic_get_time_histogram(
+            m_deserialized_log_events->get_timestamps(),
+            m_timestamp_index,
+            begin_ts,
+            end_ts,
+            num_buckets
+    );
+}
+
+auto StructuredIrStreamReader::search_log_events(
+        std::string const& query,
+        SearchOptionsTsType const& options
+) -> size_t {
+    return generic_search_log_events(
+            m_filter_cache,
+            m_filtered_log_event_map,
+            query,
+            options,
+            *m_deserialized_log_events,
+            m_log_level_index,
+            m_timestamp_index,
+            [this, decoded = std::string{}](size_t log_event_idx, TextQuery const& text_query
+            ) mutable -> bool {
+                // Only string values are matched, as they are rather than as JSON, so that a query
+                // doesn't match keys, escape sequences, or the JSON syntax between values.
+                auto const& log_event{load_log_event(log_event_idx)};
+                for (auto const& [node_id, optional_value] : log_event.get_node_id_value_pairs()) {
+                    if (false == optional_value.has_value()) {
+                        continue;
+                    }
+                    auto const str{get_string_value(optional_value.value(), decoded)};
+                    if (str.has_value() && text_query.matches(str.value())) {
+                        return true;
+                    }
+                }
+                return false;
+            }
     );
 }
 
 auto StructuredIrStreamReader::deserialize_stream() -> size_t {
+    deserialize(DeserializationBudget{0, 0});
+    return m_deserialized_log_events->size();
+}
+
+auto StructuredIrStreamReader::deserialize_next(size_t max_num_events, size_t max_duration_ms)
+        -> DeserializationProgressTsType {
+    deserialize(DeserializationBudget{max_num_events, max_duration_ms});
+    return create_deserialization_progress(
+            m_deserialized_log_events->size(),
+            m_num_bytes_deserialized,
+            m_num_compressed_bytes_consumed,
+            nullptr == m_stream_reader_data_context
+    );
+}
+
+auto StructuredIrStreamReader::deserialize(DeserializationBudget const& budget) -> void {
     if (nullptr == m_stream_reader_data_context) {
-        return m_deserialized_log_events->size();
+        return;
     }
 
-    constexpr size_t cDefaultNumReservedLogEvents{500'000};
-    m_deserialized_log_events->reserve(cDefaultNumReservedLogEvents);
+    auto& input_reader{m_stream_reader_data_context->get_input_reader()};
     auto& reader{m_stream_reader_data_context->get_reader()};
     auto& deserializer = m_stream_reader_data_context->get_deserializer();
+    auto const num_events_before{m_deserialized_log_events->size()};
+    ReaderStats::ScopedPhase const parsing_phase{*m_stats, ReaderPhase::IrUnitParsing};
 
+    bool is_stream_exhausted{false};
     while (false == deserializer.is_stream_completed()) {
+        if (budget.is_exhausted(m_deserialized_log_events->size() - num_events_before)) {
+            break;
+        }
+        if (m_deserialized_log_events->size() == m_deserialized_log_events->capacity()) {
+            ReaderStats::ScopedPhase const growth_phase{*m_stats, ReaderPhase::BufferGrowth};
+            m_deserialized_log_events->reserve(
+                    estimate_log_events_capacity(m_deserialized_log_events->size(), input_reader)
+            );
+            m_stats->increment(ReaderCounter::NumBufferGrowths);
+        }
+        // The IR unit's bytes are only needed to retry it if the input is incomplete, or to record
+        // it in the lazy log events.
+        reader.set_checkpoint(
+                m_lazy_log_events.has_value() || false == input_reader.is_input_complete()
+        );
+        if (m_lazy_log_events.has_value() && try_consume_end_of_stream(reader)) {
+            // The deserializer is kept to deserialize log events again (see
+            // `try_consume_end_of_stream`).
+            m_stats->increment(clp::ffi::ir_stream::IrUnitType::EndOfStream);
+            is_stream_exhausted = true;
+            break;
+        }
         auto result{deserializer.deserialize_next_ir_unit(reader)};
         if (false == result.has_error()) {
+            m_stats->increment(result.value());
+            if (false == m_lazy_log_events.has_value()) {
+                continue;
+            }
+            if (clp::ffi::ir_stream::IrUnitType::LogEvent == result.value()) {
+                m_lazy_log_events->append(
+                        reader.get_bytes_since_checkpoint(),
+                        reader.get_checkpoint_pos()
+                );
+            } else {
+                m_lazy_log_events->append_non_log_event_ir_unit(reader.get_bytes_since_checkpoint()
+                );
+            }
             continue;
         }
         auto const error{result.error()};
         if (std::errc::result_out_of_range == error) {
+            if (false == input_reader.is_input_complete()) {
+                // Retry the IR unit once more of the input has been pushed.
+                reader.rewind_to_checkpoint();
+                break;
+            }
             SPDLOG_ERROR("File contains an incomplete IR stream");
+            is_stream_exhausted = true;
             break;
         }
         throw ClpFfiJsException{
@@ -130,53 +505,435 @@ auto StructuredIrStreamReader::deserialize_stream() -> size_t {
                 )
         };
     }
-    m_stream_reader_data_context.reset(nullptr);
-    return m_deserialized_log_events->size();
+    {
+        ReaderStats::ScopedPhase const indexing_phase{*m_stats, ReaderPhase::Indexing};
+        m_log_level_index.update(*m_deserialized_log_events);
+        m_timestamp_index.update(m_deserialized_log_events->get_timestamps());
+        m_filter_cache.update_active(m_deserialized_log_events->size(), m_filtered_log_event_map);
+    }
+    m_num_bytes_deserialized = reader.get_pos();
+    m_num_compressed_bytes_consumed = input_reader.get_pos();
+
+    if (is_stream_exhausted || deserializer.is_stream_completed()) {
+        if (m_lazy_log_events.has_value()) {
+            // Keep the deserializer (and its schema tree) to materialize log events on demand.
+            m_detached_deserializer
+                    = std::make_unique<StructuredIrDeserializer>(std::move(deserializer));
+        }
+        m_stream_reader_data_context.reset(nullptr);
+    }
 }
 
-auto StructuredIrStreamReader::decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
+auto StructuredIrStreamReader::decode_range(size_t begin_idx, size_t end_idx, bool use_filter)
         -> DecodedResultsTsType {
-    auto log_event_to_string = [](StructuredLogEvent const& log_event) -> std::string {
-        std::string json_str;
-        auto const json_result{log_event.serialize_to_json()};
-        if (false == json_result.has_value()) {
-            auto error_code{json_result.error()};
-            SPDLOG_ERROR(
-                    "Failed to deserialize log event to JSON: {}:{}",
-                    error_code.category().name(),
-                    error_code.message()
+    load_lazy_pages(begin_idx, end_idx, use_filter);
+    return generic_decode_range(
+            begin_idx,
+            end_idx,
+            m_filtered_log_event_map,
+            *m_deserialized_log_events,
+            [this](size_t log_event_idx) -> std::string {
+                return log_event_to_string(get_log_event(log_event_idx));
+            },
+            use_filter
+    );
+}
+
+auto StructuredIrStreamReader::decode_range_columnar(
+        size_t begin_idx,
+        size_t end_idx,
+        bool use_filter
+) -> DecodedColumnarResultsTsType {
+    load_lazy_pages(begin_idx, end_idx, use_filter);
+    return generic_decode_range_columnar(
+            begin_idx,
+            end_idx,
+            m_filtered_log_event_map,
+            *m_deserialized_log_events,
+            [this](size_t log_event_idx) -> std::string {
+                return log_event_to_string(get_log_event(log_event_idx));
+            },
+            use_filter,
+            m_columnar_decode_buffers
+    );
+}
+
+auto StructuredIrStreamReader::decode_range_projected(
+        size_t begin_idx,
+        size_t end_idx,
+        bool use_filter,
+        KeyPathsTsType const& key_paths
+) -> DecodedResultsTsType {
+    std::vector<std::vector<std::string>> parsed_key_paths;
+    for (auto const& key_path : emscripten::vecFromJSArray<emscripten::val>(key_paths)) {
+        parsed_key_paths.emplace_back(emscripten::vecFromJSArray<std::string>(key_path));
+    }
+
+    load_lazy_pages(begin_idx, end_idx, use_filter);
+
+    // Resolve the key paths once against the schema tree, which every log event shares. Invalid
+    // ranges are left for `generic_decode_range` to report.
+    std::vector<std::vector<clp::ffi::SchemaTree::Node::id_t>> projected_keys;
+    size_t num_log_events{m_deserialized_log_events->size()};
+    if (use_filter) {
+        num_log_events = 0;
+        if (m_filtered_log_event_map.has_value()) {
+            num_log_events = m_filtered_log_event_map->size();
+        }
+    }
+    if (begin_idx < end_idx && end_idx <= num_log_events) {
+        auto const first_log_event_idx{
+                use_filter ? m_filtered_log_event_map->at(begin_idx) : begin_idx
+        };
+        auto const& schema_tree{get_log_event(first_log_event_idx).get_schema_tree()};
+        projected_keys.reserve(parsed_key_paths.size());
+        for (auto const& key_path : parsed_key_paths) {
+            projected_keys.emplace_back(
+                    StructuredLogEventJsonSerializer::resolve_key_path(schema_tree, key_path)
             );
-            json_str = std::string(cEmptyJsonStr);
-        } else {
-            json_str = dump_json_with_replace(json_result.value());
         }
-        return json_str;
-    };
+    }
 
     return generic_decode_range(
             begin_idx,
             end_idx,
             m_filtered_log_event_map,
             *m_deserialized_log_events,
-            log_event_to_string,
+            [&](size_t log_event_idx) -> std::string {
+                return log_event_to_projected_string(
+                        get_log_event(log_event_idx),
+                        projected_keys,
+                        parsed_key_paths
+                );
+            },
             use_filter
     );
 }
 
+auto StructuredIrStreamReader::begin_export(size_t begin_idx, size_t end_idx, bool use_filter)
+        -> bool {
+    return generic_begin_export(
+            begin_idx,
+            end_idx,
+            use_filter,
+            m_filtered_log_event_map,
+            m_filter_cache.get_generation(),
+            m_deserialized_log_events->size(),
+            m_export_buffer
+    );
+}
+
+auto StructuredIrStreamReader::export_next_chunk() -> ExportChunkTsType {
+    return generic_export_next_chunk(
+            m_filtered_log_event_map,
+            m_filter_cache.get_generation(),
+            [this](size_t begin_idx, size_t end_idx, bool use_filter) {
+                load_lazy_pages(begin_idx, end_idx, use_filter);
+            },
+            [this](size_t log_event_idx) -> std::string {
+                return log_event_to_string(get_log_event(log_event_idx));
+            },
+            m_export_buffer
+    );
+}
+
 auto StructuredIrStreamReader::find_nearest_log_event_by_timestamp(
         clp::ir::epoch_time_ms_t const target_ts
 ) -> NullableLogEventIdx {
-    return generic_find_nearest_log_event_by_timestamp(*m_deserialized_log_events, target_ts);
+    return generic_find_nearest_log_event_by_timestamp(
+            m_deserialized_log_events->get_timestamps(),
+            m_timestamp_index,
+            target_ts
+    );
+}
+
+auto StructuredIrStreamReader::get_timestamps() const
+        -> std::span<clp::ir::epoch_time_ms_t const> {
+    return m_deserialized_log_events->get_timestamps();
+}
+
+auto StructuredIrStreamReader::get_log_levels() const -> std::span<LogLevel const> {
+    return m_deserialized_log_events->get_log_levels();
+}
+
+auto StructuredIrStreamReader::decode_log_events(std::span<size_t const> log_event_indices)
+        -> std::vector<std::string> {
+    validate_log_event_indices(log_event_indices, m_deserialized_log_events->size());
+    load_lazy_pages(log_event_indices);
+    return parallel_decode(log_event_indices.size(), [&](size_t i) -> std::string {
+        return log_event_to_string(get_log_event(log_event_indices[i]));
+    });
+}
+
+auto StructuredIrStreamReader::get_input_reader() -> ChunkedReader* {
+    if (nullptr == m_stream_reader_data_context) {
+        return nullptr;
+    }
+    return &m_stream_reader_data_context->get_input_reader();
+}
+
+auto StructuredIrStreamReader::export_index_blob() const -> std::vector<char> {
+    auto const input{get_indexed_input().get_compressed_input()};
+    if (nullptr != m_stream_reader_data_context) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_NotReady,
+                __FILENAME__,
+                __LINE__,
+                "Cannot export the index before the stream has been fully deserialized."
+        };
+    }
+
+    return serialize_stream_index(StreamIndexView{
+            .input_hash = hash_input(input),
+            .input_size = input.size(),
+            .timestamps = m_deserialized_log_events->get_timestamps(),
+            .log_levels = m_deserialized_log_events->get_log_levels(),
+            .ir_unit_begin_offsets = m_lazy_log_events->get_ir_unit_begin_offsets(),
+            .ir_unit_end_offsets = m_lazy_log_events->get_ir_unit_end_offsets(),
+            .non_log_event_ir_units = m_lazy_log_events->get_non_log_event_ir_units()
+    });
+}
+
+auto StructuredIrStreamReader::import_index_blob(std::span<char const> blob) -> bool {
+    auto const& seekable_input{get_indexed_input()};
+    if (nullptr == m_stream_reader_data_context || 0 != m_num_bytes_deserialized) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "Cannot import an index after deserialization has started."
+        };
+    }
+
+    auto index{deserialize_stream_index(blob)};
+    auto const input{seekable_input.get_compressed_input()};
+    if (false == index.has_value()) {
+        SPDLOG_WARN("Ignoring malformed or incompatible index.");
+        return false;
+    }
+    if (index->input_size != input.size() || index->input_hash != hash_input(input)) {
+        SPDLOG_WARN("Ignoring index that belongs to a different input.");
+        return false;
+    }
+    auto const decompressed_size{seekable_input.get_frame_index().get_decompressed_size()};
+    if (false == index->ir_unit_end_offsets.empty()
+        && index->ir_unit_end_offsets.back() > decompressed_size)
+    {
+        SPDLOG_WARN("Ignoring index with IR units past the end of the stream.");
+        return false;
+    }
+
+    // Replay the IR units that aren't log events to restore the deserializer's state (e.g., the
+    // schema tree). The saved IR units exclude the end of the stream, but since the deserializer is
+    // kept to deserialize log events again, it mustn't be replayed even if an index includes it
+    // (see `try_consume_end_of_stream`).
+    auto& deserializer{m_stream_reader_data_context->get_deserializer()};
+    auto const& non_log_event_ir_units{index->non_log_event_ir_units};
+    clp::BufferReader reader{non_log_event_ir_units.data(), non_log_event_ir_units.size()};
+    while (reader.get_pos() < non_log_event_ir_units.size()) {
+        if (try_consume_end_of_stream(reader)) {
+            break;
+        }
+        auto const result{deserializer.deserialize_next_ir_unit(reader)};
+        if (result.has_error() || clp::ffi::ir_stream::IrUnitType::LogEvent == result.value()) {
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_Corrupt,
+                    __FILENAME__,
+                    __LINE__,
+                    "Failed to replay the IR units in the imported index."
+            };
+        }
+    }
+
+    auto const num_log_events{index->timestamps.size()};
+    m_deserialized_log_events->reserve(num_log_events);
+    for (size_t i{0}; i < num_log_events; ++i) {
+        m_deserialized_log_events->emplace_back(index->log_levels[i], index->timestamps[i]);
+    }
+    m_lazy_log_events->restore(
+            std::move(index->ir_unit_begin_offsets),
+            std::move(index->ir_unit_end_offsets),
+            std::move(index->non_log_event_ir_units)
+    );
+    m_log_level_index.update(*m_deserialized_log_events);
+    m_timestamp_index.update(m_deserialized_log_events->get_timestamps());
+    m_num_bytes_deserialized = decompressed_size;
+    m_num_compressed_bytes_consumed = input.size();
+
+    m_detached_deserializer = std::make_unique<StructuredIrDeserializer>(std::move(deserializer));
+    m_stream_reader_data_context.reset(nullptr);
+    return true;
 }
 
 StructuredIrStreamReader::StructuredIrStreamReader(
         StreamReaderDataContext<StructuredIrDeserializer>&& stream_reader_data_context,
-        std::shared_ptr<StructuredLogEvents> deserialized_log_events
+        std::shared_ptr<StructuredLogEvents> deserialized_log_events,
+        std::unique_ptr<SeekableZstdInput> seekable_input,
+        std::shared_ptr<PackedStructuredLogEvents> packed_log_events,
+        std::shared_ptr<ReaderStats> stats,
+        std::shared_ptr<LogEventDiagnostics> diagnostics
 )
         : m_deserialized_log_events{std::move(deserialized_log_events)},
           m_stream_reader_data_context{
                   std::make_unique<StreamReaderDataContext<StructuredIrDeserializer>>(
                           std::move(stream_reader_data_context)
                   )
-          } {}
+          },
+          m_stats{std::move(stats)},
+          m_diagnostics{std::move(diagnostics)} {
+    if (nullptr != packed_log_events) {
+        m_lazy_log_events.emplace(std::move(packed_log_events));
+    } else if (false == m_deserialized_log_events->is_storing_log_events()) {
+        m_lazy_log_events.emplace(std::move(seekable_input));
+    }
+}
+
+auto StructuredIrStreamReader::get_deserializer() -> StructuredIrDeserializer& {
+    if (nullptr != m_stream_reader_data_context) {
+        return m_stream_reader_data_context->get_deserializer();
+    }
+    return *m_detached_deserializer;
+}
+
+auto StructuredIrStreamReader::get_log_event(size_t log_event_idx) const
+        -> StructuredLogEvent const& {
+    if (m_lazy_log_events.has_value()) {
+        return m_lazy_log_events->get_loaded_log_event(log_event_idx);
+    }
+    return m_deserialized_log_events->get_log_event(log_event_idx);
+}
+
+auto StructuredIrStreamReader::load_log_event(size_t log_event_idx) -> StructuredLogEvent const& {
+    if (m_lazy_log_events.has_value()) {
+        return m_lazy_log_events->load_log_event(log_event_idx, get_deserializer());
+    }
+    return m_deserialized_log_events->get_log_event(log_event_idx);
+}
+
+auto StructuredIrStreamReader::load_lazy_pages(size_t begin_idx, size_t end_idx, bool use_filter)
+        -> void {
+    if (false == m_lazy_log_events.has_value() || begin_idx >= end_idx) {
+        return;
+    }
+    if (use_filter) {
+        if (false == m_filtered_log_event_map.has_value()
+            || end_idx > m_filtered_log_event_map->size())
+        {
+            // Let the decode method report the invalid range.
+            return;
+        }
+    } else if (end_idx > m_deserialized_log_events->size()) {
+        return;
+    }
+
+    std::vector<size_t> page_indices;
+    for (auto i{begin_idx}; i < end_idx; ++i) {
+        auto const log_event_idx{use_filter ? m_filtered_log_event_map->at(i) : i};
+        auto const page_idx{LazyStructuredLogEvents::get_page_idx(log_event_idx)};
+        if (page_indices.empty() || page_indices.back() != page_idx) {
+            page_indices.emplace_back(page_idx);
+        }
+    }
+    m_lazy_log_events->load_pages(page_indices, get_deserializer());
+}
+
+auto StructuredIrStreamReader::load_lazy_pages(std::span<size_t const> log_event_indices)
+        -> void {
+    if (false == m_lazy_log_events.has_value()) {
+        return;
+    }
+    std::vector<size_t> page_indices;
+    page_indices.reserve(log_event_indices.size());
+    for (auto const log_event_idx : log_event_indices) {
+        page_indices.emplace_back(LazyStructuredLogEvents::get_page_idx(log_event_idx));
+    }
+    std::ranges::sort(page_indices);
+    auto const duplicates{std::ranges::unique(page_indices)};
+    page_indices.erase(duplicates.begin(), duplicates.end());
+    m_lazy_log_events->load_pages(page_indices, get_deserializer());
+}
+
+auto StructuredIrStreamReader::get_indexed_input() const -> SeekableZstdInput const& {
+    SeekableZstdInput const* seekable_input{nullptr};
+    if (m_lazy_log_events.has_value()) {
+        seekable_input = m_lazy_log_events->get_seekable_input();
+    }
+    if (nullptr == seekable_input) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "Indices are only supported by lazy readers over a seekable input."
+        };
+    }
+    return *seekable_input;
+}
+
+auto StructuredIrStreamReader::log_event_to_string(StructuredLogEvent const& log_event)
+        -> std::string {
+    // NOTE: The serializer's scratch space isn't thread-safe, and log events may be decoded in
+    // parallel (see `parallel_decode`).
+    thread_local StructuredLogEventJsonSerializer serializer;
+    std::string json_str;
+    if (serializer.serialize(log_event, json_str)) {
+        return json_str;
+    }
+
+    // Fall back to serializing through `nlohmann::json`, which handles edge cases (e.g., duplicate
+    // keys) and reports errors the same way as before.
+    auto const json_result{log_event.serialize_to_json()};
+    if (false == json_result.has_value()) {
+        auto error_code{json_result.error()};
+        SPDLOG_ERROR(
+                "Failed to deserialize log event to JSON: {}:{}",
+                error_code.category().name(),
+                error_code.message()
+        );
+        return std::string(cEmptyJsonStr);
+    }
+    return dump_json_with_replace(json_result.value());
+}
+
+auto StructuredIrStreamReader::log_event_to_projected_string(
+        StructuredLogEvent const& log_event,
+        std::span<std::vector<clp::ffi::SchemaTree::Node::id_t> const> projected_keys,
+        std::span<std::vector<std::string> const> key_paths
+) -> std::string {
+    // NOTE: See `log_event_to_string` for why the serializer is thread-local.
+    thread_local StructuredLogEventJsonSerializer serializer;
+    std::string json_str;
+    if (serializer.serialize_projection(log_event, projected_keys, json_str)) {
+        return json_str;
+    }
+
+    // Fall back to projecting the values from the `nlohmann::json` serialization of the log event.
+    auto const json_result{log_event.serialize_to_json()};
+    if (false == json_result.has_value()) {
+        auto error_code{json_result.error()};
+        SPDLOG_ERROR(
+                "Failed to deserialize log event to JSON: {}:{}",
+                error_code.category().name(),
+                error_code.message()
+        );
+        return std::string(cEmptyJsonArrayStr);
+    }
+    auto values{nlohmann::json::array()};
+    for (auto const& key_path : key_paths) {
+        auto const* value{&json_result.value()};
+        for (auto const& key : key_path) {
+            if (false == value->is_object()) {
+                value = nullptr;
+                break;
+            }
+            auto const it{value->find(key)};
+            if (value->end() == it) {
+                value = nullptr;
+                break;
+            }
+            value = &it.value();
+        }
+        values.emplace_back((nullptr == value) ? nlohmann::json{} : *value);
+    }
+    return dump_json_with_replace(values);
+}
 }  // namespace clp_ffi_js::ir
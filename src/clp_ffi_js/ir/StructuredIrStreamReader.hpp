@@ -4,43 +4,77 @@
 #include <cstddef>
 #include <memory>
 #include <optional>
+#include <span>
+#include <string>
+#include <vector>
 
-#include <clp/Array.hpp>
 #include <clp/ffi/ir_stream/Deserializer.hpp>
 #include <clp/ffi/SchemaTree.hpp>
 #include <clp/ir/types.hpp>
 #include <emscripten/val.h>
 
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/ChunkedReader.hpp>
+#include <clp_ffi_js/ir/ColumnarDecodeBuffers.hpp>
+#include <clp_ffi_js/ir/ExportBuffer.hpp>
+#include <clp_ffi_js/ir/FilterCache.hpp>
+#include <clp_ffi_js/ir/LazyStructuredLogEvents.hpp>
+#include <clp_ffi_js/ir/LogEventDiagnostics.hpp>
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+#include <clp_ffi_js/ir/LogLevelIndex.hpp>
+#include <clp_ffi_js/ir/PackedStructuredLogEvents.hpp>
+#include <clp_ffi_js/ir/ReaderStats.hpp>
+#include <clp_ffi_js/ir/RewindableReader.hpp>
+#include <clp_ffi_js/ir/SeekableZstdInput.hpp>
 #include <clp_ffi_js/ir/StreamReader.hpp>
 #include <clp_ffi_js/ir/StreamReaderDataContext.hpp>
 #include <clp_ffi_js/ir/StructuredIrUnitHandler.hpp>
+#include <clp_ffi_js/ir/TimestampIndex.hpp>
 
 namespace clp_ffi_js::ir {
 using schema_tree_node_id_t = std::optional<clp::ffi::SchemaTree::Node::id_t>;
-using StructuredIrDeserializer = clp::ffi::ir_stream::Deserializer<StructuredIrUnitHandler>;
 using StructuredLogEvents = LogEvents<StructuredLogEvent>;
 
 /**
  * Class to deserialize and decode Zstd-compressed CLP structured IR streams, as well as format
  * decoded log events.
+ *
+ * If the reader options set `lazy`, only each log event's filter fields and serialized IR unit are
+ * buffered, and log events are deserialized again on demand (see `LazyStructuredLogEvents`). If the
+ * input is also seekable, the IR units are decompressed again on demand too.
+ *
+ * Otherwise, if the reader options set `packed`, log events are packed into contiguous buffers with
+ * their repeated strings interned (see `PackedStructuredLogEvents`), and unpacked on demand.
  */
 class StructuredIrStreamReader : public StreamReader {
 public:
     /**
-     * @param zstd_decompressor A decompressor for an IR stream, where the read head of the stream
-     * is just after the stream's encoding type.
-     * @param data_array The array backing `zstd_decompressor`.
+     * @param input_reader The reader holding the compressed input backing `zstd_decompressor`.
+     * @param zstd_decompressor A decompressor for an IR stream, backing `reader`.
+     * @param reader A reader for the decompressed IR stream, where the read head of the stream is
+     * at the beginning of the stream.
      * @param reader_options
+     * @param seekable_input The compressed input, if it's complete and seekable, or nullptr. It's
+     * only used if the reader options set `lazy`.
+     * @param stats The stats that `reader` records in, and in which to record deserialization.
      * @return The created instance.
      * @throw ClpFfiJsException if any error occurs.
      */
     [[nodiscard]] static auto create(
+            std::unique_ptr<ChunkedReader>&& input_reader,
             std::unique_ptr<ZstdDecompressor>&& zstd_decompressor,
-            clp::Array<char> data_array,
-            ReaderOptions const& reader_options
+            std::unique_ptr<RewindableReader>&& reader,
+            ReaderOptions const& reader_options,
+            std::unique_ptr<SeekableZstdInput>&& seekable_input,
+            std::shared_ptr<ReaderStats> stats
     ) -> StructuredIrStreamReader;
 
+    /**
+     * @param reader_options
+     * @return Whether `reader_options` set `lazy`, i.e., whether a reader created with them uses a
+     * seekable input.
+     */
+    [[nodiscard]] static auto is_lazy(ReaderOptions const& reader_options) -> bool;
+
     // Destructor
     ~StructuredIrStreamReader() override = default;
 
@@ -61,8 +95,50 @@ public:
 
     [[nodiscard]] auto get_filtered_log_event_map() const -> FilteredLogEventMapTsType override;
 
+    [[nodiscard]] auto get_filtered_log_event_map_view() const
+            -> FilteredLogEventMapViewTsType override;
+
+    [[nodiscard]] auto get_filtered_log_event_map_generation() const -> size_t override {
+        return m_filter_cache.get_generation();
+    }
+
+    [[nodiscard]] auto get_log_event_idx(size_t filtered_log_event_idx) const
+            -> NullableLogEventIdx override;
+
+    [[nodiscard]] auto get_filtered_log_event_idx(size_t log_event_idx) const
+            -> NullableLogEventIdx override;
+
+    [[nodiscard]] auto get_memory_usage() const -> MemoryUsageTsType override;
+
+    [[nodiscard]] auto get_stats() const -> StatsTsType override;
+
+    [[nodiscard]] auto get_diagnostics() const -> DiagnosticsTsType override;
+
+    auto shrink_to_fit() -> void override;
+
     void filter_log_events(LogLevelFilterTsType const& log_level_filter) override;
 
+    [[nodiscard]] auto get_log_level_counts() const -> LogLevelCountsTsType override;
+
+    auto filter_log_events_by_time_range(
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts
+    ) -> size_t override;
+
+    auto clear_time_range() -> void override;
+
+    auto filter_log_events_by_predicate(PredicateTsType const& predicate) -> size_t override;
+
+    [[nodiscard]] auto get_time_histogram(
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts,
+            size_t num_buckets
+    ) const -> TimeHistogramTsType override;
+
+    [[nodiscard]] auto
+    search_log_events(std::string const& query, SearchOptionsTsType const& options)
+            -> size_t override;
+
     /**
      * @see StreamReader::deserialize_stream
      *
@@ -72,23 +148,167 @@ public:
      */
     [[nodiscard]] auto deserialize_stream() -> size_t override;
 
-    [[nodiscard]] auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
+    /**
+     * @see StreamReader::deserialize_next
+     *
+     * After the stream has been exhausted, it will be deallocated.
+     *
+     * @return @see StreamReader::deserialize_next
+     */
+    [[nodiscard]] auto deserialize_next(size_t max_num_events, size_t max_duration_ms)
+            -> DeserializationProgressTsType override;
+
+    [[nodiscard]] auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter)
             -> DecodedResultsTsType override;
 
+    [[nodiscard]] auto decode_range_columnar(size_t begin_idx, size_t end_idx, bool use_filter)
+            -> DecodedColumnarResultsTsType override;
+
+    [[nodiscard]] auto decode_range_projected(
+            size_t begin_idx,
+            size_t end_idx,
+            bool use_filter,
+            KeyPathsTsType const& key_paths
+    ) -> DecodedResultsTsType override;
+
+    auto begin_export(size_t begin_idx, size_t end_idx, bool use_filter) -> bool override;
+
+    [[nodiscard]] auto export_next_chunk() -> ExportChunkTsType override;
+
     [[nodiscard]] auto find_nearest_log_event_by_timestamp(clp::ir::epoch_time_ms_t target_ts
     ) -> NullableLogEventIdx override;
 
+    [[nodiscard]] auto get_timestamps() const
+            -> std::span<clp::ir::epoch_time_ms_t const> override;
+
+    [[nodiscard]] auto get_log_levels() const -> std::span<LogLevel const> override;
+
+    [[nodiscard]] auto get_timestamp_index() const -> TimestampIndex const& override {
+        return m_timestamp_index;
+    }
+
+    [[nodiscard]] auto get_log_level_index() const -> LogLevelIndex const& override {
+        return m_log_level_index;
+    }
+
+    [[nodiscard]] auto decode_log_events(std::span<size_t const> log_event_indices)
+            -> std::vector<std::string> override;
+
+protected:
+    [[nodiscard]] auto get_input_reader() -> ChunkedReader* override;
+
+    [[nodiscard]] auto export_index_blob() const -> std::vector<char> override;
+
+    auto import_index_blob(std::span<char const> blob) -> bool override;
+
 private:
+    // Methods
+    /**
+     * Deserializes log events from the stream until either the stream is exhausted or `budget` is
+     * exhausted.
+     *
+     * @param budget
+     * @throw ClpFfiJsException if an error occurs during deserialization.
+     */
+    auto deserialize(DeserializationBudget const& budget) -> void;
+
+    /**
+     * Serializes the given log event to a JSON string.
+     *
+     * @param log_event
+     * @return The serialized log event, or an empty JSON object if serialization fails.
+     */
+    [[nodiscard]] static auto log_event_to_string(StructuredLogEvent const& log_event)
+            -> std::string;
+
+    /**
+     * Serializes the values of the given keys in the log event to a JSON array.
+     *
+     * @param log_event
+     * @param projected_keys The schema-tree nodes of each key in `key_paths`.
+     * @param key_paths
+     * @return The serialized values, or an empty JSON array if serialization fails.
+     */
+    [[nodiscard]] static auto log_event_to_projected_string(
+            StructuredLogEvent const& log_event,
+            std::span<std::vector<clp::ffi::SchemaTree::Node::id_t> const> projected_keys,
+            std::span<std::vector<std::string> const> key_paths
+    ) -> std::string;
+
+    /**
+     * @return The stream's deserializer, which outlives the stream's data context in lazy mode.
+     */
+    [[nodiscard]] auto get_deserializer() -> StructuredIrDeserializer&;
+
+    /**
+     * @param log_event_idx
+     * @return The log event at the given index. In lazy mode, the log event's page must've been
+     * loaded.
+     */
+    [[nodiscard]] auto get_log_event(size_t log_event_idx) const -> StructuredLogEvent const&;
+
+    /**
+     * @param log_event_idx
+     * @return The log event at the given index, after loading its page in lazy mode. The log event
+     * is only valid until more pages are loaded.
+     * @throw ClpFfiJsException if a log event can't be deserialized again.
+     */
+    [[nodiscard]] auto load_log_event(size_t log_event_idx) -> StructuredLogEvent const&;
+
+    /**
+     * In lazy mode, loads the pages containing the log events in the range `[begin_idx, end_idx)`
+     * of the filtered or unfiltered log events collection. Invalid ranges are ignored.
+     *
+     * @param begin_idx
+     * @param end_idx
+     * @param use_filter
+     * @throw ClpFfiJsException if a log event can't be deserialized again.
+     */
+    auto load_lazy_pages(size_t begin_idx, size_t end_idx, bool use_filter) -> void;
+
+    /**
+     * In lazy mode, loads the pages containing the given log events.
+     *
+     * @param log_event_indices Indices of the log events in the unfiltered collection, in any
+     * order.
+     * @throw ClpFfiJsException if a log event can't be deserialized again.
+     */
+    auto load_lazy_pages(std::span<size_t const> log_event_indices) -> void;
+
+    /**
+     * @return The seekable input that the stream's index is tied to.
+     * @throw ClpFfiJsException if the reader isn't lazy or its input isn't seekable, so it doesn't
+     * support indices.
+     */
+    [[nodiscard]] auto get_indexed_input() const -> SeekableZstdInput const&;
+
     // Constructor
     explicit StructuredIrStreamReader(
             StreamReaderDataContext<StructuredIrDeserializer>&& stream_reader_data_context,
-            std::shared_ptr<StructuredLogEvents> deserialized_log_events
+            std::shared_ptr<StructuredLogEvents> deserialized_log_events,
+            std::unique_ptr<SeekableZstdInput> seekable_input,
+            std::shared_ptr<PackedStructuredLogEvents> packed_log_events,
+            std::shared_ptr<ReaderStats> stats,
+            std::shared_ptr<LogEventDiagnostics> diagnostics
     );
 
     // Variables
     std::shared_ptr<StructuredLogEvents> m_deserialized_log_events;
     std::unique_ptr<StreamReaderDataContext<StructuredIrDeserializer>> m_stream_reader_data_context;
     FilteredLogEventsMap m_filtered_log_event_map;
+    // NOTE: The cached filters reference the reader's members, so the reader must not be moved
+    // once a filter has been applied.
+    FilterCache m_filter_cache;
+    LogLevelIndex m_log_level_index;
+    TimestampIndex m_timestamp_index;
+    size_t m_num_bytes_deserialized{0};
+    size_t m_num_compressed_bytes_consumed{0};
+    ColumnarDecodeBuffers m_columnar_decode_buffers;
+    ExportBuffer m_export_buffer;
+    std::optional<LazyStructuredLogEvents> m_lazy_log_events;
+    std::unique_ptr<StructuredIrDeserializer> m_detached_deserializer;
+    std::shared_ptr<ReaderStats> m_stats;
+    std::shared_ptr<LogEventDiagnostics> m_diagnostics;
 };
 }  // namespace clp_ffi_js::ir
 
@@ -1,67 +1,51 @@
 #include "StructuredIrUnitHandler.hpp"
 
-#include <algorithm>
-#include <cctype>
 #include <cstddef>
-#include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
-#include <type_utils.hpp>
 #include <utility>
 
 #include <clp/ffi/ir_stream/decoding_methods.hpp>
 #include <clp/ffi/KeyValuePairLogEvent.hpp>
 #include <clp/ffi/SchemaTree.hpp>
 #include <clp/ffi/Value.hpp>
+#include <clp/ir/EncodedTextAst.hpp>
 #include <clp/ir/types.hpp>
 #include <clp/time_types.hpp>
 #include <emscripten/val.h>
-#include <spdlog/spdlog.h>
 
 #include <clp_ffi_js/constants.hpp>
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/LogEventDiagnostics.hpp>
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+#include <clp_ffi_js/ir/LogLevelResolver.hpp>
+#include <clp_ffi_js/ir/PackedStructuredLogEvents.hpp>
+#include <clp_ffi_js/ir/ReaderStats.hpp>
+#include <clp_ffi_js/ir/TimestampParser.hpp>
 
 namespace clp_ffi_js::ir {
-namespace {
-/**
- * Parses a string to determine the corresponding `LogLevel` enum value.
- * @param str
- * @return `LogLevel` enum corresponding to `str` if `str` matches a string in `cLogLevelNames`.
- * @return `LogLevel::NONE` otherwise.
- */
-auto parse_log_level(std::string_view str) -> LogLevel;
-
-auto parse_log_level(std::string_view str) -> LogLevel {
-    // Convert the string to uppercase.
-    std::string log_level_name_upper_case{str};
-    std::ranges::transform(
-            log_level_name_upper_case.begin(),
-            log_level_name_upper_case.end(),
-            log_level_name_upper_case.begin(),
-            [](unsigned char c) { return std::toupper(c); }
-    );
-
-    auto const* it = std::ranges::find(
-            cLogLevelNames.begin() + clp::enum_to_underlying_type(cValidLogLevelsBeginIdx),
-            cLogLevelNames.end(),
-            log_level_name_upper_case
-    );
-    if (it == cLogLevelNames.end()) {
-        return LogLevel::NONE;
-    }
-
-    return static_cast<LogLevel>(std::distance(cLogLevelNames.begin(), it));
-}
-}  // namespace
-
 auto StructuredIrUnitHandler::handle_log_event(StructuredLogEvent&& log_event
 ) -> clp::ffi::ir_stream::IRErrorCode {
+    m_stats->increment(ReaderCounter::NumEventsEmitted);
+    if (nullptr != m_replayed_log_events) {
+        m_replayed_log_events->emplace_back(std::move(log_event));
+        return clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Success;
+    }
+
+    ReaderStats::ScopedPhase const handling_phase{*m_stats, ReaderPhase::LogEventHandling};
     auto const& id_value_pairs{log_event.get_node_id_value_pairs()};
     auto const timestamp = get_timestamp(id_value_pairs);
     auto const log_level = get_log_level(id_value_pairs);
 
-    m_deserialized_log_events->emplace_back(std::move(log_event), log_level, timestamp);
+    if (m_deserialized_log_events->is_storing_log_events()) {
+        m_deserialized_log_events->emplace_back(std::move(log_event), log_level, timestamp);
+    } else {
+        if (nullptr != m_packed_log_events) {
+            m_packed_log_events->append(log_event);
+        }
+        m_deserialized_log_events->emplace_back(log_level, timestamp);
+    }
 
     return clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Success;
 }
@@ -70,7 +54,13 @@ auto StructuredIrUnitHandler::handle_utc_offset_change(
         [[maybe_unused]] clp::UtcOffset utc_offset_old,
         [[maybe_unused]] clp::UtcOffset utc_offset_new
 ) -> clp::ffi::ir_stream::IRErrorCode {
-    SPDLOG_WARN("UTC offset change packets aren't handled currently.");
+    // Replayed IR units were already recorded when they were first deserialized.
+    if (nullptr == m_replayed_log_events) {
+        m_diagnostics->record(
+                DiagnosticKind::UnhandledUtcOffsetChange,
+                m_deserialized_log_events->size()
+        );
+    }
     return clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Success;
 }
 
@@ -78,6 +68,9 @@ auto StructuredIrUnitHandler::handle_schema_tree_node_insertion(
         clp::ffi::SchemaTree::NodeLocator schema_tree_node_locator
 ) -> clp::ffi::ir_stream::IRErrorCode {
     ++m_current_node_id;
+    if (nullptr != m_packed_log_events) {
+        m_packed_log_events->insert_schema_tree_node(schema_tree_node_locator);
+    }
 
     auto const& key_name{schema_tree_node_locator.get_key_name()};
     if (key_name == m_log_level_key) {
@@ -105,23 +98,20 @@ auto StructuredIrUnitHandler::get_log_level(
     if (false == optional_log_level_value.has_value()) {
         return log_level;
     }
-    auto const log_level_value = optional_log_level_value.value();
+    auto const& log_level_value{optional_log_level_value.value()};
 
     if (log_level_value.is<std::string>()) {
-        auto const& log_level_str = log_level_value.get_immutable_view<std::string>();
-        log_level = parse_log_level(log_level_str);
+        log_level = m_log_level_resolver.resolve(
+                std::string_view{log_level_value.get_immutable_view<std::string>()}
+        );
     } else if (log_level_value.is<clp::ffi::value_int_t>()) {
-        auto const& log_level_int = log_level_value.get_immutable_view<clp::ffi::value_int_t>();
-        if (log_level_int >= clp::enum_to_underlying_type(cValidLogLevelsBeginIdx)
-            && log_level_int < clp::enum_to_underlying_type(LogLevel::LENGTH))
-        {
-            log_level = static_cast<LogLevel>(log_level_int);
-        }
+        log_level = m_log_level_resolver.resolve(
+                log_level_value.get_immutable_view<clp::ffi::value_int_t>()
+        );
     } else {
-        auto log_event_idx = m_deserialized_log_events->size();
-        SPDLOG_ERROR(
-                "Authoritative log level's value is not an int or string for log event index {}",
-                log_event_idx
+        m_diagnostics->record(
+                DiagnosticKind::InvalidLogLevelType,
+                m_deserialized_log_events->size()
         );
     }
 
@@ -130,31 +120,52 @@ auto StructuredIrUnitHandler::get_log_level(
 
 auto StructuredIrUnitHandler::get_timestamp(
         StructuredLogEvent::NodeIdValuePairs const& id_value_pairs
-) const -> clp::ir::epoch_time_ms_t {
-    clp::ir::epoch_time_ms_t timestamp{0};
-
+) -> clp::ir::epoch_time_ms_t {
     if (false == m_timestamp_node_id.has_value()) {
-        return timestamp;
+        return 0;
     }
     auto const& optional_timestamp_value{id_value_pairs.at(m_timestamp_node_id.value())};
     if (false == optional_timestamp_value.has_value()) {
-        return timestamp;
+        return 0;
     }
-    auto const timestamp_value = optional_timestamp_value.value();
+    auto const& timestamp_value{optional_timestamp_value.value()};
 
+    std::optional<clp::ir::epoch_time_ms_t> timestamp;
+    auto diagnostic_kind{DiagnosticKind::UnparsableTimestamp};
     if (timestamp_value.is<clp::ffi::value_int_t>()) {
-        timestamp = static_cast<clp::ir::epoch_time_ms_t>(
+        timestamp = TimestampParser::normalize_epoch(
                 timestamp_value.get_immutable_view<clp::ffi::value_int_t>()
         );
-    } else {
-        // TODO: Add support for parsing string-type timestamp values.
-        auto log_event_idx = m_deserialized_log_events->size();
-        SPDLOG_ERROR(
-                "Authoritative timestamp's value is not an int for log event index {}",
-                log_event_idx
+    } else if (timestamp_value.is<clp::ffi::value_float_t>()) {
+        timestamp = TimestampParser::normalize_epoch(
+                timestamp_value.get_immutable_view<clp::ffi::value_float_t>()
         );
+    } else if (timestamp_value.is<std::string>()) {
+        timestamp = m_timestamp_parser.parse(timestamp_value.get_immutable_view<std::string>());
+    } else if (timestamp_value.is<clp::ir::FourByteEncodedTextAst>()) {
+        auto const decoded{
+                timestamp_value.get_immutable_view<clp::ir::FourByteEncodedTextAst>()
+                        .decode_and_unparse()
+        };
+        if (decoded.has_value()) {
+            timestamp = m_timestamp_parser.parse(decoded.value());
+        }
+    } else if (timestamp_value.is<clp::ir::EightByteEncodedTextAst>()) {
+        auto const decoded{
+                timestamp_value.get_immutable_view<clp::ir::EightByteEncodedTextAst>()
+                        .decode_and_unparse()
+        };
+        if (decoded.has_value()) {
+            timestamp = m_timestamp_parser.parse(decoded.value());
+        }
+    } else {
+        diagnostic_kind = DiagnosticKind::InvalidTimestampType;
     }
 
-    return timestamp;
+    if (false == timestamp.has_value()) {
+        m_diagnostics->record(diagnostic_kind, m_deserialized_log_events->size());
+        return 0;
+    }
+    return timestamp.value();
 }
 }  // namespace clp_ffi_js::ir
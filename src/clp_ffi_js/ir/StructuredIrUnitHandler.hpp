@@ -15,7 +15,12 @@
 #include <clp/time_types.hpp>
 
 #include <clp_ffi_js/constants.hpp>
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/LogEventDiagnostics.hpp>
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+#include <clp_ffi_js/ir/LogLevelResolver.hpp>
+#include <clp_ffi_js/ir/PackedStructuredLogEvents.hpp>
+#include <clp_ffi_js/ir/ReaderStats.hpp>
+#include <clp_ffi_js/ir/TimestampParser.hpp>
 
 namespace clp_ffi_js::ir {
 using schema_tree_node_id_t = std::optional<clp::ffi::SchemaTree::Node::id_t>;
@@ -28,23 +33,49 @@ class StructuredIrUnitHandler {
 public:
     // Constructors
     /**
-     * @param deserialized_log_events The vector in which to store deserialized log events.
+     * @param deserialized_log_events The collection in which to store deserialized log events (or
+     * only their filter fields, if the collection doesn't store log events).
      * @param log_level_key Key name of schema-tree node that contains the authoritative log level.
      * @param timestamp_key Key name of schema-tree node that contains the authoritative timestamp.
+     * @param log_level_resolver Resolver for the values of the authoritative log level kv-pair.
+     * @param stats The stats in which to record the log events handled.
+     * @param diagnostics The diagnostics in which to record problems found in log events.
+     * @param packed_log_events The storage in which to pack log events (and mirror the schema
+     * tree), or nullptr if log events aren't packed.
      */
     StructuredIrUnitHandler(
-            std::shared_ptr<std::vector<LogEventWithFilterData<StructuredLogEvent>>>
-                    deserialized_log_events,
+            std::shared_ptr<LogEventsWithFilterData<StructuredLogEvent>> deserialized_log_events,
             std::string log_level_key,
-            std::string timestamp_key
+            std::string timestamp_key,
+            LogLevelResolver log_level_resolver,
+            std::shared_ptr<ReaderStats> stats,
+            std::shared_ptr<LogEventDiagnostics> diagnostics,
+            std::shared_ptr<PackedStructuredLogEvents> packed_log_events
     )
             : m_log_level_key{std::move(log_level_key)},
               m_timestamp_key{std::move(timestamp_key)},
-              m_deserialized_log_events{std::move(deserialized_log_events)} {}
+              m_log_level_resolver{std::move(log_level_resolver)},
+              m_deserialized_log_events{std::move(deserialized_log_events)},
+              m_stats{std::move(stats)},
+              m_diagnostics{std::move(diagnostics)},
+              m_packed_log_events{std::move(packed_log_events)} {}
+
+    // Methods
+    /**
+     * Redirects subsequent log events into `replayed_log_events`, without extracting their filter
+     * data, so that previously deserialized log events can be deserialized again.
+     *
+     * @param replayed_log_events The vector in which to store replayed log events, or nullptr to
+     * resume buffering log events normally.
+     */
+    auto set_replayed_log_events(std::vector<StructuredLogEvent>* replayed_log_events) -> void {
+        m_replayed_log_events = replayed_log_events;
+    }
 
     // Methods implementing `clp::ffi::ir_stream::IrUnitHandlerInterface`.
     /**
-     * Buffers the log event with filter data extracted.
+     * Buffers the log event with filter data extracted (packing the log event, if packed log events
+     * are set), or stores it in the replayed log events if set.
      * @param log_event
      * @return IRErrorCode::IRErrorCode_Success
      */
@@ -52,19 +83,20 @@ public:
     ) -> clp::ffi::ir_stream::IRErrorCode;
 
     /**
-     * Dummy implementation that does nothing but conforms to the interface.
+     * Records the change in the diagnostics, since UTC offset changes aren't applied to log events
+     * currently.
      * @param utc_offset_old
      * @param utc_offset_new
      * @return IRErrorCode::IRErrorCode_Success
      */
-    [[nodiscard]] static auto handle_utc_offset_change(
+    [[nodiscard]] auto handle_utc_offset_change(
             [[maybe_unused]] clp::UtcOffset utc_offset_old,
             [[maybe_unused]] clp::UtcOffset utc_offset_new
     ) -> clp::ffi::ir_stream::IRErrorCode;
 
     /**
      * Saves the node's ID if it corresponds to events' authoritative log level or timestamp
-     * kv-pair.
+     * kv-pair, and inserts the node into the packed log events' schema tree, if set.
      * @param schema_tree_node_locator
      * @return IRErrorCode::IRErrorCode_Success
      */
@@ -83,24 +115,26 @@ private:
     /**
      * @param id_value_pairs
      * @return `LogLevel::NONE` if `m_log_level_node_id` is unset, the node has no value, or the
-     * node's value is not an integer or string.
-     * @return `LogLevel` from node with id `m_log_level_node_id` otherwise.
+     * node's value is not an integer or string (which is recorded in the diagnostics).
+     * @return `LogLevel` resolved from the value of node with id `m_log_level_node_id` otherwise.
      */
     [[nodiscard]] auto get_log_level(StructuredLogEvent::NodeIdValuePairs const& id_value_pairs
     ) const -> LogLevel;
 
     /**
      * @param id_value_pairs
-     * @return 0 if `m_timestamp_node_id` is unset, the node has no value, or the node's value is
-     * not an integer.
-     * @return Timestamp from node with ID `m_timestamp_node_id` otherwise.
+     * @return 0 if `m_timestamp_node_id` is unset, the node has no value, or the node's value
+     * can't be parsed as a timestamp (see `TimestampParser`), which is recorded in the diagnostics.
+     * @return Timestamp in epoch milliseconds from node with ID `m_timestamp_node_id` otherwise.
      */
     [[nodiscard]] auto get_timestamp(StructuredLogEvent::NodeIdValuePairs const& id_value_pairs
-    ) const -> clp::ir::epoch_time_ms_t;
+    ) -> clp::ir::epoch_time_ms_t;
 
     // Variables
     std::string m_log_level_key;
     std::string m_timestamp_key;
+    LogLevelResolver m_log_level_resolver;
+    TimestampParser m_timestamp_parser;
 
     clp::ffi::SchemaTree::Node::id_t m_current_node_id{clp::ffi::SchemaTree::cRootId};
 
@@ -110,8 +144,11 @@ private:
     // TODO: Technically, we don't need to use a `shared_ptr` since the parent stream reader will
     // have a longer lifetime than this class. Instead, we could use `gsl::not_null` once we add
     // `gsl` into the project.
-    std::shared_ptr<std::vector<LogEventWithFilterData<StructuredLogEvent>>>
-            m_deserialized_log_events;
+    std::shared_ptr<LogEventsWithFilterData<StructuredLogEvent>> m_deserialized_log_events;
+    std::vector<StructuredLogEvent>* m_replayed_log_events{nullptr};
+    std::shared_ptr<ReaderStats> m_stats;
+    std::shared_ptr<LogEventDiagnostics> m_diagnostics;
+    std::shared_ptr<PackedStructuredLogEvents> m_packed_log_events;
 };
 }  // namespace clp_ffi_js::ir
 
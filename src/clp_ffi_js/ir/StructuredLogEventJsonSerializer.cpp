@@ -0,0 +1,490 @@
+#include "StructuredLogEventJsonSerializer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+#include <clp/ir/EncodedTextAst.hpp>
+#include <json/single_include/nlohmann/json.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+using clp::ffi::SchemaTree;
+
+constexpr std::string_view cReplacementCharacter{"\xEF\xBF\xBD"};
+constexpr std::string_view cHexDigits{"0123456789abcdef"};
+
+/**
+ * Decodes an encoded text AST value.
+ * @param value
+ * @param[out] decoded Returns the decoded string.
+ * @return Whether `value` is an encoded text AST and it was decoded successfully.
+ */
+[[nodiscard]] auto decode_encoded_text_ast(clp::ffi::Value const& value, std::string& decoded)
+        -> bool;
+
+/**
+ * Appends an escape sequence for the given ASCII character if JSON requires one.
+ * @param c
+ * @param output
+ * @return Whether an escape sequence was appended.
+ */
+[[nodiscard]] auto append_escaped_ascii_char(char c, std::string& output) -> bool;
+
+/**
+ * Gets the length and valid range of the second byte of the UTF-8 sequence starting with
+ * `lead_byte`, following the well-formed byte sequences in Table 3-7 of the Unicode standard.
+ * @param lead_byte
+ * @param[out] second_byte_min
+ * @param[out] second_byte_max
+ * @return The length of the sequence, or 0 if `lead_byte` can't start a sequence.
+ */
+[[nodiscard]] auto
+get_utf8_sequence_info(uint8_t lead_byte, uint8_t& second_byte_min, uint8_t& second_byte_max)
+        -> size_t;
+
+auto decode_encoded_text_ast(clp::ffi::Value const& value, std::string& decoded) -> bool {
+    std::optional<std::string> result;
+    if (value.is<clp::ir::FourByteEncodedTextAst>()) {
+        result = value.get_immutable_view<clp::ir::FourByteEncodedTextAst>().decode_and_unparse();
+    } else if (value.is<clp::ir::EightByteEncodedTextAst>()) {
+        result = value.get_immutable_view<clp::ir::EightByteEncodedTextAst>().decode_and_unparse();
+    }
+    if (false == result.has_value()) {
+        return false;
+    }
+    decoded = std::move(result.value());
+    return true;
+}
+
+auto append_escaped_ascii_char(char c, std::string& output) -> bool {
+    switch (c) {
+        case '\b':
+            output += "\\b";
+            return true;
+        case '\t':
+            output += "\\t";
+            return true;
+        case '\n':
+            output += "\\n";
+            return true;
+        case '\f':
+            output += "\\f";
+            return true;
+        case '\r':
+            output += "\\r";
+            return true;
+        case '"':
+            output += "\\\"";
+            return true;
+        case '\\':
+            output += "\\\\";
+            return true;
+        default:
+            break;
+    }
+
+    constexpr char cMaxControlChar{0x1F};
+    constexpr uint8_t cNibbleBitWidth{4};
+    constexpr uint8_t cNibbleMask{0xF};
+    if (c < 0 || c > cMaxControlChar) {
+        return false;
+    }
+    auto const byte{static_cast<uint8_t>(c)};
+    output += "\\u00";
+    output += cHexDigits[byte >> cNibbleBitWidth];
+    output += cHexDigits[byte & cNibbleMask];
+    return true;
+}
+
+auto get_utf8_sequence_info(uint8_t lead_byte, uint8_t& second_byte_min, uint8_t& second_byte_max)
+        -> size_t {
+    second_byte_min = 0x80;
+    second_byte_max = 0xBF;
+    if (lead_byte >= 0xC2 && lead_byte <= 0xDF) {
+        return 2;
+    }
+    if (lead_byte == 0xE0) {
+        second_byte_min = 0xA0;
+        return 3;
+    }
+    if ((lead_byte >= 0xE1 && lead_byte <= 0xEC) || lead_byte == 0xEE || lead_byte == 0xEF) {
+        return 3;
+    }
+    if (lead_byte == 0xED) {
+        second_byte_max = 0x9F;
+        return 3;
+    }
+    if (lead_byte == 0xF0) {
+        second_byte_min = 0x90;
+        return 4;
+    }
+    if (lead_byte >= 0xF1 && lead_byte <= 0xF3) {
+        return 4;
+    }
+    if (lead_byte == 0xF4) {
+        second_byte_max = 0x8F;
+        return 4;
+    }
+    return 0;
+}
+}  // namespace
+
+auto StructuredLogEventJsonSerializer::serialize(
+        clp::ffi::KeyValuePairLogEvent const& log_event,
+        std::string& output
+) -> bool {
+    if (false == collect_included_nodes(log_event)) {
+        return false;
+    }
+    return append_object(log_event, SchemaTree::cRootId, output);
+}
+
+auto StructuredLogEventJsonSerializer::serialize_projection(
+        clp::ffi::KeyValuePairLogEvent const& log_event,
+        std::span<std::vector<SchemaTree::Node::id_t> const> projected_keys,
+        std::string& output
+) -> bool {
+    auto const& schema_tree{log_event.get_schema_tree()};
+    auto const& node_id_value_pairs{log_event.get_node_id_value_pairs()};
+    // Objects are only serialized from the included nodes, so only collect them if needed.
+    bool are_included_nodes_collected{false};
+
+    output += '[';
+    bool is_first_value{true};
+    for (auto const& node_ids : projected_keys) {
+        if (false == is_first_value) {
+            output += ',';
+        }
+        is_first_value = false;
+
+        bool is_value_found{false};
+        for (auto const node_id : node_ids) {
+            if (node_id >= schema_tree.get_size()) {
+                continue;
+            }
+            auto const type{schema_tree.get_node(node_id).get_type()};
+            auto const pair_it{node_id_value_pairs.find(node_id)};
+            if (node_id_value_pairs.end() != pair_it) {
+                auto const& optional_value{pair_it->second};
+                if (false == optional_value.has_value()) {
+                    if (SchemaTree::Node::Type::Obj != type) {
+                        return false;
+                    }
+                    output += "{}";
+                } else if (false == append_value(type, optional_value.value(), output)) {
+                    return false;
+                }
+                is_value_found = true;
+                break;
+            }
+            if (SchemaTree::Node::Type::Obj != type) {
+                continue;
+            }
+
+            if (false == are_included_nodes_collected) {
+                if (false == collect_included_nodes(log_event)) {
+                    return false;
+                }
+                are_included_nodes_collected = true;
+            }
+            if (m_node_stamps[node_id] == m_current_stamp) {
+                // The object only has descendants with values.
+                if (false == append_object(log_event, node_id, output)) {
+                    return false;
+                }
+                is_value_found = true;
+                break;
+            }
+        }
+        if (false == is_value_found) {
+            output += "null";
+        }
+    }
+    output += ']';
+    return true;
+}
+
+auto StructuredLogEventJsonSerializer::resolve_key_path(
+        SchemaTree const& schema_tree,
+        std::span<std::string const> key_path
+) -> std::vector<SchemaTree::Node::id_t> {
+    std::vector<SchemaTree::Node::id_t> node_ids;
+    if (key_path.empty()) {
+        return node_ids;
+    }
+
+    // Every key but the last must be an object, and there's at most one object node with a given
+    // key under each parent.
+    auto parent_id{SchemaTree::cRootId};
+    for (auto const& key : key_path.first(key_path.size() - 1)) {
+        auto const parent_id_or_null{
+                schema_tree.try_get_node_id({parent_id, key, SchemaTree::Node::Type::Obj})
+        };
+        if (false == parent_id_or_null.has_value()) {
+            return node_ids;
+        }
+        parent_id = parent_id_or_null.value();
+    }
+
+    for (auto const child_id : schema_tree.get_node(parent_id).get_children_ids()) {
+        if (schema_tree.get_node(child_id).get_key_name() == key_path.back()) {
+            node_ids.emplace_back(child_id);
+        }
+    }
+    return node_ids;
+}
+
+auto StructuredLogEventJsonSerializer::append_escaped_string(
+        std::string_view str,
+        std::string& output
+) -> void {
+    output += '"';
+
+    size_t i{0};
+    auto const str_length{str.size()};
+    while (i < str_length) {
+        auto const c{str[i]};
+        auto const lead_byte{static_cast<uint8_t>(c)};
+        constexpr uint8_t cMaxAsciiByte{0x7F};
+        if (lead_byte <= cMaxAsciiByte) {
+            if (false == append_escaped_ascii_char(c, output)) {
+                output += c;
+            }
+            ++i;
+            continue;
+        }
+
+        uint8_t byte_min{0};
+        uint8_t byte_max{0};
+        auto const sequence_length{get_utf8_sequence_info(lead_byte, byte_min, byte_max)};
+        if (0 == sequence_length) {
+            output += cReplacementCharacter;
+            ++i;
+            continue;
+        }
+
+        size_t num_valid_bytes{1};
+        while (num_valid_bytes < sequence_length && i + num_valid_bytes < str_length) {
+            auto const byte{static_cast<uint8_t>(str[i + num_valid_bytes])};
+            if (byte < byte_min || byte > byte_max) {
+                break;
+            }
+            byte_min = 0x80;
+            byte_max = 0xBF;
+            ++num_valid_bytes;
+        }
+        if (num_valid_bytes == sequence_length) {
+            output += str.substr(i, sequence_length);
+        } else {
+            // Like nlohmann::json, replace the invalid prefix of the sequence with a single
+            // replacement character and then resume at the first byte that didn't fit.
+            output += cReplacementCharacter;
+        }
+        i += num_valid_bytes;
+    }
+
+    output += '"';
+}
+
+auto StructuredLogEventJsonSerializer::append_float(double value, std::string& output) -> void {
+    if (false == std::isfinite(value)) {
+        output += "null";
+        return;
+    }
+    // NOTE: We use nlohmann::json's own float formatter since its Grisu2 implementation doesn't
+    // always produce the same digits as other shortest round-trip algorithms.
+    constexpr size_t cBufferSize{64};
+    std::array<char, cBufferSize> buffer{};
+    auto* const end_ptr{
+            nlohmann::detail::to_chars(buffer.data(), buffer.data() + buffer.size(), value)
+    };
+    output.append(buffer.data(), static_cast<size_t>(end_ptr - buffer.data()));
+}
+
+auto StructuredLogEventJsonSerializer::collect_included_nodes(
+        clp::ffi::KeyValuePairLogEvent const& log_event
+) -> bool {
+    auto const& schema_tree{log_event.get_schema_tree()};
+    if (m_node_stamps.size() < schema_tree.get_size()) {
+        m_node_stamps.resize(schema_tree.get_size(), m_current_stamp);
+    }
+    ++m_current_stamp;
+    if (0 == m_current_stamp) {
+        // The stamp wrapped around, so old stamps could collide with new ones.
+        std::ranges::fill(m_node_stamps, 0);
+        m_current_stamp = 1;
+    }
+    m_included_nodes.clear();
+
+    // Include every node with a value, along with its ancestors (stopping at the first ancestor
+    // that's already included).
+    for (auto const& [node_id, optional_value] : log_event.get_node_id_value_pairs()) {
+        auto id{node_id};
+        while (m_node_stamps[id] != m_current_stamp) {
+            m_node_stamps[id] = m_current_stamp;
+            auto const& node{schema_tree.get_node(id)};
+            if (node.is_root()) {
+                if (id == node_id) {
+                    // The root can't have a value.
+                    return false;
+                }
+                break;
+            }
+            auto const parent_id{node.get_parent_id_unchecked()};
+            m_included_nodes.emplace_back(parent_id, node.get_key_name(), id);
+            id = parent_id;
+        }
+    }
+
+    std::ranges::sort(m_included_nodes, [](IncludedNode const& lhs, IncludedNode const& rhs) {
+        if (lhs.parent_id != rhs.parent_id) {
+            return lhs.parent_id < rhs.parent_id;
+        }
+        return lhs.key_name < rhs.key_name;
+    });
+    auto const duplicate_it{std::ranges::adjacent_find(
+            m_included_nodes,
+            [](IncludedNode const& lhs, IncludedNode const& rhs) {
+                return lhs.parent_id == rhs.parent_id && lhs.key_name == rhs.key_name;
+            }
+    )};
+    return duplicate_it == m_included_nodes.end();
+}
+
+auto StructuredLogEventJsonSerializer::append_object(
+        clp::ffi::KeyValuePairLogEvent const& log_event,
+        SchemaTree::Node::id_t parent_id,
+        std::string& output
+) const -> bool {
+    auto const& schema_tree{log_event.get_schema_tree()};
+    auto const& node_id_value_pairs{log_event.get_node_id_value_pairs()};
+
+    auto pos{static_cast<size_t>(
+            std::ranges::lower_bound(
+                    m_included_nodes,
+                    parent_id,
+                    {},
+                    &IncludedNode::parent_id
+            )
+            - m_included_nodes.begin()
+    )};
+
+    output += '{';
+    bool is_first_child{true};
+    while (pos < m_included_nodes.size() && m_included_nodes[pos].parent_id == parent_id) {
+        auto const& child{m_included_nodes[pos]};
+        ++pos;
+
+        if (false == is_first_child) {
+            output += ',';
+        }
+        is_first_child = false;
+        append_escaped_string(child.key_name, output);
+        output += ':';
+
+        auto const pair_it{node_id_value_pairs.find(child.id)};
+        if (node_id_value_pairs.end() == pair_it) {
+            // The child only has descendants with values.
+            if (false == append_object(log_event, child.id, output)) {
+                return false;
+            }
+            continue;
+        }
+
+        auto const type{schema_tree.get_node(child.id).get_type()};
+        auto const& optional_value{pair_it->second};
+        if (false == optional_value.has_value()) {
+            if (SchemaTree::Node::Type::Obj != type) {
+                return false;
+            }
+            output += "{}";
+            continue;
+        }
+        if (false == append_value(type, optional_value.value(), output)) {
+            return false;
+        }
+    }
+    output += '}';
+    return true;
+}
+
+auto StructuredLogEventJsonSerializer::append_value(
+        SchemaTree::Node::Type type,
+        clp::ffi::Value const& value,
+        std::string& output
+) -> bool {
+    switch (type) {
+        case SchemaTree::Node::Type::Int: {
+            if (false == value.is<clp::ffi::value_int_t>()) {
+                return false;
+            }
+            constexpr size_t cBufferSize{24};
+            std::array<char, cBufferSize> buffer{};
+            auto const [end_ptr, ec]{std::to_chars(
+                    buffer.data(),
+                    buffer.data() + buffer.size(),
+                    value.get_immutable_view<clp::ffi::value_int_t>()
+            )};
+            output.append(buffer.data(), end_ptr);
+            return true;
+        }
+        case SchemaTree::Node::Type::Float:
+            if (false == value.is<clp::ffi::value_float_t>()) {
+                return false;
+            }
+            append_float(value.get_immutable_view<clp::ffi::value_float_t>(), output);
+            return true;
+        case SchemaTree::Node::Type::Bool:
+            if (false == value.is<clp::ffi::value_bool_t>()) {
+                return false;
+            }
+            output += value.get_immutable_view<clp::ffi::value_bool_t>() ? "true" : "false";
+            return true;
+        case SchemaTree::Node::Type::Str: {
+            if (value.is<std::string>()) {
+                append_escaped_string(value.get_immutable_view<std::string>(), output);
+                return true;
+            }
+            std::string decoded;
+            if (false == decode_encoded_text_ast(value, decoded)) {
+                return false;
+            }
+            append_escaped_string(decoded, output);
+            return true;
+        }
+        case SchemaTree::Node::Type::UnstructuredArray: {
+            std::string decoded;
+            if (false == decode_encoded_text_ast(value, decoded)) {
+                return false;
+            }
+            // Unstructured arrays are rare, so we round-trip them through `nlohmann::json` to
+            // match its normalization of their contents exactly.
+            auto const array{nlohmann::json::parse(decoded, nullptr, false)};
+            if (array.is_discarded()) {
+                return false;
+            }
+            output += array.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+            return true;
+        }
+        case SchemaTree::Node::Type::Obj:
+            output += "null";
+            return true;
+        default:
+            return false;
+    }
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,157 @@
+#ifndef CLP_FFI_JS_IR_STRUCTUREDLOGEVENTJSONSERIALIZER_HPP
+#define CLP_FFI_JS_IR_STRUCTUREDLOGEVENTJSONSERIALIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Serializes `clp::ffi::KeyValuePairLogEvent`s into JSON text by walking the schema tree and the
+ * event's node-ID-value pairs directly, rather than building a `nlohmann::json` DOM first.
+ *
+ * The output is byte-for-byte identical to dumping the DOM returned by
+ * `KeyValuePairLogEvent::serialize_to_json` using `nlohmann::json::dump` with
+ * `error_handler_t::replace`:
+ * - object keys are sorted;
+ * - invalid UTF-8 sequences are replaced with U+FFFD;
+ * - numbers are formatted the same way.
+ *
+ * The serializer keeps scratch space between calls, so a single instance should be reused across
+ * log events. It isn't thread-safe.
+ */
+class StructuredLogEventJsonSerializer {
+public:
+    // Methods
+    /**
+     * Serializes the given log event and appends it to `output`.
+     *
+     * @param log_event
+     * @param output
+     * @return Whether the log event was serialized. On failure, `output` is left in an unspecified
+     * state, and callers should fall back to `KeyValuePairLogEvent::serialize_to_json` (e.g., to
+     * report the error). Failure happens if:
+     * - the log event contains a value that doesn't match its schema-tree node's type;
+     * - an encoded text AST can't be decoded;
+     * - an unstructured array isn't valid JSON;
+     * - there are sibling keys with the same name.
+     */
+    [[nodiscard]] auto
+    serialize(clp::ffi::KeyValuePairLogEvent const& log_event, std::string& output) -> bool;
+
+    /**
+     * Serializes the values of the given keys in the log event as a JSON array and appends it to
+     * `output`. Each element is the value of the corresponding key (an object if the key's node is
+     * an object with descendants that have values), or null if the log event doesn't contain the
+     * key.
+     *
+     * @param log_event
+     * @param projected_keys The schema-tree nodes of each key, as returned by `resolve_key_path`.
+     * @param output
+     * @return Whether the values were serialized. See `serialize` for the causes of failure and how
+     * callers should handle it.
+     */
+    [[nodiscard]] auto serialize_projection(
+            clp::ffi::KeyValuePairLogEvent const& log_event,
+            std::span<std::vector<clp::ffi::SchemaTree::Node::id_t> const> projected_keys,
+            std::string& output
+    ) -> bool;
+
+    /**
+     * Resolves a key path to the schema-tree nodes it may refer to. Since a key's node also
+     * depends on its value's type, a key path may resolve to multiple nodes (although at most one
+     * of them has a value in any given log event).
+     *
+     * @param schema_tree
+     * @param key_path The keys from the root of the log event to the value.
+     * @return The IDs of the nodes, which is empty if no node matches the key path.
+     */
+    [[nodiscard]] static auto resolve_key_path(
+            clp::ffi::SchemaTree const& schema_tree,
+            std::span<std::string const> key_path
+    ) -> std::vector<clp::ffi::SchemaTree::Node::id_t>;
+
+    /**
+     * Appends the given string to `output` as a JSON string, escaped and with invalid UTF-8
+     * sequences replaced in the same way as `nlohmann::json::dump`.
+     *
+     * @param str
+     * @param output
+     */
+    static auto append_escaped_string(std::string_view str, std::string& output) -> void;
+
+    /**
+     * Appends the given float to `output` in the same format as `nlohmann::json::dump`.
+     *
+     * @param value
+     * @param output
+     */
+    static auto append_float(double value, std::string& output) -> void;
+
+private:
+    // Types
+    /**
+     * A schema-tree node that's part of the log event being serialized.
+     */
+    struct IncludedNode {
+        clp::ffi::SchemaTree::Node::id_t parent_id;
+        std::string_view key_name;
+        clp::ffi::SchemaTree::Node::id_t id;
+    };
+
+    // Methods
+    /**
+     * Collects the nodes with values in `log_event`, along with their ancestors, into
+     * `m_included_nodes` sorted by parent and then key.
+     *
+     * @param log_event
+     * @return Whether the nodes were collected successfully.
+     */
+    [[nodiscard]] auto collect_included_nodes(clp::ffi::KeyValuePairLogEvent const& log_event)
+            -> bool;
+
+    /**
+     * Appends the JSON object containing the included children of `parent_id`.
+     *
+     * @param log_event
+     * @param parent_id
+     * @param output
+     * @return Whether the object was serialized successfully.
+     */
+    [[nodiscard]] auto append_object(
+            clp::ffi::KeyValuePairLogEvent const& log_event,
+            clp::ffi::SchemaTree::Node::id_t parent_id,
+            std::string& output
+    ) const -> bool;
+
+    /**
+     * Appends the given value as JSON.
+     *
+     * @param type The type of the value's schema-tree node.
+     * @param value
+     * @param output
+     * @return Whether the value was serialized successfully.
+     */
+    [[nodiscard]] static auto append_value(
+            clp::ffi::SchemaTree::Node::Type type,
+            clp::ffi::Value const& value,
+            std::string& output
+    ) -> bool;
+
+    // Variables
+    std::vector<IncludedNode> m_included_nodes;
+
+    // Per-node stamps for marking nodes as included without clearing the vector for every event.
+    std::vector<uint32_t> m_node_stamps;
+    uint32_t m_current_stamp{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_STRUCTUREDLOGEVENTJSONSERIALIZER_HPP
@@ -0,0 +1,112 @@
+#include "TextQuery.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <format>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/TraceableException.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+/**
+ * Lowercases the ASCII letters in `text`, writing the result to `folded_text`.
+ * @param text
+ * @param folded_text
+ */
+auto fold_case(std::string_view text, std::string& folded_text) -> void;
+
+auto fold_case(std::string_view text, std::string& folded_text) -> void {
+    folded_text.resize(text.size());
+    std::ranges::transform(text, folded_text.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+}
+}  // namespace
+
+TextQuery::TextQuery(std::string query, bool case_sensitive, bool is_regex)
+        : m_case_sensitive{case_sensitive} {
+    if (is_regex) {
+        auto flags{std::regex::ECMAScript | std::regex::optimize};
+        if (false == case_sensitive) {
+            flags |= std::regex::icase;
+        }
+        try {
+            m_regex.emplace(query, flags);
+        } catch (std::regex_error const& e) {
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_BadParam,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format("Invalid regular expression \"{}\": {}", query, e.what())
+            };
+        }
+    }
+
+    if (case_sensitive) {
+        m_query = std::move(query);
+    } else {
+        fold_case(query, m_query);
+    }
+}
+
+auto TextQuery::matches(std::string_view text) const -> bool {
+    if (m_regex.has_value()) {
+        return std::regex_search(text.begin(), text.end(), m_regex.value());
+    }
+    return contains_query(text);
+}
+
+auto TextQuery::match_logtype(std::string_view logtype) const -> LogtypeMatch {
+    if (m_regex.has_value()) {
+        return LogtypeMatch::Unknown;
+    }
+
+    // Split the logtype into the constant segments between variable placeholders, unescaping any
+    // escaped placeholder characters.
+    std::string segment;
+    bool has_variables{false};
+    for (size_t i{0}; i < logtype.size(); ++i) {
+        auto const c{logtype[i]};
+        switch (static_cast<clp::ir::VariablePlaceholder>(c)) {
+            case clp::ir::VariablePlaceholder::Escape:
+                ++i;
+                if (i < logtype.size()) {
+                    segment += logtype[i];
+                }
+                break;
+            case clp::ir::VariablePlaceholder::Integer:
+            case clp::ir::VariablePlaceholder::Dictionary:
+            case clp::ir::VariablePlaceholder::Float:
+                if (contains_query(segment)) {
+                    return LogtypeMatch::Always;
+                }
+                segment.clear();
+                has_variables = true;
+                break;
+            default:
+                segment += c;
+                break;
+        }
+    }
+    if (contains_query(segment)) {
+        return LogtypeMatch::Always;
+    }
+    return has_variables ? LogtypeMatch::Unknown : LogtypeMatch::Never;
+}
+
+auto TextQuery::contains_query(std::string_view text) const -> bool {
+    if (m_case_sensitive) {
+        return std::string_view::npos != text.find(m_query);
+    }
+    fold_case(text, m_folded_text);
+    return std::string::npos != m_folded_text.find(m_query);
+}
+}  // namespace clp_ffi_js::ir
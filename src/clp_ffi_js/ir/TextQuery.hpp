@@ -0,0 +1,86 @@
+#ifndef CLP_FFI_JS_IR_TEXTQUERY_HPP
+#define CLP_FFI_JS_IR_TEXTQUERY_HPP
+
+#include <cstdint>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+
+namespace clp_ffi_js::ir {
+/**
+ * A query that matches text containing a substring or, optionally, a regular expression.
+ *
+ * Regular expressions use `std::regex`'s ECMAScript grammar, which is close to, but not the same
+ * as, JS's `RegExp`:
+ * - It lacks newer `RegExp` features, e.g., lookbehind assertions, named groups, Unicode property
+ *   escapes, and the `s` and `u` flags.
+ * - It matches bytes rather than UTF-16 code units, so `.` matches a single byte of a multi-byte
+ *   UTF-8 character.
+ * - It's evaluated by backtracking, so some patterns (e.g., nested quantifiers) take time
+ *   exponential in the length of the text, and even simple patterns are much slower than substring
+ *   queries over large streams.
+ *
+ * NOTE: Case-insensitive matching only folds ASCII letters.
+ */
+class TextQuery {
+public:
+    // Types
+    /**
+     * Whether every message with a given logtype matches the query.
+     */
+    enum class LogtypeMatch : uint8_t {
+        Always,
+        Never,
+        // The message has to be decoded to tell.
+        Unknown,
+    };
+
+    // Constructor
+    /**
+     * @param query
+     * @param case_sensitive
+     * @param is_regex Whether `query` is a regular expression rather than a substring.
+     * @throw ClpFfiJsException if `query` is an invalid regular expression.
+     */
+    TextQuery(std::string query, bool case_sensitive, bool is_regex);
+
+    // Methods
+    /**
+     * NOTE: This method isn't thread-safe since it reuses a scratch buffer.
+     *
+     * @param text
+     * @return Whether `text` matches the query.
+     */
+    [[nodiscard]] auto matches(std::string_view text) const -> bool;
+
+    /**
+     * Determines whether a message with the given logtype matches the query using only the
+     * logtype's constant text, i.e., without decoding any variables.
+     *
+     * @param logtype An encoded logtype, containing variable placeholders.
+     * @return LogtypeMatch::Always if the query is a substring that's contained in one of the
+     * logtype's constant segments.
+     * @return LogtypeMatch::Never if the logtype has no variables and doesn't match the query.
+     * @return LogtypeMatch::Unknown otherwise (including for all regex queries).
+     */
+    [[nodiscard]] auto match_logtype(std::string_view logtype) const -> LogtypeMatch;
+
+private:
+    // Methods
+    /**
+     * @param text
+     * @return Whether `text` contains the query as a substring.
+     */
+    [[nodiscard]] auto contains_query(std::string_view text) const -> bool;
+
+    // Variables
+    // Lowercased if matching is case-insensitive.
+    std::string m_query;
+    bool m_case_sensitive;
+    std::optional<std::regex> m_regex;
+    mutable std::string m_folded_text;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_TEXTQUERY_HPP
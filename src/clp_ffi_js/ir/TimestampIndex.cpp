@@ -0,0 +1,257 @@
+#include "TimestampIndex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+
+namespace {
+/**
+ * Same as `std::is_sorted`, except the timestamps are compared in fixed-size blocks without exiting
+ * early within a block, so that the compiler may vectorize the comparisons (e.g., with simd128).
+ *
+ * @param timestamps
+ * @return Whether the timestamps are in non-descending order.
+ */
+[[nodiscard]] auto are_sorted(std::span<clp::ir::epoch_time_ms_t const> timestamps) -> bool;
+
+/**
+ * Binary searches the given sorted timestamps for the first one for which `is_before` returns
+ * false, like `std::partition_point`.
+ *
+ * The search narrows the range by a fixed half each step, which the compiler may turn into a
+ * conditional move, until it's at most `cLinearScanSize` timestamps. It then counts the remaining
+ * timestamps for which `is_before` returns true with a linear scan.
+ *
+ * @tparam IsBeforeFunc
+ * @param timestamps
+ * @param is_before
+ * @return The position of the first timestamp for which `is_before` returns false.
+ */
+template <typename IsBeforeFunc>
+[[nodiscard]] auto find_partition_point(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        IsBeforeFunc is_before
+) -> size_t;
+
+auto are_sorted(std::span<clp::ir::epoch_time_ms_t const> timestamps) -> bool {
+    constexpr size_t cBlockSize{1024};
+    for (size_t block_begin_idx{1}; block_begin_idx < timestamps.size();
+         block_begin_idx += cBlockSize)
+    {
+        auto const block_end_idx{std::min(timestamps.size(), block_begin_idx + cBlockSize)};
+        bool is_out_of_order{false};
+        for (auto i{block_begin_idx}; i < block_end_idx; ++i) {
+            is_out_of_order |= timestamps[i] < timestamps[i - 1];
+        }
+        if (is_out_of_order) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename IsBeforeFunc>
+auto find_partition_point(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        IsBeforeFunc is_before
+) -> size_t {
+    constexpr size_t cLinearScanSize{16};
+
+    // The partition point is always in `[begin_idx, begin_idx + length]`.
+    size_t begin_idx{0};
+    size_t length{timestamps.size()};
+    while (length > cLinearScanSize) {
+        auto const half{length / 2};
+        begin_idx = is_before(timestamps[begin_idx + half]) ? begin_idx + half : begin_idx;
+        length -= half;
+    }
+
+    size_t num_before{0};
+    for (auto i{begin_idx}; i < begin_idx + length; ++i) {
+        num_before += is_before(timestamps[i]) ? 1 : 0;
+    }
+    return begin_idx + num_before;
+}
+}  // namespace
+
+namespace clp_ffi_js::ir {
+auto TimestampIndex::update(std::span<clp::ir::epoch_time_ms_t const> timestamps) -> void {
+    auto const num_previously_indexed{m_num_indexed_log_events};
+    m_num_indexed_log_events = timestamps.size();
+    if (m_is_sorted) {
+        // Include the last previously indexed timestamp so that we detect an out-of-order boundary
+        // between batches.
+        auto const check_begin_idx{num_previously_indexed > 0 ? num_previously_indexed - 1 : 0};
+        if (are_sorted(timestamps.subspan(check_begin_idx))) {
+            return;
+        }
+        m_is_sorted = false;
+
+        // The previously indexed timestamps are in order, so their indices are already sorted.
+        m_sorted_log_event_indices.resize(num_previously_indexed);
+        std::iota(m_sorted_log_event_indices.begin(), m_sorted_log_event_indices.end(), 0);
+    }
+
+    auto const num_sorted{m_sorted_log_event_indices.size()};
+    m_sorted_log_event_indices.resize(timestamps.size());
+    auto const new_indices_begin{
+            m_sorted_log_event_indices.begin() + static_cast<std::ptrdiff_t>(num_sorted)
+    };
+    std::iota(new_indices_begin, m_sorted_log_event_indices.end(), num_sorted);
+
+    auto const compare = [&](size_t lhs, size_t rhs) { return timestamps[lhs] < timestamps[rhs]; };
+    std::stable_sort(new_indices_begin, m_sorted_log_event_indices.end(), compare);
+    std::inplace_merge(
+            m_sorted_log_event_indices.begin(),
+            new_indices_begin,
+            m_sorted_log_event_indices.end(),
+            compare
+    );
+}
+
+auto TimestampIndex::find_nearest_log_event(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        clp::ir::epoch_time_ms_t target_ts
+) const -> std::optional<size_t> {
+    if (0 == m_num_indexed_log_events) {
+        return std::nullopt;
+    }
+
+    auto const first_greater_pos{upper_bound(timestamps, target_ts)};
+    if (0 == first_greater_pos) {
+        return get_log_event_idx(0);
+    }
+    return get_log_event_idx(first_greater_pos - 1);
+}
+
+auto TimestampIndex::get_log_event_indices(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        clp::ir::epoch_time_ms_t begin_ts,
+        clp::ir::epoch_time_ms_t end_ts,
+        std::vector<size_t>& log_event_indices
+) const -> void {
+    log_event_indices.clear();
+    if (begin_ts >= end_ts) {
+        return;
+    }
+
+    auto const begin_pos{lower_bound(timestamps, begin_ts)};
+    auto const end_pos{lower_bound(timestamps, end_ts)};
+    log_event_indices.resize(end_pos - begin_pos);
+    if (m_is_sorted) {
+        std::iota(log_event_indices.begin(), log_event_indices.end(), begin_pos);
+        return;
+    }
+
+    std::copy(
+            m_sorted_log_event_indices.begin() + static_cast<std::ptrdiff_t>(begin_pos),
+            m_sorted_log_event_indices.begin() + static_cast<std::ptrdiff_t>(end_pos),
+            log_event_indices.begin()
+    );
+    std::ranges::sort(log_event_indices);
+}
+
+auto TimestampIndex::get_histogram(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        clp::ir::epoch_time_ms_t begin_ts,
+        clp::ir::epoch_time_ms_t end_ts,
+        size_t num_buckets
+) const -> std::vector<size_t> {
+    if (begin_ts >= end_ts) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_BadParam,
+                __FILENAME__,
+                __LINE__,
+                std::format("Invalid time range: [{}, {})", begin_ts, end_ts)
+        };
+    }
+    if (0 == num_buckets || num_buckets > cMaxNumHistogramBuckets) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_BadParam,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Number of histogram buckets must be in [1, {}]: {}",
+                        cMaxNumHistogramBuckets,
+                        num_buckets
+                )
+        };
+    }
+
+    // Compute each bucket boundary as `begin_ts + width * i / num_buckets` without overflowing, by
+    // splitting `width` into its quotient and remainder by `num_buckets`. The remainder's product
+    // can't overflow since both factors are at most `cMaxNumHistogramBuckets`. Note that the last
+    // boundary is exactly `end_ts`.
+    auto const width{static_cast<uint64_t>(end_ts) - static_cast<uint64_t>(begin_ts)};
+    auto const width_quotient{width / num_buckets};
+    auto const width_remainder{width % num_buckets};
+    auto get_boundary = [&](size_t bucket_idx) -> clp::ir::epoch_time_ms_t {
+        auto const offset{width_quotient * bucket_idx + width_remainder * bucket_idx / num_buckets};
+        return static_cast<clp::ir::epoch_time_ms_t>(static_cast<uint64_t>(begin_ts) + offset);
+    };
+
+    std::vector<size_t> counts(num_buckets);
+    auto bucket_begin_pos{lower_bound(timestamps, begin_ts)};
+    for (size_t bucket_idx{0}; bucket_idx < num_buckets; ++bucket_idx) {
+        auto const bucket_end_pos{lower_bound(timestamps, get_boundary(bucket_idx + 1))};
+        counts[bucket_idx] = bucket_end_pos - bucket_begin_pos;
+        bucket_begin_pos = bucket_end_pos;
+    }
+    return counts;
+}
+
+auto TimestampIndex::lower_bound(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        clp::ir::epoch_time_ms_t target_ts
+) const -> size_t {
+    auto const indexed_timestamps{timestamps.first(m_num_indexed_log_events)};
+    if (m_is_sorted) {
+        return find_partition_point(
+                indexed_timestamps,
+                [target_ts](clp::ir::epoch_time_ms_t timestamp) { return timestamp < target_ts; }
+        );
+    }
+    return static_cast<size_t>(std::distance(
+            m_sorted_log_event_indices.begin(),
+            std::ranges::lower_bound(
+                    m_sorted_log_event_indices,
+                    target_ts,
+                    {},
+                    [&](size_t log_event_idx) { return timestamps[log_event_idx]; }
+            )
+    ));
+}
+
+auto TimestampIndex::upper_bound(
+        std::span<clp::ir::epoch_time_ms_t const> timestamps,
+        clp::ir::epoch_time_ms_t target_ts
+) const -> size_t {
+    auto const indexed_timestamps{timestamps.first(m_num_indexed_log_events)};
+    if (m_is_sorted) {
+        return find_partition_point(
+                indexed_timestamps,
+                [target_ts](clp::ir::epoch_time_ms_t timestamp) { return timestamp <= target_ts; }
+        );
+    }
+    return static_cast<size_t>(std::distance(
+            m_sorted_log_event_indices.begin(),
+            std::ranges::upper_bound(
+                    m_sorted_log_event_indices,
+                    target_ts,
+                    {},
+                    [&](size_t log_event_idx) { return timestamps[log_event_idx]; }
+            )
+    ));
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,142 @@
+#ifndef CLP_FFI_JS_IR_TIMESTAMPINDEX_HPP
+#define CLP_FFI_JS_IR_TIMESTAMPINDEX_HPP
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Index of the log events in a stream by timestamp, supporting point and range lookups in
+ * O(log n).
+ *
+ * Most streams are already in chronological order, in which case the index is just the stream's
+ * timestamp column. Once an out-of-order timestamp is seen, the index additionally keeps the log
+ * event indices stably sorted by timestamp (i.e., log events with equal timestamps remain in
+ * stream order).
+ *
+ * The index is built incrementally as log events are deserialized. All methods take the stream's
+ * timestamp column, which must be the same column each time and must only ever be appended to.
+ */
+class TimestampIndex {
+public:
+    // Constants
+    static constexpr size_t cMaxNumHistogramBuckets{1ULL << 16U};
+
+    // Methods
+    /**
+     * Indexes the timestamps in `timestamps` that haven't been indexed yet.
+     *
+     * @param timestamps
+     */
+    auto update(std::span<clp::ir::epoch_time_ms_t const> timestamps) -> void;
+
+    /**
+     * @return Whether the indexed timestamps are in chronological order.
+     */
+    [[nodiscard]] auto is_sorted() const -> bool { return m_is_sorted; }
+
+    [[nodiscard]] auto get_num_indexed_log_events() const -> size_t {
+        return m_num_indexed_log_events;
+    }
+
+    /**
+     * @param pos A position in chronological order, less than the number of indexed log events.
+     * @return The index of the log event at the given position.
+     */
+    [[nodiscard]] auto get_log_event_idx(size_t pos) const -> size_t {
+        return m_is_sorted ? pos : m_sorted_log_event_indices[pos];
+    }
+
+    /**
+     * @param timestamps
+     * @param target_ts
+     * @return The index of the last log event, in chronological order, with a timestamp less than
+     * or equal to `target_ts`, or the first such log event if there's none.
+     * @return std::nullopt if there are no indexed log events.
+     */
+    [[nodiscard]] auto find_nearest_log_event(
+            std::span<clp::ir::epoch_time_ms_t const> timestamps,
+            clp::ir::epoch_time_ms_t target_ts
+    ) const -> std::optional<size_t>;
+
+    /**
+     * Collects the indices of the log events with timestamps in the range `[begin_ts, end_ts)`.
+     *
+     * @param timestamps
+     * @param begin_ts
+     * @param end_ts
+     * @param[out] log_event_indices Returns the indices of the selected log events, in ascending
+     * order.
+     */
+    auto get_log_event_indices(
+            std::span<clp::ir::epoch_time_ms_t const> timestamps,
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts,
+            std::vector<size_t>& log_event_indices
+    ) const -> void;
+
+    /**
+     * Counts the log events in each of `num_buckets` equal-width buckets spanning the range
+     * `[begin_ts, end_ts)`.
+     *
+     * @param timestamps
+     * @param begin_ts
+     * @param end_ts
+     * @param num_buckets
+     * @return The number of log events in each bucket, in chronological order.
+     * @throw ClpFfiJsException if the range is empty or `num_buckets` isn't in the range
+     * `[1, cMaxNumHistogramBuckets]`.
+     */
+    [[nodiscard]] auto get_histogram(
+            std::span<clp::ir::epoch_time_ms_t const> timestamps,
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts,
+            size_t num_buckets
+    ) const -> std::vector<size_t>;
+
+    /**
+     * @return The number of bytes the index allocates on the heap.
+     */
+    [[nodiscard]] auto get_heap_size() const -> size_t {
+        return m_sorted_log_event_indices.capacity() * sizeof(size_t);
+    }
+
+    auto shrink_to_fit() -> void { m_sorted_log_event_indices.shrink_to_fit(); }
+
+private:
+    // Methods
+    /**
+     * @param timestamps
+     * @param target_ts
+     * @return The position, in chronological order, of the first log event with a timestamp
+     * greater than or equal to `target_ts`.
+     */
+    [[nodiscard]] auto lower_bound(
+            std::span<clp::ir::epoch_time_ms_t const> timestamps,
+            clp::ir::epoch_time_ms_t target_ts
+    ) const -> size_t;
+
+    /**
+     * @param timestamps
+     * @param target_ts
+     * @return The position, in chronological order, of the first log event with a timestamp
+     * greater than `target_ts`.
+     */
+    [[nodiscard]] auto upper_bound(
+            std::span<clp::ir::epoch_time_ms_t const> timestamps,
+            clp::ir::epoch_time_ms_t target_ts
+    ) const -> size_t;
+
+    // Variables
+    // Only populated once the stream is known to be out of order.
+    std::vector<size_t> m_sorted_log_event_indices;
+    size_t m_num_indexed_log_events{0};
+    bool m_is_sorted{true};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_TIMESTAMPINDEX_HPP
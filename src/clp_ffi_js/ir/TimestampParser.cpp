@@ -0,0 +1,340 @@
+#include "TimestampParser.hpp"
+
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+
+#include <clp/Defs.h>
+#include <clp/ffi/Value.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/TimestampPattern.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+// Epoch timestamps with at least these magnitudes are treated as being in the given unit, since
+// they'd otherwise be more than ~3000 years away from the epoch.
+constexpr int64_t cMinEpochMicroseconds{100'000'000'000'000};
+constexpr int64_t cMinEpochNanoseconds{100'000'000'000'000'000};
+constexpr int64_t cMinEpochNonSeconds{100'000'000'000};
+// Floats beyond this magnitude can't be converted to `int64_t` without overflowing.
+constexpr double cMaxEpochFloat{9.0e18};
+
+constexpr int64_t cMillisecondsPerSecond{1000};
+constexpr int64_t cMicrosecondsPerMillisecond{1000};
+constexpr int64_t cNanosecondsPerMillisecond{1'000'000};
+constexpr int64_t cSecondsPerMinute{60};
+constexpr int64_t cMinutesPerHour{60};
+constexpr size_t cNumMillisecondDigits{3};
+
+/**
+ * A cursor over a string for parsing fixed-width fields.
+ */
+class FieldReader {
+public:
+    explicit FieldReader(std::string_view str) : m_str{str} {}
+
+    [[nodiscard]] auto is_done() const -> bool { return m_pos == m_str.size(); }
+
+    /**
+     * @return The next character, or '\0' if there are no more characters.
+     */
+    [[nodiscard]] auto peek() const -> char { return is_done() ? '\0' : m_str[m_pos]; }
+
+    /**
+     * Consumes the next character if it's `c`.
+     *
+     * @param c
+     * @return Whether the character was consumed.
+     */
+    [[nodiscard]] auto consume(char c) -> bool {
+        if (peek() != c) {
+            return false;
+        }
+        ++m_pos;
+        return true;
+    }
+
+    /**
+     * @param num_digits
+     * @param value Returns the integer formed by the next `num_digits` decimal digits.
+     * @return Whether the digits were read.
+     */
+    [[nodiscard]] auto read_digits(size_t num_digits, int64_t& value) -> bool {
+        if (m_str.size() - m_pos < num_digits) {
+            return false;
+        }
+        value = 0;
+        for (size_t i{0}; i < num_digits; ++i) {
+            auto const c{m_str[m_pos + i]};
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            value = value * 10 + (c - '0');
+        }
+        m_pos += num_digits;
+        return true;
+    }
+
+    /**
+     * Reads a fraction of a second, i.e., one or more decimal digits.
+     *
+     * @param milliseconds Returns the fraction in milliseconds, truncated.
+     * @return Whether the fraction was read.
+     */
+    [[nodiscard]] auto read_fraction(int64_t& milliseconds) -> bool {
+        size_t num_digits{0};
+        milliseconds = 0;
+        for (; false == is_done() && '0' <= peek() && peek() <= '9'; ++m_pos, ++num_digits) {
+            if (num_digits < cNumMillisecondDigits) {
+                milliseconds = milliseconds * 10 + (peek() - '0');
+            }
+        }
+        for (auto i{num_digits}; i < cNumMillisecondDigits; ++i) {
+            milliseconds *= 10;
+        }
+        return 0 != num_digits;
+    }
+
+private:
+    std::string_view m_str;
+    size_t m_pos{0};
+};
+
+/**
+ * Reads a UTC offset of the form "Z", "+hh", "+hhmm", or "+hh:mm" (or with a '-' instead of '+').
+ *
+ * @param reader
+ * @param offset_minutes Returns the offset in minutes.
+ * @return Whether the offset was read.
+ */
+[[nodiscard]] auto read_utc_offset(FieldReader& reader, int64_t& offset_minutes) -> bool;
+
+auto read_utc_offset(FieldReader& reader, int64_t& offset_minutes) -> bool {
+    offset_minutes = 0;
+    if (reader.consume('Z') || reader.consume('z')) {
+        return true;
+    }
+
+    int64_t sign{1};
+    if (reader.consume('-')) {
+        sign = -1;
+    } else if (false == reader.consume('+')) {
+        return false;
+    }
+    int64_t hours{0};
+    int64_t minutes{0};
+    if (false == reader.read_digits(2, hours)) {
+        return false;
+    }
+    if (false == reader.is_done()) {
+        std::ignore = reader.consume(':');
+        if (false == reader.read_digits(2, minutes)) {
+            return false;
+        }
+    }
+    if (hours > 23 || minutes >= cMinutesPerHour) {
+        return false;
+    }
+    offset_minutes = sign * (hours * cMinutesPerHour + minutes);
+    return true;
+}
+}  // namespace
+
+auto TimestampParser::parse(std::string_view value) -> std::optional<clp::ir::epoch_time_ms_t> {
+    if (Format::Unknown != m_format) {
+        if (auto const timestamp{parse_with_format(value)}; timestamp.has_value()) {
+            return timestamp;
+        }
+    }
+    if (m_num_format_detections >= cMaxNumFormatDetections) {
+        return std::nullopt;
+    }
+    ++m_num_format_detections;
+    return detect_format(value);
+}
+
+auto TimestampParser::normalize_epoch(clp::ffi::value_int_t value) -> clp::ir::epoch_time_ms_t {
+    if (value >= cMinEpochNanoseconds || value <= -cMinEpochNanoseconds) {
+        return value / cNanosecondsPerMillisecond;
+    }
+    if (value >= cMinEpochMicroseconds || value <= -cMinEpochMicroseconds) {
+        return value / cMicrosecondsPerMillisecond;
+    }
+    return value;
+}
+
+auto TimestampParser::normalize_epoch(clp::ffi::value_float_t value)
+        -> std::optional<clp::ir::epoch_time_ms_t> {
+    if (false == std::isfinite(value) || std::abs(value) > cMaxEpochFloat) {
+        return std::nullopt;
+    }
+    if (std::abs(value) < static_cast<double>(cMinEpochNonSeconds)) {
+        return static_cast<clp::ir::epoch_time_ms_t>(
+                std::floor(value * static_cast<double>(cMillisecondsPerSecond))
+        );
+    }
+    return normalize_epoch(static_cast<clp::ffi::value_int_t>(value));
+}
+
+auto TimestampParser::parse_iso8601(std::string_view str)
+        -> std::optional<clp::ir::epoch_time_ms_t> {
+    FieldReader reader{str};
+    int64_t year{0};
+    int64_t month{0};
+    int64_t day{0};
+    int64_t hours{0};
+    int64_t minutes{0};
+    int64_t seconds{0};
+    if (false == reader.read_digits(4, year) || false == reader.consume('-')
+        || false == reader.read_digits(2, month) || false == reader.consume('-')
+        || false == reader.read_digits(2, day))
+    {
+        return std::nullopt;
+    }
+    if (false == reader.consume('T') && false == reader.consume('t')
+        && false == reader.consume(' '))
+    {
+        return std::nullopt;
+    }
+    if (false == reader.read_digits(2, hours) || false == reader.consume(':')
+        || false == reader.read_digits(2, minutes))
+    {
+        return std::nullopt;
+    }
+
+    int64_t milliseconds{0};
+    if (reader.consume(':')) {
+        if (false == reader.read_digits(2, seconds)) {
+            return std::nullopt;
+        }
+        auto const has_fraction{reader.consume('.') || reader.consume(',')};
+        if (has_fraction && false == reader.read_fraction(milliseconds)) {
+            return std::nullopt;
+        }
+    }
+
+    int64_t offset_minutes{0};
+    if (false == reader.is_done()
+        && (false == read_utc_offset(reader, offset_minutes) || false == reader.is_done()))
+    {
+        return std::nullopt;
+    }
+
+    // Leap seconds (60) are accepted and roll over into the next minute.
+    std::chrono::year_month_day const date{
+            std::chrono::year{static_cast<int>(year)},
+            std::chrono::month{static_cast<unsigned>(month)},
+            std::chrono::day{static_cast<unsigned>(day)}
+    };
+    if (false == date.ok() || hours > 23 || minutes >= cMinutesPerHour
+        || seconds > cSecondsPerMinute)
+    {
+        return std::nullopt;
+    }
+
+    auto const time{
+            std::chrono::sys_days{date} + std::chrono::hours{hours}
+            + std::chrono::minutes{minutes - offset_minutes} + std::chrono::seconds{seconds}
+            + std::chrono::milliseconds{milliseconds}
+    };
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+auto TimestampParser::parse_epoch(std::string_view str) -> std::optional<clp::ir::epoch_time_ms_t> {
+    auto const* const str_end{str.data() + str.size()};
+    clp::ffi::value_int_t integer_part{0};
+    auto const [integer_end, ec]{std::from_chars(str.data(), str_end, integer_part)};
+    if (std::errc{} != ec) {
+        return std::nullopt;
+    }
+    if (str_end == integer_end) {
+        // Unlike integer values, integer strings are in seconds unless their magnitude is only
+        // plausible for a finer unit, so that they're read like their decimal counterparts.
+        if (integer_part < cMinEpochNonSeconds && integer_part > -cMinEpochNonSeconds) {
+            return integer_part * cMillisecondsPerSecond;
+        }
+        return normalize_epoch(integer_part);
+    }
+
+    // A decimal epoch timestamp is in seconds.
+    FieldReader reader{std::string_view{integer_end, str_end}};
+    int64_t milliseconds{0};
+    if (false == reader.consume('.') || false == reader.read_fraction(milliseconds)
+        || false == reader.is_done() || integer_part >= cMinEpochNonSeconds
+        || integer_part <= -cMinEpochNonSeconds)
+    {
+        return std::nullopt;
+    }
+    auto const is_negative{'-' == str.front()};
+    return integer_part * cMillisecondsPerSecond + (is_negative ? -milliseconds : milliseconds);
+}
+
+auto TimestampParser::parse_with_format(std::string_view value) const
+        -> std::optional<clp::ir::epoch_time_ms_t> {
+    switch (m_format) {
+        case Format::Iso8601:
+            return parse_iso8601(value);
+        case Format::Epoch:
+            return parse_epoch(value);
+        case Format::Pattern: {
+            clp::epochtime_t timestamp{0};
+            size_t timestamp_begin_pos{0};
+            size_t timestamp_end_pos{0};
+            if (false
+                == m_pattern->parse_timestamp(
+                        std::string{value},
+                        timestamp,
+                        timestamp_begin_pos,
+                        timestamp_end_pos
+                ))
+            {
+                return std::nullopt;
+            }
+            return timestamp;
+        }
+        case Format::Unknown:
+        default:
+            return std::nullopt;
+    }
+}
+
+auto TimestampParser::detect_format(std::string_view value)
+        -> std::optional<clp::ir::epoch_time_ms_t> {
+    if (auto const timestamp{parse_iso8601(value)}; timestamp.has_value()) {
+        m_format = Format::Iso8601;
+        return timestamp;
+    }
+    if (auto const timestamp{parse_epoch(value)}; timestamp.has_value()) {
+        m_format = Format::Epoch;
+        return timestamp;
+    }
+
+    static bool const cIsTimestampPatternInitialized{[] {
+        clp::TimestampPattern::init();
+        return true;
+    }()};
+    std::ignore = cIsTimestampPatternInitialized;
+    clp::epochtime_t timestamp{0};
+    size_t timestamp_begin_pos{0};
+    size_t timestamp_end_pos{0};
+    auto const* pattern{clp::TimestampPattern::search_known_ts_patterns(
+            std::string{value},
+            timestamp,
+            timestamp_begin_pos,
+            timestamp_end_pos
+    )};
+    if (nullptr == pattern) {
+        return std::nullopt;
+    }
+    m_format = Format::Pattern;
+    m_pattern = pattern;
+    return timestamp;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,116 @@
+#ifndef CLP_FFI_JS_IR_TIMESTAMPPARSER_HPP
+#define CLP_FFI_JS_IR_TIMESTAMPPARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <clp/ffi/Value.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/TimestampPattern.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Class to parse the values of structured log events' timestamp kv-pairs into epoch milliseconds.
+ *
+ * The format of string values is detected from the first value that can be parsed, and then used
+ * to parse subsequent values directly. The supported formats are, in the order they're detected:
+ * - ISO 8601 date-times (e.g., "2024-05-06T07:08:09.123+02:00"). Date-times without a UTC offset
+ *   are assumed to be in UTC.
+ * - Epoch timestamps (e.g., "1714979289" or "1714979289.123"), in seconds unless their magnitude
+ *   is only plausible for milliseconds, microseconds, or nanoseconds.
+ * - The known timestamp patterns of `clp::TimestampPattern`.
+ *
+ * The first two formats are parsed without allocating; the last requires copying each value into
+ * a `std::string`.
+ *
+ * If a value doesn't match the detected format, the format is detected again, up to
+ * `cMaxNumFormatDetections` times per stream, which bounds the cost of streams whose values never
+ * match any format.
+ *
+ * Numeric values are normalized to milliseconds as follows:
+ * - Integers are treated as milliseconds, unless their magnitude is only plausible for
+ *   microseconds or nanoseconds.
+ * - Floats are treated as seconds, unless their magnitude is only plausible for a finer unit.
+ */
+class TimestampParser {
+public:
+    // Constants
+    static constexpr size_t cMaxNumFormatDetections{64};
+
+    // Methods
+    /**
+     * @param value
+     * @return The timestamp in epoch milliseconds, or std::nullopt if `value` doesn't match any
+     * supported format.
+     */
+    [[nodiscard]] auto parse(std::string_view value) -> std::optional<clp::ir::epoch_time_ms_t>;
+
+    /**
+     * @param value An epoch timestamp in milliseconds, microseconds, or nanoseconds.
+     * @return The timestamp in epoch milliseconds.
+     */
+    [[nodiscard]] static auto normalize_epoch(clp::ffi::value_int_t value)
+            -> clp::ir::epoch_time_ms_t;
+
+    /**
+     * @param value An epoch timestamp in seconds, or a finer unit if it's too large to be seconds.
+     * @return The timestamp in epoch milliseconds, or std::nullopt if `value` isn't finite or is
+     * out of range.
+     */
+    [[nodiscard]] static auto normalize_epoch(clp::ffi::value_float_t value)
+            -> std::optional<clp::ir::epoch_time_ms_t>;
+
+    /**
+     * @param str
+     * @return The timestamp in epoch milliseconds, or std::nullopt if `str` isn't an ISO 8601
+     * date-time.
+     */
+    [[nodiscard]] static auto parse_iso8601(std::string_view str)
+            -> std::optional<clp::ir::epoch_time_ms_t>;
+
+    /**
+     * @param str An integer or decimal epoch timestamp in seconds, or an integer epoch timestamp in
+     * a finer unit if it's too large to be seconds.
+     * @return The timestamp in epoch milliseconds, or std::nullopt if `str` isn't an integer or
+     * decimal epoch timestamp.
+     */
+    [[nodiscard]] static auto parse_epoch(std::string_view str)
+            -> std::optional<clp::ir::epoch_time_ms_t>;
+
+private:
+    // Types
+    enum class Format : uint8_t {
+        Unknown,
+        Iso8601,
+        Epoch,
+        Pattern,
+    };
+
+    // Methods
+    /**
+     * @param value
+     * @return The timestamp parsed using `m_format`, or std::nullopt if `value` doesn't match it.
+     */
+    [[nodiscard]] auto parse_with_format(std::string_view value) const
+            -> std::optional<clp::ir::epoch_time_ms_t>;
+
+    /**
+     * Detects the format of `value` and sets `m_format` (and `m_pattern`) accordingly.
+     *
+     * @param value
+     * @return The timestamp parsed using the detected format, or std::nullopt if `value` doesn't
+     * match any supported format.
+     */
+    [[nodiscard]] auto detect_format(std::string_view value)
+            -> std::optional<clp::ir::epoch_time_ms_t>;
+
+    // Variables
+    Format m_format{Format::Unknown};
+    clp::TimestampPattern const* m_pattern{nullptr};
+    size_t m_num_format_detections{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_TIMESTAMPPARSER_HPP
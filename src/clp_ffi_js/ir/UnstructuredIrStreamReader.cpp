@@ -1,19 +1,21 @@
 #include "UnstructuredIrStreamReader.hpp"
 
-#include <algorithm>
 #include <cstddef>
 #include <format>
-#include <iterator>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <system_error>
 #include <utility>
+#include <vector>
 
-#include <clp/Array.hpp>
 #include <clp/ErrorCode.hpp>
+#include <clp/ffi/ir_stream/IrUnitType.hpp>
 #include <clp/ir/LogEventDeserializer.hpp>
 #include <clp/ir/types.hpp>
+#include <clp/TimestampPattern.hpp>
 #include <clp/TraceableException.hpp>
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
@@ -21,20 +23,72 @@
 
 #include <clp_ffi_js/ClpFfiJsException.hpp>
 #include <clp_ffi_js/constants.hpp>
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/ChunkedReader.hpp>
+#include <clp_ffi_js/ir/ColumnarDecodeBuffers.hpp>
+#include <clp_ffi_js/ir/LogEventDiagnostics.hpp>
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+#include <clp_ffi_js/ir/LogLevelIndex.hpp>
+#include <clp_ffi_js/ir/LogtypeTable.hpp>
+#include <clp_ffi_js/ir/memory_usage.hpp>
+#include <clp_ffi_js/ir/parallel_decode.hpp>
+#include <clp_ffi_js/ir/ReaderStats.hpp>
+#include <clp_ffi_js/ir/RewindableReader.hpp>
 #include <clp_ffi_js/ir/StreamReader.hpp>
 #include <clp_ffi_js/ir/StreamReaderDataContext.hpp>
+#include <clp_ffi_js/ir/TextQuery.hpp>
+#include <clp_ffi_js/ir/TimestampIndex.hpp>
 
 namespace clp_ffi_js::ir {
 
 using namespace std::literals::string_literals;
 using clp::ir::four_byte_encoded_variable_t;
 
+namespace {
+/**
+ * Formats the given timestamp with the given pattern.
+ *
+ * Since consecutive log events often share a timestamp, the formatted timestamp is cached (per
+ * thread) and reused while the pattern and timestamp are unchanged.
+ *
+ * @param pattern
+ * @param timestamp
+ * @return A view of the formatted timestamp, which is only valid until the next call on the same
+ * thread.
+ */
+auto format_timestamp(clp::TimestampPattern const& pattern, clp::ir::epoch_time_ms_t timestamp)
+        -> std::string_view;
+
+auto format_timestamp(clp::TimestampPattern const& pattern, clp::ir::epoch_time_ms_t timestamp)
+        -> std::string_view {
+    thread_local std::string cached_format;
+    thread_local size_t cached_num_spaces_before_ts{0};
+    thread_local std::optional<clp::ir::epoch_time_ms_t> cached_timestamp;
+    // `clp::TimestampPattern` inserts the formatted timestamp after the pattern's given number of
+    // spaces in a message, so we format the timestamp by inserting it into a string of just those
+    // spaces.
+    thread_local std::string formatted_timestamp;
+
+    size_t const num_spaces_before_ts{pattern.get_num_spaces_before_ts()};
+    if (cached_timestamp != timestamp || cached_num_spaces_before_ts != num_spaces_before_ts
+        || cached_format != pattern.get_format())
+    {
+        formatted_timestamp.assign(num_spaces_before_ts, ' ');
+        pattern.insert_formatted_timestamp(timestamp, formatted_timestamp);
+        cached_format = pattern.get_format();
+        cached_num_spaces_before_ts = num_spaces_before_ts;
+        cached_timestamp = timestamp;
+    }
+    return std::string_view{formatted_timestamp}.substr(num_spaces_before_ts);
+}
+}  // namespace
+
 auto UnstructuredIrStreamReader::create(
+        std::unique_ptr<ChunkedReader>&& input_reader,
         std::unique_ptr<ZstdDecompressor>&& zstd_decompressor,
-        clp::Array<char> data_array
+        std::unique_ptr<RewindableReader>&& reader,
+        std::shared_ptr<ReaderStats> stats
 ) -> UnstructuredIrStreamReader {
-    auto result{UnstructuredIrDeserializer::create(*zstd_decompressor)};
+    auto result{UnstructuredIrDeserializer::create(*reader)};
     if (result.has_error()) {
         auto const error_code{result.error()};
         throw ClpFfiJsException{
@@ -49,11 +103,12 @@ auto UnstructuredIrStreamReader::create(
         };
     }
     auto data_context = StreamReaderDataContext<UnstructuredIrDeserializer>(
-            std::move(data_array),
+            std::move(input_reader),
             std::move(zstd_decompressor),
+            std::move(reader),
             std::move(result.value())
     );
-    return UnstructuredIrStreamReader(std::move(data_context));
+    return UnstructuredIrStreamReader(std::move(data_context), std::move(stats));
 }
 
 auto UnstructuredIrStreamReader::get_num_events_buffered() const -> size_t {
@@ -68,27 +123,226 @@ auto UnstructuredIrStreamReader::get_filtered_log_event_map() const -> FilteredL
     return FilteredLogEventMapTsType{emscripten::val::array(m_filtered_log_event_map.value())};
 }
 
+auto UnstructuredIrStreamReader::get_filtered_log_event_map_view() const
+        -> FilteredLogEventMapViewTsType {
+    return create_filtered_log_event_map_view(m_filtered_log_event_map);
+}
+
+auto UnstructuredIrStreamReader::get_log_event_idx(size_t filtered_log_event_idx) const
+        -> NullableLogEventIdx {
+    return generic_get_log_event_idx(m_filtered_log_event_map, filtered_log_event_idx);
+}
+
+auto UnstructuredIrStreamReader::get_filtered_log_event_idx(size_t log_event_idx) const
+        -> NullableLogEventIdx {
+    return generic_get_filtered_log_event_idx(m_filtered_log_event_map, log_event_idx);
+}
+
+auto UnstructuredIrStreamReader::get_stats() const -> StatsTsType {
+    return create_stats(*m_stats);
+}
+
+auto UnstructuredIrStreamReader::get_diagnostics() const -> DiagnosticsTsType {
+    // Log events in unstructured streams don't have authoritative kv-pairs that can be malformed.
+    return create_diagnostics(LogEventDiagnostics{});
+}
+
+auto UnstructuredIrStreamReader::get_memory_usage() const -> MemoryUsageTsType {
+    size_t compressed_input_size{0};
+    if (nullptr != m_stream_reader_data_context) {
+        compressed_input_size
+                = m_stream_reader_data_context->get_input_reader().get_num_bytes_resident();
+    }
+
+    return create_memory_usage(
+            get_log_events_size(m_encoded_log_events) + m_logtype_table.get_heap_size(),
+            0,
+            get_filtered_log_event_map_size(m_filtered_log_event_map)
+                    + m_filter_cache.get_heap_size() + m_log_level_index.get_heap_size()
+                    + m_timestamp_index.get_heap_size(),
+            compressed_input_size
+    );
+}
+
+auto UnstructuredIrStreamReader::shrink_to_fit() -> void {
+    m_encoded_log_events.shrink_to_fit();
+    m_filter_cache.shrink_to_fit(m_filtered_log_event_map);
+    m_log_level_index.shrink_to_fit();
+    m_timestamp_index.shrink_to_fit();
+}
+
 void UnstructuredIrStreamReader::filter_log_events(LogLevelFilterTsType const& log_level_filter) {
-    generic_filter_log_events(m_filtered_log_event_map, log_level_filter, m_encoded_log_events);
+    generic_filter_log_events(
+            m_filter_cache,
+            m_filtered_log_event_map,
+            log_level_filter,
+            m_encoded_log_events,
+            m_log_level_index,
+            m_timestamp_index
+    );
+}
+
+auto UnstructuredIrStreamReader::get_log_level_counts() const -> LogLevelCountsTsType {
+    return generic_get_log_level_counts(m_log_level_index);
+}
+
+auto UnstructuredIrStreamReader::filter_log_events_by_time_range(
+        clp::ir::epoch_time_ms_t begin_ts,
+        clp::ir::epoch_time_ms_t end_ts
+) -> size_t {
+    return generic_filter_log_events_by_time_range(
+            m_filter_cache,
+            m_filtered_log_event_map,
+            m_encoded_log_events,
+            m_timestamp_index,
+            FilterCache::TimeRange{begin_ts, end_ts}
+    );
+}
+
+auto UnstructuredIrStreamReader::clear_time_range() -> void {
+    generic_filter_log_events_by_time_range(
+            m_filter_cache,
+            m_filtered_log_event_map,
+            m_encoded_log_events,
+            m_timestamp_index,
+            std::nullopt
+    );
+}
+
+auto UnstructuredIrStreamReader::filter_log_events_by_predicate(
+        [[maybe_unused]] PredicateTsType const& predicate
+) -> size_t {
+    throw ClpFfiJsException{
+            clp::ErrorCode::ErrorCode_Unsupported,
+            __FILENAME__,
+            __LINE__,
+            "Predicates are only supported for structured IR streams."
+    };
+}
+
+auto UnstructuredIrStreamReader::get_time_histogram(
+        clp::ir::epoch_time_ms_t begin_ts,
+        clp::ir::epoch_time_ms_t end_ts,
+        size_t num_buckets
+) const -> TimeHistogramTsType {
+    return generic_get_time_histogram(
+            m_encoded_log_events.get_timestamps(),
+            m_timestamp_index,
+            begin_ts,
+            end_ts,
+            num_buckets
+    );
+}
+
+auto UnstructuredIrStreamReader::search_log_events(
+        std::string const& query,
+        SearchOptionsTsType const& options
+) -> size_t {
+    // Streams typically contain far fewer distinct logtypes than log events, so we cache how each
+    // logtype matches and only decode messages whose logtype can't decide the match on its own. The
+    // cache is owned by the match function since the search is reapplied to log events (and
+    // logtypes) deserialized later.
+    return generic_search_log_events(
+            m_filter_cache,
+            m_filtered_log_event_map,
+            query,
+            options,
+            m_encoded_log_events,
+            m_log_level_index,
+            m_timestamp_index,
+            [this,
+             logtype_matches = std::vector<std::optional<TextQuery::LogtypeMatch>>(
+                     m_logtype_table.get_num_logtypes()
+             ),
+             message = std::string{}](size_t log_event_idx, TextQuery const& text_query) mutable
+            -> bool {
+                auto const& log_event{m_encoded_log_events.get_log_event(log_event_idx)};
+                auto const logtype_id{log_event.get_logtype_id()};
+                auto const& logtype{m_logtype_table.get_logtype(logtype_id)};
+                if (logtype_id >= logtype_matches.size()) {
+                    logtype_matches.resize(m_logtype_table.get_num_logtypes());
+                }
+                auto& logtype_match{logtype_matches.at(logtype_id)};
+                if (false == logtype_match.has_value()) {
+                    logtype_match = text_query.match_logtype(logtype);
+                }
+                switch (logtype_match.value()) {
+                    case TextQuery::LogtypeMatch::Always:
+                        return true;
+                    case TextQuery::LogtypeMatch::Never:
+                        return false;
+                    default:
+                        break;
+                }
+
+                message.clear();
+                if (false == log_event.append_decoded_message(logtype, message)) {
+                    throw ClpFfiJsException{
+                            clp::ErrorCode::ErrorCode_Failure,
+                            __FILENAME__,
+                            __LINE__,
+                            "Failed to decode message"
+                    };
+                }
+                return text_query.matches(message);
+            }
+    );
 }
 
 auto UnstructuredIrStreamReader::deserialize_stream() -> size_t {
+    deserialize(DeserializationBudget{0, 0});
+    return m_encoded_log_events.size();
+}
+
+auto UnstructuredIrStreamReader::deserialize_next(size_t max_num_events, size_t max_duration_ms)
+        -> DeserializationProgressTsType {
+    deserialize(DeserializationBudget{max_num_events, max_duration_ms});
+    return create_deserialization_progress(
+            m_encoded_log_events.size(),
+            m_num_bytes_deserialized,
+            m_num_compressed_bytes_consumed,
+            nullptr == m_stream_reader_data_context
+    );
+}
+
+auto UnstructuredIrStreamReader::deserialize(DeserializationBudget const& budget) -> void {
     if (nullptr == m_stream_reader_data_context) {
-        return m_encoded_log_events.size();
+        return;
     }
 
-    constexpr size_t cDefaultNumReservedLogEvents{500'000};
-    m_encoded_log_events.reserve(cDefaultNumReservedLogEvents);
+    auto& input_reader{m_stream_reader_data_context->get_input_reader()};
+    auto& reader{m_stream_reader_data_context->get_reader()};
+    auto& deserializer{m_stream_reader_data_context->get_deserializer()};
+    auto const num_events_before{m_encoded_log_events.size()};
+    ReaderStats::ScopedPhase const parsing_phase{*m_stats, ReaderPhase::IrUnitParsing};
 
-    while (true) {
-        auto result{m_stream_reader_data_context->get_deserializer().deserialize_log_event()};
+    bool is_stream_exhausted{false};
+    while (false == budget.is_exhausted(m_encoded_log_events.size() - num_events_before)) {
+        if (m_encoded_log_events.size() == m_encoded_log_events.capacity()) {
+            ReaderStats::ScopedPhase const growth_phase{*m_stats, ReaderPhase::BufferGrowth};
+            m_encoded_log_events.reserve(
+                    estimate_log_events_capacity(m_encoded_log_events.size(), input_reader)
+            );
+            m_stats->increment(ReaderCounter::NumBufferGrowths);
+        }
+        // The log event is only retried if the input is incomplete.
+        reader.set_checkpoint(false == input_reader.is_input_complete());
+        auto result{deserializer.deserialize_log_event()};
         if (result.has_error()) {
             auto const error{result.error()};
             if (std::errc::no_message_available == error) {
+                m_stats->increment(clp::ffi::ir_stream::IrUnitType::EndOfStream);
+                is_stream_exhausted = true;
                 break;
             }
             if (std::errc::result_out_of_range == error) {
+                if (false == input_reader.is_input_complete()) {
+                    // Retry the log event once more of the input has been pushed.
+                    reader.rewind_to_checkpoint();
+                    break;
+                }
                 SPDLOG_ERROR("File contains an incomplete IR stream");
+                is_stream_exhausted = true;
                 break;
             }
             throw ClpFfiJsException{
@@ -102,75 +356,238 @@ auto UnstructuredIrStreamReader::deserialize_stream() -> size_t {
                     )
             };
         }
-        auto const& log_event = result.value();
-        auto const& message = log_event.get_message();
-
-        auto const& logtype = message.get_logtype();
-        constexpr size_t cLogLevelPositionInMessages{1};
-        LogLevel log_level{LogLevel::NONE};
-        if (logtype.length() > cLogLevelPositionInMessages) {
-            // NOLINTNEXTLINE(readability-qualified-auto)
-            auto const log_level_name_it{std::find_if(
-                    cLogLevelNames.begin() + static_cast<size_t>(cValidLogLevelsBeginIdx),
-                    cLogLevelNames.end(),
-                    [&](std::string_view level) {
-                        return logtype.substr(cLogLevelPositionInMessages).starts_with(level);
-                    }
-            )};
-            if (log_level_name_it != cLogLevelNames.end()) {
-                log_level = static_cast<LogLevel>(
-                        std::distance(cLogLevelNames.begin(), log_level_name_it)
-                );
-            }
-        }
+        m_stats->increment(clp::ffi::ir_stream::IrUnitType::LogEvent);
+        m_stats->increment(ReaderCounter::NumEventsEmitted);
 
-        m_encoded_log_events.emplace_back(log_event, log_level, log_event.get_timestamp());
+        ReaderStats::ScopedPhase const handling_phase{*m_stats, ReaderPhase::LogEventHandling};
+        // CLP only exposes the message's variables through const getters, so they're copied.
+        auto const& log_event{result.value()};
+        auto const& message{log_event.get_message()};
+        auto const logtype_id{m_logtype_table.intern(message.get_logtype())};
+        auto const timestamp{log_event.get_timestamp()};
+        m_encoded_log_events.emplace_back(
+                UnstructuredLogEvent{
+                        logtype_id,
+                        message.get_dict_vars(),
+                        message.get_encoded_vars(),
+                        timestamp
+                },
+                m_logtype_table.get_log_level(logtype_id),
+                timestamp
+        );
+    }
+    {
+        ReaderStats::ScopedPhase const indexing_phase{*m_stats, ReaderPhase::Indexing};
+        m_log_level_index.update(m_encoded_log_events);
+        m_timestamp_index.update(m_encoded_log_events.get_timestamps());
+        m_filter_cache.update_active(m_encoded_log_events.size(), m_filtered_log_event_map);
+    }
+    m_num_bytes_deserialized = reader.get_pos();
+    m_num_compressed_bytes_consumed = input_reader.get_pos();
+
+    if (is_stream_exhausted) {
+        m_stream_reader_data_context.reset(nullptr);
     }
-    m_stream_reader_data_context.reset(nullptr);
-    return m_encoded_log_events.size();
 }
 
 auto UnstructuredIrStreamReader::decode_range(size_t begin_idx, size_t end_idx, bool use_filter)
-        const -> DecodedResultsTsType {
-    auto log_event_to_string = [this](UnstructuredLogEvent const& log_event) -> std::string {
-        std::string message;
-        auto const parsed{log_event.get_message().decode_and_unparse()};
-        if (false == parsed.has_value()) {
-            throw ClpFfiJsException{
-                    clp::ErrorCode::ErrorCode_Failure,
-                    __FILENAME__,
-                    __LINE__,
-                    "Failed to decode message"
-            };
-        }
-        message = parsed.value();
-        m_ts_pattern.insert_formatted_timestamp(log_event.get_timestamp(), message);
-        return message;
-    };
-
+        -> DecodedResultsTsType {
     return generic_decode_range(
             begin_idx,
             end_idx,
             m_filtered_log_event_map,
             m_encoded_log_events,
-            log_event_to_string,
+            [this](size_t log_event_idx) -> std::string const& {
+                return decode_log_event(log_event_idx);
+            },
             use_filter
     );
 }
 
+auto UnstructuredIrStreamReader::decode_range_columnar(
+        size_t begin_idx,
+        size_t end_idx,
+        bool use_filter
+) -> DecodedColumnarResultsTsType {
+    return generic_decode_range_columnar(
+            begin_idx,
+            end_idx,
+            m_filtered_log_event_map,
+            m_encoded_log_events,
+            [this](size_t log_event_idx) -> std::string const& {
+                return decode_log_event(log_event_idx);
+            },
+            use_filter,
+            m_columnar_decode_buffers
+    );
+}
+
+auto UnstructuredIrStreamReader::decode_range_projected(
+        [[maybe_unused]] size_t begin_idx,
+        [[maybe_unused]] size_t end_idx,
+        [[maybe_unused]] bool use_filter,
+        [[maybe_unused]] KeyPathsTsType const& key_paths
+) -> DecodedResultsTsType {
+    throw ClpFfiJsException{
+            clp::ErrorCode::ErrorCode_Unsupported,
+            __FILENAME__,
+            __LINE__,
+            "Projections are only supported for structured IR streams."
+    };
+}
+
+auto UnstructuredIrStreamReader::begin_export(size_t begin_idx, size_t end_idx, bool use_filter)
+        -> bool {
+    return generic_begin_export(
+            begin_idx,
+            end_idx,
+            use_filter,
+            m_filtered_log_event_map,
+            m_filter_cache.get_generation(),
+            m_encoded_log_events.size(),
+            m_export_buffer
+    );
+}
+
+auto UnstructuredIrStreamReader::export_next_chunk() -> ExportChunkTsType {
+    return generic_export_next_chunk(
+            m_filtered_log_event_map,
+            m_filter_cache.get_generation(),
+            [](size_t, size_t, bool) {},
+            [this](size_t log_event_idx) -> std::string const& {
+                return decode_log_event(log_event_idx);
+            },
+            m_export_buffer
+    );
+}
+
 auto UnstructuredIrStreamReader::find_nearest_log_event_by_timestamp(
         clp::ir::epoch_time_ms_t const target_ts
 ) -> NullableLogEventIdx {
-    return generic_find_nearest_log_event_by_timestamp(m_encoded_log_events, target_ts);
+    return generic_find_nearest_log_event_by_timestamp(
+            m_encoded_log_events.get_timestamps(),
+            m_timestamp_index,
+            target_ts
+    );
+}
+
+auto UnstructuredIrStreamReader::get_timestamps() const
+        -> std::span<clp::ir::epoch_time_ms_t const> {
+    return m_encoded_log_events.get_timestamps();
+}
+
+auto UnstructuredIrStreamReader::get_log_levels() const -> std::span<LogLevel const> {
+    return m_encoded_log_events.get_log_levels();
+}
+
+auto UnstructuredIrStreamReader::decode_log_events(std::span<size_t const> log_event_indices)
+        -> std::vector<std::string> {
+    validate_log_event_indices(log_event_indices, m_encoded_log_events.size());
+    return parallel_decode(log_event_indices.size(), [&](size_t i) -> std::string {
+        return log_event_to_string(m_encoded_log_events.get_log_event(log_event_indices[i]));
+    });
+}
+
+auto UnstructuredIrStreamReader::get_input_reader() -> ChunkedReader* {
+    if (nullptr == m_stream_reader_data_context) {
+        return nullptr;
+    }
+    return &m_stream_reader_data_context->get_input_reader();
+}
+
+auto UnstructuredIrStreamReader::export_index_blob() const -> std::vector<char> {
+    throw ClpFfiJsException{
+            clp::ErrorCode::ErrorCode_Unsupported,
+            __FILENAME__,
+            __LINE__,
+            "Indices are only supported for lazy structured IR streams."
+    };
+}
+
+auto UnstructuredIrStreamReader::import_index_blob(std::span<char const> /*blob*/) -> bool {
+    throw ClpFfiJsException{
+            clp::ErrorCode::ErrorCode_Unsupported,
+            __FILENAME__,
+            __LINE__,
+            "Indices are only supported for lazy structured IR streams."
+    };
 }
 
 UnstructuredIrStreamReader::UnstructuredIrStreamReader(
-        StreamReaderDataContext<UnstructuredIrDeserializer>&& stream_reader_data_context
+        StreamReaderDataContext<UnstructuredIrDeserializer>&& stream_reader_data_context,
+        std::shared_ptr<ReaderStats> stats
 )
         : m_stream_reader_data_context{std::make_unique<
                   StreamReaderDataContext<UnstructuredIrDeserializer>>(
                   std::move(stream_reader_data_context)
           )},
-          m_ts_pattern{m_stream_reader_data_context->get_deserializer().get_timestamp_pattern()} {}
+          m_ts_pattern{m_stream_reader_data_context->get_deserializer().get_timestamp_pattern()},
+          m_stats{std::move(stats)} {}
+
+auto UnstructuredIrStreamReader::log_event_to_string(UnstructuredLogEvent const& log_event) const
+        -> std::string {
+    std::string message;
+    append_decoded_log_event(log_event, message);
+    return message;
+}
+
+auto UnstructuredIrStreamReader::decode_log_event(size_t log_event_idx) const
+        -> std::string const& {
+    // NOTE: The buffer is thread-local since log events may be decoded in parallel (see
+    // `parallel_decode`).
+    thread_local std::string message;
+    message.clear();
+    append_decoded_log_event(m_encoded_log_events.get_log_event(log_event_idx), message);
+    return message;
+}
+
+auto UnstructuredIrStreamReader::append_decoded_log_event(
+        UnstructuredLogEvent const& log_event,
+        std::string& output
+) const -> void {
+    auto const append_decoded_message = [&](std::string& message) {
+        if (false
+            == log_event.append_decoded_message(
+                    m_logtype_table.get_logtype(log_event.get_logtype_id()),
+                    message
+            ))
+        {
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_Failure,
+                    __FILENAME__,
+                    __LINE__,
+                    "Failed to decode message"
+            };
+        }
+    };
+
+    auto const timestamp{format_timestamp(m_ts_pattern, log_event.get_timestamp())};
+    auto const num_spaces_before_ts{m_ts_pattern.get_num_spaces_before_ts()};
+    if (0 == num_spaces_before_ts) {
+        output.append(timestamp);
+        append_decoded_message(output);
+        return;
+    }
 
+    // Decode the message into a separate buffer so that it can be appended around the timestamp,
+    // rather than inserting the timestamp into the middle of `output`.
+    thread_local std::string message;
+    message.clear();
+    append_decoded_message(message);
+    size_t ts_pos{0};
+    for (size_t num_spaces_found{0}; num_spaces_found < num_spaces_before_ts; ++ts_pos) {
+        if (message.size() == ts_pos) {
+            // Let `clp::TimestampPattern` handle messages with too few spaces as it always has.
+            m_ts_pattern.insert_formatted_timestamp(log_event.get_timestamp(), message);
+            output.append(message);
+            return;
+        }
+        if (' ' == message[ts_pos]) {
+            ++num_spaces_found;
+        }
+    }
+    output.append(message, 0, ts_pos);
+    output.append(timestamp);
+    output.append(message, ts_pos);
+}
 }  // namespace clp_ffi_js::ir
@@ -1,18 +1,29 @@
 #ifndef CLP_FFI_JS_IR_UNSTRUCTUREDIRSTREAMREADER_HPP
 #define CLP_FFI_JS_IR_UNSTRUCTUREDIRSTREAMREADER_HPP
 
-#include <Array.hpp>
 #include <cstddef>
 #include <memory>
+#include <span>
+#include <string>
+#include <vector>
 
 #include <clp/ir/LogEventDeserializer.hpp>
 #include <clp/ir/types.hpp>
 #include <clp/TimestampPattern.hpp>
 #include <emscripten/val.h>
 
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/ChunkedReader.hpp>
+#include <clp_ffi_js/ir/ColumnarDecodeBuffers.hpp>
+#include <clp_ffi_js/ir/ExportBuffer.hpp>
+#include <clp_ffi_js/ir/FilterCache.hpp>
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+#include <clp_ffi_js/ir/LogLevelIndex.hpp>
+#include <clp_ffi_js/ir/LogtypeTable.hpp>
+#include <clp_ffi_js/ir/ReaderStats.hpp>
+#include <clp_ffi_js/ir/RewindableReader.hpp>
 #include <clp_ffi_js/ir/StreamReader.hpp>
 #include <clp_ffi_js/ir/StreamReaderDataContext.hpp>
+#include <clp_ffi_js/ir/TimestampIndex.hpp>
 
 namespace clp_ffi_js::ir {
 using clp::ir::four_byte_encoded_variable_t;
@@ -38,15 +49,19 @@ public:
     auto operator=(UnstructuredIrStreamReader&&) -> UnstructuredIrStreamReader& = delete;
 
     /**
-     * @param zstd_decompressor A decompressor for an IR stream, where the read head of the stream
-     * is just after the stream's encoding type.
-     * @param data_array The array backing `zstd_decompressor`.
+     * @param input_reader The reader holding the compressed input backing `zstd_decompressor`.
+     * @param zstd_decompressor A decompressor for an IR stream, backing `reader`.
+     * @param reader A reader for the decompressed IR stream, where the read head of the stream is
+     * just after the stream's encoding type.
+     * @param stats The stats that `reader` records in, and in which to record deserialization.
      * @return The created instance.
      * @throw ClpFfiJsException if any error occurs.
      */
     [[nodiscard]] static auto create(
+            std::unique_ptr<ChunkedReader>&& input_reader,
             std::unique_ptr<ZstdDecompressor>&& zstd_decompressor,
-            clp::Array<char> data_array
+            std::unique_ptr<RewindableReader>&& reader,
+            std::shared_ptr<ReaderStats> stats
     ) -> UnstructuredIrStreamReader;
 
     [[nodiscard]] auto get_ir_stream_type() const -> StreamType override {
@@ -57,8 +72,55 @@ public:
 
     [[nodiscard]] auto get_filtered_log_event_map() const -> FilteredLogEventMapTsType override;
 
+    [[nodiscard]] auto get_filtered_log_event_map_view() const
+            -> FilteredLogEventMapViewTsType override;
+
+    [[nodiscard]] auto get_filtered_log_event_map_generation() const -> size_t override {
+        return m_filter_cache.get_generation();
+    }
+
+    [[nodiscard]] auto get_log_event_idx(size_t filtered_log_event_idx) const
+            -> NullableLogEventIdx override;
+
+    [[nodiscard]] auto get_filtered_log_event_idx(size_t log_event_idx) const
+            -> NullableLogEventIdx override;
+
+    [[nodiscard]] auto get_memory_usage() const -> MemoryUsageTsType override;
+
+    [[nodiscard]] auto get_stats() const -> StatsTsType override;
+
+    [[nodiscard]] auto get_diagnostics() const -> DiagnosticsTsType override;
+
+    auto shrink_to_fit() -> void override;
+
     void filter_log_events(LogLevelFilterTsType const& log_level_filter) override;
 
+    [[nodiscard]] auto get_log_level_counts() const -> LogLevelCountsTsType override;
+
+    auto filter_log_events_by_time_range(
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts
+    ) -> size_t override;
+
+    auto clear_time_range() -> void override;
+
+    /**
+     * Unsupported, since unstructured log events don't have kv-pairs.
+     *
+     * @throw ClpFfiJsException always.
+     */
+    auto filter_log_events_by_predicate(PredicateTsType const& predicate) -> size_t override;
+
+    [[nodiscard]] auto get_time_histogram(
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts,
+            size_t num_buckets
+    ) const -> TimeHistogramTsType override;
+
+    [[nodiscard]] auto
+    search_log_events(std::string const& query, SearchOptionsTsType const& options)
+            -> size_t override;
+
     /**
      * @see StreamReader::deserialize_stream
      *
@@ -68,24 +130,135 @@ public:
      */
     [[nodiscard]] auto deserialize_stream() -> size_t override;
 
-    [[nodiscard]] auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
+    /**
+     * @see StreamReader::deserialize_next
+     *
+     * After the stream has been exhausted, it will be deallocated.
+     *
+     * @return @see StreamReader::deserialize_next
+     */
+    [[nodiscard]] auto deserialize_next(size_t max_num_events, size_t max_duration_ms)
+            -> DeserializationProgressTsType override;
+
+    [[nodiscard]] auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter)
             -> DecodedResultsTsType override;
 
+    [[nodiscard]] auto decode_range_columnar(size_t begin_idx, size_t end_idx, bool use_filter)
+            -> DecodedColumnarResultsTsType override;
+
+    /**
+     * Unsupported, since unstructured log events don't have keys.
+     *
+     * @throw ClpFfiJsException always.
+     */
+    [[nodiscard]] auto decode_range_projected(
+            size_t begin_idx,
+            size_t end_idx,
+            bool use_filter,
+            KeyPathsTsType const& key_paths
+    ) -> DecodedResultsTsType override;
+
+    auto begin_export(size_t begin_idx, size_t end_idx, bool use_filter) -> bool override;
+
+    [[nodiscard]] auto export_next_chunk() -> ExportChunkTsType override;
+
     [[nodiscard]] auto find_nearest_log_event_by_timestamp(clp::ir::epoch_time_ms_t target_ts
     ) -> NullableLogEventIdx override;
 
+    [[nodiscard]] auto get_timestamps() const
+            -> std::span<clp::ir::epoch_time_ms_t const> override;
+
+    [[nodiscard]] auto get_log_levels() const -> std::span<LogLevel const> override;
+
+    [[nodiscard]] auto get_timestamp_index() const -> TimestampIndex const& override {
+        return m_timestamp_index;
+    }
+
+    [[nodiscard]] auto get_log_level_index() const -> LogLevelIndex const& override {
+        return m_log_level_index;
+    }
+
+    [[nodiscard]] auto decode_log_events(std::span<size_t const> log_event_indices)
+            -> std::vector<std::string> override;
+
+protected:
+    [[nodiscard]] auto get_input_reader() -> ChunkedReader* override;
+
+    [[nodiscard]] auto export_index_blob() const -> std::vector<char> override;
+
+    auto import_index_blob(std::span<char const> blob) -> bool override;
+
 private:
+    // Methods
+    /**
+     * Deserializes log events from the stream until either the stream is exhausted or `budget` is
+     * exhausted.
+     *
+     * @param budget
+     * @throw ClpFfiJsException if an error occurs during deserialization.
+     */
+    auto deserialize(DeserializationBudget const& budget) -> void;
+
+    /**
+     * Decodes the given log event's message and inserts its formatted timestamp.
+     *
+     * @param log_event
+     * @return The decoded message.
+     * @throw ClpFfiJsException if the message cannot be decoded.
+     */
+    [[nodiscard]] auto log_event_to_string(UnstructuredLogEvent const& log_event) const
+            -> std::string;
+
+    /**
+     * Same as `log_event_to_string`, except the message is decoded into a thread-local buffer that
+     * is reused across calls, so that decoding doesn't allocate once the buffer has grown.
+     *
+     * @param log_event_idx
+     * @return A reference to the buffer, which is only valid until the next call on the same
+     * thread.
+     * @throw ClpFfiJsException if the message cannot be decoded.
+     */
+    [[nodiscard]] auto decode_log_event(size_t log_event_idx) const -> std::string const&;
+
+    /**
+     * Decodes the given log event's message with its formatted timestamp, appending the result to
+     * `output`.
+     *
+     * The timestamp is written in the same pass as the message when it starts the message (the
+     * common case); otherwise, the message is decoded into a reusable buffer first so that it can
+     * be appended around the timestamp. The formatted timestamp is reused across consecutive log
+     * events with the same timestamp.
+     *
+     * @param log_event
+     * @param output
+     * @throw ClpFfiJsException if the message cannot be decoded.
+     */
+    auto append_decoded_log_event(UnstructuredLogEvent const& log_event, std::string& output) const
+            -> void;
+
     // Constructor
-    explicit UnstructuredIrStreamReader(
-            StreamReaderDataContext<UnstructuredIrDeserializer>&& stream_reader_data_context
+    UnstructuredIrStreamReader(
+            StreamReaderDataContext<UnstructuredIrDeserializer>&& stream_reader_data_context,
+            std::shared_ptr<ReaderStats> stats
     );
 
     // Variables
     UnstructuredLogEvents m_encoded_log_events;
+    LogtypeTable m_logtype_table;
     std::unique_ptr<StreamReaderDataContext<UnstructuredIrDeserializer>>
             m_stream_reader_data_context;
     FilteredLogEventsMap m_filtered_log_event_map;
+    // NOTE: The cached filters reference the reader's members, so the reader must not be moved
+    // once a filter has been applied.
+    FilterCache m_filter_cache;
+    LogLevelIndex m_log_level_index;
+    TimestampIndex m_timestamp_index;
+    size_t m_num_bytes_deserialized{0};
+    size_t m_num_compressed_bytes_consumed{0};
+    ColumnarDecodeBuffers m_columnar_decode_buffers;
+    ExportBuffer m_export_buffer;
     clp::TimestampPattern m_ts_pattern;
+    std::shared_ptr<ReaderStats> m_stats;
 };
 }  // namespace clp_ffi_js::ir
 
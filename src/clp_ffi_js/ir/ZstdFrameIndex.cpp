@@ -0,0 +1,306 @@
+#include "ZstdFrameIndex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <zstd.h>
+
+namespace clp_ffi_js::ir {
+namespace {
+using Frame = ZstdFrameIndex::Frame;
+
+// Constants from the Zstandard frame and seekable formats
+constexpr uint32_t cSkippableFrameMagicNumberMask{0xFFFF'FFF0};
+constexpr uint32_t cSkippableFrameMagicNumberStart{0x184D'2A50};
+constexpr size_t cSkippableFrameHeaderSize{8};
+constexpr uint32_t cSeekTableSkippableFrameMagicNumber{0x184D'2A5E};
+constexpr uint32_t cSeekTableFooterMagicNumber{0x8F92'EAB1};
+constexpr size_t cSeekTableFooterSize{9};
+// Offsets within the seek table's footer; the number of frames is at the beginning.
+constexpr size_t cSeekTableFooterDescriptorOffset{4};
+constexpr size_t cSeekTableFooterMagicNumberOffset{5};
+constexpr uint8_t cSeekTableDescriptorChecksumFlag{0x80};
+constexpr uint8_t cSeekTableDescriptorReservedBitsMask{0x7C};
+constexpr size_t cSeekTableEntrySize{8};
+constexpr size_t cSeekTableEntryWithChecksumSize{12};
+
+struct SeekTableFooter {
+    size_t num_frames;
+    size_t entry_size;
+};
+
+/**
+ * @param bytes
+ * @param pos
+ * @return The little-endian 32-bit unsigned integer at `pos` in `bytes`.
+ */
+[[nodiscard]] auto read_le_uint32(std::span<char const> bytes, size_t pos) -> uint32_t;
+
+/**
+ * @param frame The bytes starting at the beginning of a frame.
+ * @return Whether the frame is a skippable frame.
+ */
+[[nodiscard]] auto is_skippable_frame(std::span<char const> frame) -> bool;
+
+/**
+ * Indexes the frames in `input` using the decompressed sizes recorded in their headers. Skippable
+ * frames are skipped.
+ *
+ * @param input
+ * @return The frames, or std::nullopt if any frame is invalid or doesn't record its decompressed
+ * size.
+ */
+[[nodiscard]] auto index_frame_headers(std::span<char const> input)
+        -> std::optional<std::vector<Frame>>;
+
+/**
+ * @param bytes Bytes ending with a seek table.
+ * @return The seek table's footer, or std::nullopt if `bytes` doesn't end with a valid footer.
+ */
+[[nodiscard]] auto parse_seek_table_footer(std::span<char const> bytes)
+        -> std::optional<SeekTableFooter>;
+
+/**
+ * @param seek_table A skippable frame containing a seek table.
+ * @return The seek table's frames, or std::nullopt if the seek table is invalid.
+ */
+[[nodiscard]] auto parse_seek_table(std::span<char const> seek_table)
+        -> std::optional<std::vector<Frame>>;
+
+/**
+ * @param input
+ * @return The seek table at the end of `input`, or std::nullopt if there's none.
+ */
+[[nodiscard]] auto find_trailing_seek_table(std::span<char const> input)
+        -> std::optional<std::span<char const>>;
+
+/**
+ * @param frames Frames that cover `input` contiguously.
+ * @param input
+ * @return Whether each frame is a valid frame in `input` whose decompressed size, if recorded in
+ * its header, matches.
+ */
+[[nodiscard]] auto validate_frames(std::span<Frame const> frames, std::span<char const> input)
+        -> bool;
+
+auto read_le_uint32(std::span<char const> bytes, size_t pos) -> uint32_t {
+    uint32_t value{0};
+    for (size_t i{0}; i < sizeof(uint32_t); ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[pos + i])) << (i * 8);
+    }
+    return value;
+}
+
+auto is_skippable_frame(std::span<char const> frame) -> bool {
+    return frame.size() >= sizeof(uint32_t)
+           && cSkippableFrameMagicNumberStart
+                      == (read_le_uint32(frame, 0) & cSkippableFrameMagicNumberMask);
+}
+
+auto index_frame_headers(std::span<char const> input) -> std::optional<std::vector<Frame>> {
+    std::vector<Frame> frames;
+    size_t pos{0};
+    size_t decompressed_pos{0};
+    while (pos < input.size()) {
+        auto const frame{input.subspan(pos)};
+        auto const frame_size{ZSTD_findFrameCompressedSize(frame.data(), frame.size())};
+        if (ZSTD_isError(frame_size)) {
+            return std::nullopt;
+        }
+        if (false == is_skippable_frame(frame)) {
+            auto const decompressed_size{ZSTD_getFrameContentSize(frame.data(), frame.size())};
+            if (ZSTD_CONTENTSIZE_UNKNOWN == decompressed_size
+                || ZSTD_CONTENTSIZE_ERROR == decompressed_size
+                || decompressed_size > std::numeric_limits<size_t>::max() - decompressed_pos)
+            {
+                return std::nullopt;
+            }
+            if (0 != decompressed_size) {
+                frames.emplace_back(Frame{
+                        .compressed_begin_pos = pos,
+                        .compressed_size = frame_size,
+                        .decompressed_begin_pos = decompressed_pos,
+                        .decompressed_size = static_cast<size_t>(decompressed_size)
+                });
+                decompressed_pos += static_cast<size_t>(decompressed_size);
+            }
+        }
+        pos += frame_size;
+    }
+    return frames;
+}
+
+auto parse_seek_table_footer(std::span<char const> bytes) -> std::optional<SeekTableFooter> {
+    if (bytes.size() < cSkippableFrameHeaderSize + cSeekTableFooterSize) {
+        return std::nullopt;
+    }
+    auto const footer{bytes.last(cSeekTableFooterSize)};
+    auto const descriptor{static_cast<uint8_t>(footer[cSeekTableFooterDescriptorOffset])};
+    if (cSeekTableFooterMagicNumber != read_le_uint32(footer, cSeekTableFooterMagicNumberOffset)
+        || 0 != (descriptor & cSeekTableDescriptorReservedBitsMask))
+    {
+        return std::nullopt;
+    }
+    return SeekTableFooter{
+            .num_frames = read_le_uint32(footer, 0),
+            .entry_size = 0 != (descriptor & cSeekTableDescriptorChecksumFlag)
+                                  ? cSeekTableEntryWithChecksumSize
+                                  : cSeekTableEntrySize
+    };
+}
+
+auto parse_seek_table(std::span<char const> seek_table) -> std::optional<std::vector<Frame>> {
+    auto const footer{parse_seek_table_footer(seek_table)};
+    if (false == footer.has_value()
+        || cSeekTableSkippableFrameMagicNumber != read_le_uint32(seek_table, 0)
+        || seek_table.size() - cSkippableFrameHeaderSize
+                   != read_le_uint32(seek_table, sizeof(uint32_t)))
+    {
+        return std::nullopt;
+    }
+    auto const [num_frames, entry_size]{footer.value()};
+    auto const entries_end_pos{seek_table.size() - cSeekTableFooterSize};
+    auto const entries_size{entries_end_pos - cSkippableFrameHeaderSize};
+    if (0 != entries_size % entry_size || entries_size / entry_size != num_frames) {
+        return std::nullopt;
+    }
+
+    std::vector<Frame> frames;
+    frames.reserve(num_frames);
+    size_t compressed_pos{0};
+    size_t decompressed_pos{0};
+    for (auto entry_pos{cSkippableFrameHeaderSize}; entry_pos < entries_end_pos;
+         entry_pos += entry_size)
+    {
+        size_t const compressed_size{read_le_uint32(seek_table, entry_pos)};
+        size_t const decompressed_size{read_le_uint32(seek_table, entry_pos + sizeof(uint32_t))};
+        if (0 == compressed_size
+            || compressed_size > std::numeric_limits<size_t>::max() - compressed_pos
+            || decompressed_size > std::numeric_limits<size_t>::max() - decompressed_pos)
+        {
+            return std::nullopt;
+        }
+        frames.emplace_back(Frame{
+                .compressed_begin_pos = compressed_pos,
+                .compressed_size = compressed_size,
+                .decompressed_begin_pos = decompressed_pos,
+                .decompressed_size = decompressed_size
+        });
+        compressed_pos += compressed_size;
+        decompressed_pos += decompressed_size;
+    }
+    return frames;
+}
+
+auto find_trailing_seek_table(std::span<char const> input)
+        -> std::optional<std::span<char const>> {
+    auto const footer{parse_seek_table_footer(input)};
+    if (false == footer.has_value()) {
+        return std::nullopt;
+    }
+    auto const [num_frames, entry_size]{footer.value()};
+    auto const max_num_frames{
+            (input.size() - cSkippableFrameHeaderSize - cSeekTableFooterSize) / entry_size
+    };
+    if (num_frames > max_num_frames) {
+        return std::nullopt;
+    }
+    return input.last(cSkippableFrameHeaderSize + num_frames * entry_size + cSeekTableFooterSize);
+}
+
+auto validate_frames(std::span<Frame const> frames, std::span<char const> input) -> bool {
+    for (auto const& frame : frames) {
+        if (frame.compressed_begin_pos + frame.compressed_size > input.size()) {
+            return false;
+        }
+        auto const frame_bytes{input.subspan(frame.compressed_begin_pos, frame.compressed_size)};
+        if (is_skippable_frame(frame_bytes)
+            || frame.compressed_size
+                       != ZSTD_findFrameCompressedSize(frame_bytes.data(), frame_bytes.size()))
+        {
+            return false;
+        }
+        auto const decompressed_size{
+                ZSTD_getFrameContentSize(frame_bytes.data(), frame_bytes.size())
+        };
+        if (ZSTD_CONTENTSIZE_ERROR == decompressed_size
+            || (ZSTD_CONTENTSIZE_UNKNOWN != decompressed_size
+                && frame.decompressed_size != decompressed_size))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+auto ZstdFrameIndex::create(std::span<char const> compressed_input)
+        -> std::optional<ZstdFrameIndex> {
+    if (auto frames{index_frame_headers(compressed_input)}; frames.has_value()) {
+        return ZstdFrameIndex{std::move(frames.value())};
+    }
+    auto const seek_table{find_trailing_seek_table(compressed_input)};
+    if (false == seek_table.has_value()) {
+        return std::nullopt;
+    }
+    return create_from_seek_table(seek_table.value(), compressed_input);
+}
+
+auto ZstdFrameIndex::create_from_seek_table(
+        std::span<char const> seek_table,
+        std::span<char const> compressed_input
+) -> std::optional<ZstdFrameIndex> {
+    auto frames{parse_seek_table(seek_table)};
+    if (false == frames.has_value()) {
+        return std::nullopt;
+    }
+
+    size_t compressed_size{0};
+    if (false == frames->empty()) {
+        compressed_size = frames->back().compressed_begin_pos + frames->back().compressed_size;
+    }
+    if (compressed_size != compressed_input.size()) {
+        // The input may be followed by the seek table itself.
+        if (compressed_size + seek_table.size() != compressed_input.size()
+            || false == std::ranges::equal(compressed_input.subspan(compressed_size), seek_table))
+        {
+            return std::nullopt;
+        }
+    }
+    if (false == validate_frames(frames.value(), compressed_input.first(compressed_size))) {
+        return std::nullopt;
+    }
+
+    std::erase_if(frames.value(), [](Frame const& frame) { return 0 == frame.decompressed_size; });
+    return ZstdFrameIndex{std::move(frames.value())};
+}
+
+auto ZstdFrameIndex::get_max_frame_decompressed_size() const -> size_t {
+    size_t max_decompressed_size{0};
+    for (auto const& frame : m_frames) {
+        max_decompressed_size = std::max(max_decompressed_size, frame.decompressed_size);
+    }
+    return max_decompressed_size;
+}
+
+auto ZstdFrameIndex::find_frame_idx(size_t decompressed_pos) const -> size_t {
+    if (decompressed_pos >= get_decompressed_size()) {
+        return m_frames.size();
+    }
+    auto const it{std::ranges::upper_bound(
+            m_frames,
+            decompressed_pos,
+            std::less<>{},
+            [](Frame const& frame) { return frame.decompressed_begin_pos; }
+    )};
+    return static_cast<size_t>(std::distance(m_frames.begin(), it)) - 1;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,94 @@
+#ifndef CLP_FFI_JS_IR_ZSTDFRAMEINDEX_HPP
+#define CLP_FFI_JS_IR_ZSTDFRAMEINDEX_HPP
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace clp_ffi_js::ir {
+/**
+ * Index of the frames in a multi-frame Zstandard input, mapping positions in the decompressed
+ * output to the frames containing them, so that any part of the output can be decompressed without
+ * decompressing the frames before it.
+ *
+ * The index can be built from the frames' headers if every frame records its decompressed size, or
+ * otherwise from a seek table in the Zstandard seekable format, either appended to the input (as a
+ * skippable frame) or supplied separately. Either way, the frames are validated against the input.
+ */
+class ZstdFrameIndex {
+public:
+    // Types
+    struct Frame {
+        size_t compressed_begin_pos;
+        size_t compressed_size;
+        size_t decompressed_begin_pos;
+        size_t decompressed_size;
+    };
+
+    // Factory functions
+    /**
+     * Builds the index of a complete input from its frames' headers or, if some frame doesn't
+     * record its decompressed size, from the seek table at the end of the input.
+     *
+     * @param compressed_input
+     * @return The index, or std::nullopt if the input isn't a sequence of valid frames or their
+     * decompressed sizes aren't known.
+     */
+    [[nodiscard]] static auto create(std::span<char const> compressed_input)
+            -> std::optional<ZstdFrameIndex>;
+
+    /**
+     * Builds the index of a complete input from a separately supplied seek table.
+     *
+     * @param seek_table A skippable frame containing a seek table in the Zstandard seekable format.
+     * @param compressed_input The input, optionally followed by the seek table.
+     * @return The index, or std::nullopt if the seek table is invalid or doesn't match the input.
+     */
+    [[nodiscard]] static auto create_from_seek_table(
+            std::span<char const> seek_table,
+            std::span<char const> compressed_input
+    ) -> std::optional<ZstdFrameIndex>;
+
+    // Methods
+    [[nodiscard]] auto get_frames() const -> std::span<Frame const> { return m_frames; }
+
+    [[nodiscard]] auto get_num_frames() const -> size_t { return m_frames.size(); }
+
+    /**
+     * @return The size of the whole decompressed output.
+     */
+    [[nodiscard]] auto get_decompressed_size() const -> size_t {
+        if (m_frames.empty()) {
+            return 0;
+        }
+        return m_frames.back().decompressed_begin_pos + m_frames.back().decompressed_size;
+    }
+
+    /**
+     * @return The largest decompressed size of any frame.
+     */
+    [[nodiscard]] auto get_max_frame_decompressed_size() const -> size_t;
+
+    /**
+     * @param decompressed_pos
+     * @return The index of the frame containing the given position in the decompressed output, or
+     * `get_num_frames()` if the position is past the end of the output.
+     */
+    [[nodiscard]] auto find_frame_idx(size_t decompressed_pos) const -> size_t;
+
+    [[nodiscard]] auto get_heap_size() const -> size_t {
+        return m_frames.capacity() * sizeof(Frame);
+    }
+
+private:
+    // Constructors
+    explicit ZstdFrameIndex(std::vector<Frame> frames) : m_frames{std::move(frames)} {}
+
+    // Variables
+    std::vector<Frame> m_frames;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_ZSTDFRAMEINDEX_HPP
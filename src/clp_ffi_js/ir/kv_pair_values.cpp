@@ -0,0 +1,29 @@
+#include "kv_pair_values.hpp"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <clp/ffi/Value.hpp>
+#include <clp/ir/EncodedTextAst.hpp>
+
+namespace clp_ffi_js::ir {
+auto get_string_value(clp::ffi::Value const& value, std::string& decoded)
+        -> std::optional<std::string_view> {
+    if (value.is<std::string>()) {
+        return value.get_immutable_view<std::string>();
+    }
+    std::optional<std::string> result;
+    if (value.is<clp::ir::FourByteEncodedTextAst>()) {
+        result = value.get_immutable_view<clp::ir::FourByteEncodedTextAst>().decode_and_unparse();
+    } else if (value.is<clp::ir::EightByteEncodedTextAst>()) {
+        result = value.get_immutable_view<clp::ir::EightByteEncodedTextAst>().decode_and_unparse();
+    }
+    if (false == result.has_value()) {
+        return std::nullopt;
+    }
+    decoded = std::move(result.value());
+    return decoded;
+}
+}  // namespace clp_ffi_js::ir
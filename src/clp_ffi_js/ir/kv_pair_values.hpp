@@ -0,0 +1,22 @@
+#ifndef CLP_FFI_JS_IR_KV_PAIR_VALUES_HPP
+#define CLP_FFI_JS_IR_KV_PAIR_VALUES_HPP
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <clp/ffi/Value.hpp>
+
+// Methods to read the values of structured log events' kv-pairs.
+namespace clp_ffi_js::ir {
+/**
+ * @param value
+ * @param[out] decoded Returns the decoded string if `value` is an encoded text AST.
+ * @return A view of the string in `value` (or in `decoded`), or std::nullopt if `value` isn't a
+ * string or can't be decoded.
+ */
+[[nodiscard]] auto get_string_value(clp::ffi::Value const& value, std::string& decoded)
+        -> std::optional<std::string_view>;
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_KV_PAIR_VALUES_HPP
@@ -0,0 +1,106 @@
+#include "memory_usage.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+#include <clp/ir/EncodedTextAst.hpp>
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+/**
+ * @tparam encoded_variable_t
+ * @param encoded_text_ast
+ * @return The number of bytes the encoded text AST's members allocate on the heap.
+ */
+template <typename encoded_variable_t>
+auto get_encoded_text_ast_heap_size(
+        clp::ir::EncodedTextAst<encoded_variable_t> const& encoded_text_ast
+) -> size_t;
+
+template <typename encoded_variable_t>
+auto get_encoded_text_ast_heap_size(
+        clp::ir::EncodedTextAst<encoded_variable_t> const& encoded_text_ast
+) -> size_t {
+    auto const& dict_vars{encoded_text_ast.get_dict_vars()};
+    auto size{get_string_heap_size(encoded_text_ast.get_logtype().size())};
+    size += dict_vars.capacity() * sizeof(std::string);
+    for (auto const& dict_var : dict_vars) {
+        size += get_string_heap_size(dict_var.size());
+    }
+    size += encoded_text_ast.get_encoded_vars().capacity() * sizeof(encoded_variable_t);
+    return size;
+}
+}  // namespace
+
+auto get_string_heap_size(size_t length) -> size_t {
+    static size_t const sso_capacity{std::string{}.capacity()};
+    if (length <= sso_capacity) {
+        return 0;
+    }
+    // Account for the null terminator.
+    return length + 1;
+}
+
+auto get_heap_size(UnstructuredLogEvent const& log_event) -> size_t {
+    auto const& dict_vars{log_event.get_dict_vars()};
+    auto size{dict_vars.capacity() * sizeof(std::string)};
+    for (auto const& dict_var : dict_vars) {
+        size += get_string_heap_size(dict_var.size());
+    }
+    size += log_event.get_encoded_vars().capacity()
+            * sizeof(UnstructuredLogEvent::encoded_variable_t);
+    return size;
+}
+
+auto get_heap_size(StructuredLogEvent const& log_event) -> size_t {
+    using NodeIdValuePairs = StructuredLogEvent::NodeIdValuePairs;
+
+    // Each element of a node-based hash map is allocated individually alongside its hash and a
+    // pointer to the next element in its bucket.
+    constexpr size_t cHashMapNodeOverhead{sizeof(void*) + sizeof(size_t)};
+
+    auto const& id_value_pairs{log_event.get_node_id_value_pairs()};
+    auto size{id_value_pairs.bucket_count() * sizeof(void*)};
+    size += id_value_pairs.size() * (sizeof(NodeIdValuePairs::value_type) + cHashMapNodeOverhead);
+    for (auto const& [node_id, optional_value] : id_value_pairs) {
+        if (false == optional_value.has_value()) {
+            continue;
+        }
+        auto const& value{optional_value.value()};
+        if (value.is<std::string>()) {
+            size += get_string_heap_size(value.get_immutable_view<std::string>().size());
+        } else if (value.is<clp::ir::FourByteEncodedTextAst>()) {
+            size += get_encoded_text_ast_heap_size(
+                    value.get_immutable_view<clp::ir::FourByteEncodedTextAst>()
+            );
+        } else if (value.is<clp::ir::EightByteEncodedTextAst>()) {
+            size += get_encoded_text_ast_heap_size(
+                    value.get_immutable_view<clp::ir::EightByteEncodedTextAst>()
+            );
+        }
+    }
+    return size;
+}
+
+auto get_heap_size(clp::ffi::SchemaTree const& schema_tree) -> size_t {
+    auto const num_nodes{schema_tree.get_size()};
+    auto size{num_nodes * sizeof(clp::ffi::SchemaTree::Node)};
+    for (size_t node_id{0}; node_id < num_nodes; ++node_id) {
+        auto const& node{
+                schema_tree.get_node(static_cast<clp::ffi::SchemaTree::Node::id_t>(node_id))
+        };
+        size += get_string_heap_size(node.get_key_name().size());
+        size += node.get_children_ids().capacity() * sizeof(clp::ffi::SchemaTree::Node::id_t);
+    }
+    return size;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,40 @@
+#ifndef CLP_FFI_JS_IR_MEMORY_USAGE_HPP
+#define CLP_FFI_JS_IR_MEMORY_USAGE_HPP
+
+#include <cstddef>
+
+#include <clp/ffi/SchemaTree.hpp>
+
+#include <clp_ffi_js/ir/LogEventsWithFilterData.hpp>
+
+// Methods to estimate the heap memory held by the objects a `StreamReader` buffers. The estimates
+// account for the allocations each object makes but not for allocator overhead.
+namespace clp_ffi_js::ir {
+/**
+ * @param length
+ * @return The number of bytes a `std::string` of the given length allocates on the heap.
+ */
+[[nodiscard]] auto get_string_heap_size(size_t length) -> size_t;
+
+/**
+ * @param log_event
+ * @return The number of bytes the log event's members allocate on the heap, excluding the logtype
+ * it shares with other log events.
+ */
+[[nodiscard]] auto get_heap_size(UnstructuredLogEvent const& log_event) -> size_t;
+
+/**
+ * @param log_event
+ * @return The number of bytes the log event's members allocate on the heap, excluding the schema
+ * tree it shares with other log events.
+ */
+[[nodiscard]] auto get_heap_size(StructuredLogEvent const& log_event) -> size_t;
+
+/**
+ * @param schema_tree
+ * @return The number of bytes the schema tree allocates on the heap.
+ */
+[[nodiscard]] auto get_heap_size(clp::ffi::SchemaTree const& schema_tree) -> size_t;
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_MEMORY_USAGE_HPP
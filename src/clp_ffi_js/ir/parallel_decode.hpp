@@ -0,0 +1,72 @@
+#ifndef CLP_FFI_JS_IR_PARALLEL_DECODE_HPP
+#define CLP_FFI_JS_IR_PARALLEL_DECODE_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include <clp_ffi_js/ir/DecodeThreadPool.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * The minimum number of items each thread should decode. Ranges smaller than this are decoded
+ * entirely on the calling thread since handing work to other threads would cost more than it saves.
+ */
+constexpr size_t cMinNumItemsPerDecodeThread{1024};
+
+/**
+ * Decodes `num_items` items into strings, splitting the work across `DecodeThreadPool`'s threads
+ * when pthreads are enabled and the range is large enough.
+ *
+ * NOTE: `decode` may be called concurrently from multiple threads, so it must not touch any JS
+ * values or unsynchronized mutable state.
+ *
+ * @tparam DecodeFunc
+ * @param num_items
+ * @param decode Function to decode the item at the given index.
+ * @return The decoded strings, in item order.
+ * @throws Propagates the first exception thrown by `decode`.
+ */
+template <typename DecodeFunc>
+requires requires(DecodeFunc func, size_t idx) {
+    {
+        func(idx)
+    } -> std::convertible_to<std::string>;
+}
+[[nodiscard]] auto parallel_decode(size_t num_items, DecodeFunc const& decode)
+        -> std::vector<std::string> {
+    std::vector<std::string> results(num_items);
+    auto& thread_pool{DecodeThreadPool::get_instance()};
+    auto const num_threads{std::clamp<size_t>(
+            num_items / cMinNumItemsPerDecodeThread,
+            1,
+            thread_pool.get_max_num_tasks()
+    )};
+    auto const num_items_per_thread{(num_items + num_threads - 1) / num_threads};
+    std::vector<std::exception_ptr> exceptions(num_threads);
+
+    thread_pool.run(num_threads, [&](size_t thread_idx) {
+        auto const begin_idx{thread_idx * num_items_per_thread};
+        auto const end_idx{std::min(begin_idx + num_items_per_thread, num_items)};
+        try {
+            for (auto i{begin_idx}; i < end_idx; ++i) {
+                results[i] = decode(i);
+            }
+        } catch (...) {
+            exceptions[thread_idx] = std::current_exception();
+        }
+    });
+
+    for (auto const& exception : exceptions) {
+        if (nullptr != exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+    return results;
+}
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_PARALLEL_DECODE_HPP
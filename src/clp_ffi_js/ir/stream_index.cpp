@@ -0,0 +1,285 @@
+#include "stream_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_js/constants.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+// The blob starts with a fixed-size header, followed by the columns, which are encoded as LEB128
+// variable-length integers (timestamps as zigzag-encoded deltas, and IR unit positions as gaps and
+// sizes) except for the log levels, which are one byte each.
+constexpr uint32_t cMagicNumber{0x4950'4C43};  // "CLPI" in little-endian
+constexpr uint32_t cVersion{1};
+constexpr size_t cHeaderSize{2 * sizeof(uint32_t) + 2 * sizeof(uint64_t)};
+// Each log event takes at least one byte for each of its timestamp, log level, IR unit gap, and IR
+// unit size.
+constexpr size_t cMinNumBytesPerLogEvent{4};
+constexpr size_t cMaxVarintSize{10};
+
+constexpr uint8_t cVarintPayloadMask{0x7F};
+constexpr uint8_t cVarintContinuationFlag{0x80};
+constexpr size_t cVarintPayloadNumBits{7};
+
+/**
+ * A cursor over a blob that fails reads past the end of the blob.
+ */
+class BlobReader {
+public:
+    explicit BlobReader(std::span<char const> blob) : m_blob{blob} {}
+
+    [[nodiscard]] auto get_num_bytes_remaining() const -> size_t { return m_blob.size() - m_pos; }
+
+    /**
+     * @param num_bytes
+     * @param value Returns the little-endian integer read.
+     * @return Whether the integer was read.
+     */
+    [[nodiscard]] auto read_fixed(size_t num_bytes, uint64_t& value) -> bool;
+
+    /**
+     * @param value Returns the LEB128 variable-length integer read.
+     * @return Whether the integer was read.
+     */
+    [[nodiscard]] auto read_varint(uint64_t& value) -> bool;
+
+    /**
+     * @param num_bytes
+     * @return A view of the bytes read, or std::nullopt if there aren't enough bytes.
+     */
+    [[nodiscard]] auto read_bytes(size_t num_bytes) -> std::optional<std::span<char const>>;
+
+private:
+    std::span<char const> m_blob;
+    size_t m_pos{0};
+};
+
+/**
+ * Appends the given integer in little-endian order.
+ *
+ * @param value
+ * @param num_bytes
+ * @param blob
+ */
+auto append_fixed(uint64_t value, size_t num_bytes, std::vector<char>& blob) -> void;
+
+/**
+ * Appends the given integer as a LEB128 variable-length integer.
+ *
+ * @param value
+ * @param blob
+ */
+auto append_varint(uint64_t value, std::vector<char>& blob) -> void;
+
+/**
+ * @param value The two's complement representation of a signed integer.
+ * @return The zigzag encoding of the integer, which is small if the integer's magnitude is small.
+ */
+[[nodiscard]] constexpr auto zigzag_encode(uint64_t value) -> uint64_t {
+    return (value << 1U) ^ (0 - (value >> 63U));
+}
+
+/**
+ * @param value
+ * @return The two's complement representation of the zigzag-encoded integer.
+ */
+[[nodiscard]] constexpr auto zigzag_decode(uint64_t value) -> uint64_t {
+    return (value >> 1U) ^ (0 - (value & 1U));
+}
+
+auto BlobReader::read_fixed(size_t num_bytes, uint64_t& value) -> bool {
+    if (get_num_bytes_remaining() < num_bytes) {
+        return false;
+    }
+    value = 0;
+    for (size_t i{0}; i < num_bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(m_blob[m_pos + i])) << (i * 8);
+    }
+    m_pos += num_bytes;
+    return true;
+}
+
+auto BlobReader::read_varint(uint64_t& value) -> bool {
+    value = 0;
+    for (size_t i{0}; i < cMaxVarintSize && m_pos < m_blob.size(); ++i) {
+        auto const byte{static_cast<uint8_t>(m_blob[m_pos++])};
+        auto const payload{static_cast<uint64_t>(byte & cVarintPayloadMask)};
+        auto const shift{i * cVarintPayloadNumBits};
+        if (0 != shift && (payload >> (std::numeric_limits<uint64_t>::digits - shift)) != 0) {
+            // The integer overflows.
+            return false;
+        }
+        value |= payload << shift;
+        if (0 == (byte & cVarintContinuationFlag)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto BlobReader::read_bytes(size_t num_bytes) -> std::optional<std::span<char const>> {
+    if (get_num_bytes_remaining() < num_bytes) {
+        return std::nullopt;
+    }
+    auto const bytes{m_blob.subspan(m_pos, num_bytes)};
+    m_pos += num_bytes;
+    return bytes;
+}
+
+auto append_fixed(uint64_t value, size_t num_bytes, std::vector<char>& blob) -> void {
+    for (size_t i{0}; i < num_bytes; ++i) {
+        blob.push_back(static_cast<char>(static_cast<uint8_t>(value >> (i * 8))));
+    }
+}
+
+auto append_varint(uint64_t value, std::vector<char>& blob) -> void {
+    while (value > cVarintPayloadMask) {
+        blob.push_back(static_cast<char>((value & cVarintPayloadMask) | cVarintContinuationFlag));
+        value >>= cVarintPayloadNumBits;
+    }
+    blob.push_back(static_cast<char>(value));
+}
+}  // namespace
+
+auto hash_input(std::span<char const> input) -> uint64_t {
+    constexpr uint64_t cMultiplier{0x9E37'79B9'7F4A'7C15};
+    constexpr uint64_t cShift{32};
+    auto mix = [](uint64_t value) -> uint64_t {
+        value *= cMultiplier;
+        return value ^ (value >> cShift);
+    };
+
+    uint64_t hash{mix(input.size())};
+    size_t pos{0};
+    for (; pos + sizeof(uint64_t) <= input.size(); pos += sizeof(uint64_t)) {
+        uint64_t word{0};
+        std::memcpy(&word, input.data() + pos, sizeof(word));
+        hash = mix(hash ^ word);
+    }
+    if (pos < input.size()) {
+        uint64_t word{0};
+        std::memcpy(&word, input.data() + pos, input.size() - pos);
+        hash = mix(hash ^ word);
+    }
+    return hash;
+}
+
+auto serialize_stream_index(StreamIndexView const& index) -> std::vector<char> {
+    auto const num_log_events{index.timestamps.size()};
+    std::vector<char> blob;
+    blob.reserve(
+            cHeaderSize + cMaxVarintSize + num_log_events * cMinNumBytesPerLogEvent
+            + cMaxVarintSize + index.non_log_event_ir_units.size()
+    );
+    append_fixed(cMagicNumber, sizeof(uint32_t), blob);
+    append_fixed(cVersion, sizeof(uint32_t), blob);
+    append_fixed(index.input_hash, sizeof(uint64_t), blob);
+    append_fixed(index.input_size, sizeof(uint64_t), blob);
+
+    append_varint(num_log_events, blob);
+    uint64_t prev_timestamp{0};
+    for (auto const timestamp : index.timestamps) {
+        append_varint(zigzag_encode(static_cast<uint64_t>(timestamp) - prev_timestamp), blob);
+        prev_timestamp = static_cast<uint64_t>(timestamp);
+    }
+    for (auto const log_level : index.log_levels) {
+        blob.push_back(static_cast<char>(log_level));
+    }
+    size_t prev_end_offset{0};
+    for (size_t i{0}; i < num_log_events; ++i) {
+        append_varint(index.ir_unit_begin_offsets[i] - prev_end_offset, blob);
+        append_varint(index.ir_unit_end_offsets[i] - index.ir_unit_begin_offsets[i], blob);
+        prev_end_offset = index.ir_unit_end_offsets[i];
+    }
+
+    append_varint(index.non_log_event_ir_units.size(), blob);
+    blob.insert(
+            blob.end(),
+            index.non_log_event_ir_units.begin(),
+            index.non_log_event_ir_units.end()
+    );
+    return blob;
+}
+
+auto deserialize_stream_index(std::span<char const> blob) -> std::optional<StreamIndex> {
+    BlobReader reader{blob};
+    uint64_t magic_number{0};
+    uint64_t version{0};
+    StreamIndex index{};
+    if (false == reader.read_fixed(sizeof(uint32_t), magic_number) || cMagicNumber != magic_number
+        || false == reader.read_fixed(sizeof(uint32_t), version) || cVersion != version
+        || false == reader.read_fixed(sizeof(uint64_t), index.input_hash)
+        || false == reader.read_fixed(sizeof(uint64_t), index.input_size))
+    {
+        return std::nullopt;
+    }
+
+    uint64_t num_log_events{0};
+    if (false == reader.read_varint(num_log_events)
+        || num_log_events > reader.get_num_bytes_remaining() / cMinNumBytesPerLogEvent)
+    {
+        return std::nullopt;
+    }
+
+    index.timestamps.reserve(num_log_events);
+    uint64_t timestamp{0};
+    for (uint64_t i{0}; i < num_log_events; ++i) {
+        uint64_t delta{0};
+        if (false == reader.read_varint(delta)) {
+            return std::nullopt;
+        }
+        timestamp += zigzag_decode(delta);
+        index.timestamps.emplace_back(static_cast<clp::ir::epoch_time_ms_t>(timestamp));
+    }
+
+    auto const log_levels{reader.read_bytes(num_log_events)};
+    if (false == log_levels.has_value()) {
+        return std::nullopt;
+    }
+    index.log_levels.reserve(num_log_events);
+    for (auto const log_level : log_levels.value()) {
+        if (static_cast<uint8_t>(log_level) >= static_cast<uint8_t>(LogLevel::LENGTH)) {
+            return std::nullopt;
+        }
+        index.log_levels.emplace_back(static_cast<LogLevel>(log_level));
+    }
+
+    index.ir_unit_begin_offsets.reserve(num_log_events);
+    index.ir_unit_end_offsets.reserve(num_log_events);
+    uint64_t prev_end_offset{0};
+    for (uint64_t i{0}; i < num_log_events; ++i) {
+        uint64_t gap{0};
+        uint64_t size{0};
+        if (false == reader.read_varint(gap) || false == reader.read_varint(size)
+            || gap > std::numeric_limits<size_t>::max() - prev_end_offset
+            || size > std::numeric_limits<size_t>::max() - prev_end_offset - gap)
+        {
+            return std::nullopt;
+        }
+        index.ir_unit_begin_offsets.emplace_back(prev_end_offset + gap);
+        prev_end_offset += gap + size;
+        index.ir_unit_end_offsets.emplace_back(prev_end_offset);
+    }
+
+    uint64_t non_log_event_ir_units_size{0};
+    if (false == reader.read_varint(non_log_event_ir_units_size)
+        || non_log_event_ir_units_size != reader.get_num_bytes_remaining())
+    {
+        return std::nullopt;
+    }
+    auto const non_log_event_ir_units{reader.read_bytes(non_log_event_ir_units_size)};
+    index.non_log_event_ir_units.assign(
+            non_log_event_ir_units->begin(),
+            non_log_event_ir_units->end()
+    );
+    return index;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,78 @@
+#ifndef CLP_FFI_JS_IR_STREAM_INDEX_HPP
+#define CLP_FFI_JS_IR_STREAM_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_js/constants.hpp>
+
+// Methods to serialize the index of a fully deserialized stream into a compact binary blob, so that
+// a reader over the same input can be restored from the blob without deserializing the stream
+// again.
+namespace clp_ffi_js::ir {
+/**
+ * Views of the data needed to restore a lazy structured IR stream reader over a seekable input (see
+ * `LazyStructuredLogEvents`). The log level and timestamp indices aren't included since they're
+ * cheap to rebuild from the columns.
+ *
+ * The columns must have the same length, and the IR units must be in stream order.
+ */
+struct StreamIndexView {
+    // Identifies the compressed input the index belongs to.
+    uint64_t input_hash;
+    uint64_t input_size;
+
+    std::span<clp::ir::epoch_time_ms_t const> timestamps;
+    std::span<LogLevel const> log_levels;
+
+    // The positions of the log events' IR units in the decompressed stream.
+    std::span<size_t const> ir_unit_begin_offsets;
+    std::span<size_t const> ir_unit_end_offsets;
+
+    // The stream's other IR units (e.g., schema tree growth), in stream order and excluding the end
+    // of the stream, which restore the deserializer's state when replayed.
+    std::span<char const> non_log_event_ir_units;
+};
+
+/**
+ * A deserialized `StreamIndexView` that owns its data.
+ */
+struct StreamIndex {
+    uint64_t input_hash;
+    uint64_t input_size;
+    std::vector<clp::ir::epoch_time_ms_t> timestamps;
+    std::vector<LogLevel> log_levels;
+    std::vector<size_t> ir_unit_begin_offsets;
+    std::vector<size_t> ir_unit_end_offsets;
+    std::vector<char> non_log_event_ir_units;
+};
+
+/**
+ * Computes a fast, non-cryptographic hash of the given input.
+ *
+ * @param input
+ * @return The hash.
+ */
+[[nodiscard]] auto hash_input(std::span<char const> input) -> uint64_t;
+
+/**
+ * @param index
+ * @return The serialized index.
+ */
+[[nodiscard]] auto serialize_stream_index(StreamIndexView const& index) -> std::vector<char>;
+
+/**
+ * @param blob
+ * @return The deserialized index, or std::nullopt if the blob is malformed or was serialized by an
+ * incompatible version.
+ */
+[[nodiscard]] auto deserialize_stream_index(std::span<char const> blob)
+        -> std::optional<StreamIndex>;
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_STREAM_INDEX_HPP
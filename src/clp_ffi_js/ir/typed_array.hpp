@@ -0,0 +1,34 @@
+#ifndef CLP_FFI_JS_IR_TYPED_ARRAY_HPP
+#define CLP_FFI_JS_IR_TYPED_ARRAY_HPP
+
+#include <cstddef>
+
+#include <emscripten/val.h>
+
+namespace clp_ffi_js::ir {
+/**
+ * Creates a JS typed array of the given elements to return to JS.
+ *
+ * Without pthreads, the array is a view of the wasm memory, so it's only valid until the elements
+ * are next modified or the wasm memory grows.
+ *
+ * With pthreads, the wasm memory is a `SharedArrayBuffer`, which some web APIs (e.g.,
+ * `TextDecoder.decode`) reject, so the array is a copy in a non-shared buffer instead.
+ *
+ * @tparam T
+ * @param size
+ * @param data
+ * @return The typed array (e.g., a `Uint8Array` if `T` is `uint8_t`).
+ */
+template <typename T>
+[[nodiscard]] auto create_typed_array(size_t size, T const* data) -> emscripten::val {
+    emscripten::val view{emscripten::typed_memory_view(size, data)};
+#if CLP_FFI_JS_ENABLE_PTHREADS
+    return view.call<emscripten::val>("slice");
+#else
+    return view;
+#endif
+}
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_TYPED_ARRAY_HPP
@@ -0,0 +1,139 @@
+// Tests that exports are cut into chunks of whole lines that together hold every decoded log
+// event.
+//
+// Usage: node --test test/*.test.mjs (see "Testing" in `README.md`)
+
+import assert from "node:assert/strict";
+import {after, before, test} from "node:test";
+
+import {
+    createStream,
+    loadModule,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_WARN,
+    STRUCTURED_READER_OPTIONS,
+} from "./helpers.mjs";
+
+// Enough log events for a structured export to span several chunks (see `ExportBuffer`).
+const NUM_EVENTS = 100_000;
+const SEED = 17;
+const CHUNK_SIZE = 8 * 1024 * 1024;
+
+let module = null;
+let structuredReader = null;
+
+/**
+ * Exports the given range, copying each chunk out of wasm memory before requesting the next.
+ *
+ * @param {object} reader
+ * @param {number} beginIdx
+ * @param {number} endIdx
+ * @param {boolean} useFilter
+ * @return {Buffer[]} The chunks.
+ */
+const exportChunks = (reader, beginIdx, endIdx, useFilter) => {
+    assert.ok(reader.beginExport(beginIdx, endIdx, useFilter));
+    const chunks = [];
+    for (let chunk = reader.exportNextChunk(); null !== chunk; chunk = reader.exportNextChunk()) {
+        chunks.push(Buffer.from(chunk));
+    }
+    return chunks;
+};
+
+/**
+ * @param {object} reader
+ * @param {number} beginIdx
+ * @param {number} endIdx
+ * @param {boolean} useFilter
+ * @return {string} The decoded log events in the given range, one per line.
+ */
+const decodeLines = (reader, beginIdx, endIdx, useFilter) => reader
+    .decodeRange(beginIdx, endIdx, useFilter)
+    .map(([message]) => (message.endsWith("\n") ? message : `${message}\n`))
+    .join("");
+
+/**
+ * Asserts that every chunk holds whole lines and fits within `CHUNK_SIZE` bytes.
+ *
+ * @param {Buffer[]} chunks
+ */
+const assertChunksHoldWholeLines = (chunks) => {
+    for (const chunk of chunks) {
+        assert.ok(0 < chunk.length);
+        assert.ok(chunk.length <= CHUNK_SIZE, `chunk of ${chunk.length} bytes`);
+        assert.equal(chunk.at(-1), "\n".charCodeAt(0));
+    }
+};
+
+before(async () => {
+    module = await loadModule();
+    structuredReader = new module.ClpStreamReader(
+        createStream(module, module.IrStreamType.STRUCTURED, SEED, NUM_EVENTS),
+        STRUCTURED_READER_OPTIONS
+    );
+    assert.equal(structuredReader.deserializeStream(), NUM_EVENTS);
+});
+
+after(() => {
+    structuredReader?.delete();
+});
+
+test("structured export is cut into chunks of whole lines", () => {
+    const chunks = exportChunks(structuredReader, 0, NUM_EVENTS, false);
+    assert.ok(1 < chunks.length, `${chunks.length} chunk(s)`);
+    assertChunksHoldWholeLines(chunks);
+    assert.equal(
+        Buffer.concat(chunks).toString("utf8"),
+        decodeLines(structuredReader, 0, NUM_EVENTS, false)
+    );
+});
+
+test("filtered export holds the filtered log events", () => {
+    structuredReader.filterLogEvents([LOG_LEVEL_WARN, LOG_LEVEL_ERROR]);
+    try {
+        const numFilteredEvents = structuredReader.getFilteredLogEventMap().length;
+        const chunks = exportChunks(structuredReader, 0, numFilteredEvents, true);
+        assertChunksHoldWholeLines(chunks);
+        assert.equal(
+            Buffer.concat(chunks).toString("utf8"),
+            decodeLines(structuredReader, 0, numFilteredEvents, true)
+        );
+    } finally {
+        structuredReader.filterLogEvents(null);
+    }
+});
+
+test("filtered export fails if the filter changes", () => {
+    structuredReader.filterLogEvents([LOG_LEVEL_WARN]);
+    try {
+        const numFilteredEvents = structuredReader.getFilteredLogEventMap().length;
+        assert.ok(structuredReader.beginExport(0, numFilteredEvents, true));
+        structuredReader.filterLogEvents([LOG_LEVEL_ERROR]);
+        assert.throws(() => structuredReader.exportNextChunk());
+    } finally {
+        structuredReader.filterLogEvents(null);
+    }
+});
+
+test("export rejects invalid ranges", () => {
+    assert.equal(structuredReader.beginExport(0, NUM_EVENTS + 1, false), false);
+    assert.equal(structuredReader.exportNextChunk(), null);
+});
+
+test("unstructured export holds one message per line", () => {
+    const reader = new module.ClpStreamReader(
+        createStream(module, module.IrStreamType.UNSTRUCTURED, SEED, NUM_EVENTS),
+        null
+    );
+    try {
+        assert.equal(reader.deserializeStream(), NUM_EVENTS);
+        const chunks = exportChunks(reader, 0, NUM_EVENTS, false);
+        assertChunksHoldWholeLines(chunks);
+        assert.equal(
+            Buffer.concat(chunks).toString("utf8"),
+            decodeLines(reader, 0, NUM_EVENTS, false)
+        );
+    } finally {
+        reader.delete();
+    }
+});
@@ -0,0 +1,133 @@
+// Tests that field predicates select the same structured log events as evaluating them over the
+// decoded kv-pairs in JS.
+//
+// Usage: node --test test/*.test.mjs (see "Testing" in `README.md`)
+
+import assert from "node:assert/strict";
+import {after, before, beforeEach, test} from "node:test";
+
+import {
+    createStream,
+    loadModule,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_WARN,
+    STRUCTURED_READER_OPTIONS,
+} from "./helpers.mjs";
+
+const NUM_EVENTS = 3000;
+const SEED = 11;
+
+// Each predicate and the equivalent JS condition over a log event's kv-pairs.
+const PREDICATES = [
+    ["service: \"api\"", (kvPairs) => "api" === kvPairs.service],
+    ["service == billing", (kvPairs) => "billing" === kvPairs.service],
+    ["status >= 500", (kvPairs) => 500 <= kvPairs.status],
+    ["latency < 100", (kvPairs) => 100 > kvPairs.latency],
+    ["level != INFO", (kvPairs) => "INFO" !== kvPairs.level],
+    [
+        "service: search AND NOT level: DEBUG",
+        (kvPairs) => "search" === kvPairs.service && "DEBUG" !== kvPairs.level,
+    ],
+    [
+        "(status >= 500 or latency > 1500) and service != \"auth\"",
+        (kvPairs) => (500 <= kvPairs.status || 1500 < kvPairs.latency) &&
+            "auth" !== kvPairs.service,
+    ],
+    ["missing.key == null", () => true],
+];
+
+let module = null;
+let reader = null;
+let kvPairsOfLogEvents = null;
+
+/**
+ * @param {function(object): boolean} condition
+ * @param {number[] | null} logLevels The selected log levels, or null to select every log level.
+ * @return {number[]} The indices of the log events with the selected levels whose kv-pairs satisfy
+ * the condition.
+ */
+const getExpectedLogEventIndices = (condition, logLevels) => kvPairsOfLogEvents.flatMap(
+    ({kvPairs, logLevel}, idx) => ((condition(kvPairs) &&
+        (null === logLevels || logLevels.includes(logLevel))) ?
+        [idx] :
+        [])
+);
+
+before(async () => {
+    module = await loadModule();
+    reader = new module.ClpStreamReader(
+        createStream(module, module.IrStreamType.STRUCTURED, SEED, NUM_EVENTS),
+        STRUCTURED_READER_OPTIONS
+    );
+    assert.equal(reader.deserializeStream(), NUM_EVENTS);
+    kvPairsOfLogEvents = reader.decodeRange(0, NUM_EVENTS, false)
+        .map(([message, , logLevel]) => ({kvPairs: JSON.parse(message), logLevel}));
+});
+
+beforeEach(() => {
+    reader.filterLogEvents(null);
+    reader.filterByPredicate(null);
+});
+
+after(() => {
+    reader?.delete();
+});
+
+for (const [predicate, condition] of PREDICATES) {
+    test(`predicate \`${predicate}\` selects the matching log events`, () => {
+        const expected = getExpectedLogEventIndices(condition, null);
+        assert.equal(reader.filterByPredicate(predicate), expected.length);
+        assert.deepEqual(reader.getFilteredLogEventMap(), expected);
+    });
+}
+
+test("predicate narrows the log level filter", () => {
+    const logLevels = [LOG_LEVEL_WARN, LOG_LEVEL_ERROR];
+    const [predicate, condition] = PREDICATES[0];
+    reader.filterLogEvents(logLevels);
+
+    const expected = getExpectedLogEventIndices(condition, logLevels);
+    assert.equal(reader.filterByPredicate(predicate), expected.length);
+    assert.deepEqual(reader.getFilteredLogEventMap(), expected);
+
+    // Filtered log events decode like the unfiltered log events they map to.
+    assert.deepEqual(
+        reader.decodeRange(0, expected.length, true),
+        expected.map((idx) => reader.decodeRange(idx, idx + 1, false)[0])
+    );
+});
+
+test("predicate replaces the previous predicate", () => {
+    const logLevels = [LOG_LEVEL_WARN, LOG_LEVEL_ERROR];
+    reader.filterLogEvents(logLevels);
+    reader.filterByPredicate(PREDICATES[0][0]);
+
+    const [predicate, condition] = PREDICATES[1];
+    const expected = getExpectedLogEventIndices(condition, logLevels);
+    assert.equal(reader.filterByPredicate(predicate), expected.length);
+    assert.deepEqual(reader.getFilteredLogEventMap(), expected);
+
+    // Removing the predicate keeps the log level filter.
+    const expectedWithoutPredicate = getExpectedLogEventIndices(() => true, logLevels);
+    assert.equal(reader.filterByPredicate(null), expectedWithoutPredicate.length);
+    assert.deepEqual(reader.getFilteredLogEventMap(), expectedWithoutPredicate);
+});
+
+test("invalid predicates are rejected", () => {
+    for (const predicate of ["", "service", "service: ", "(status >= 500", "status >= 500 or"]) {
+        assert.throws(() => reader.filterByPredicate(predicate), `\`${predicate}\``);
+    }
+});
+
+test("predicates are rejected for unstructured streams", () => {
+    const unstructuredReader = new module.ClpStreamReader(
+        createStream(module, module.IrStreamType.UNSTRUCTURED, SEED, NUM_EVENTS),
+        null
+    );
+    try {
+        assert.equal(unstructuredReader.deserializeStream(), NUM_EVENTS);
+        assert.throws(() => unstructuredReader.filterByPredicate("status >= 500"));
+    } finally {
+        unstructuredReader.delete();
+    }
+});
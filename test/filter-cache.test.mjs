@@ -0,0 +1,155 @@
+// Tests that cached filter results and incrementally maintained filters match filters evaluated
+// from scratch.
+//
+// Usage: node --test test/*.test.mjs (see "Testing" in `README.md`)
+
+import assert from "node:assert/strict";
+import {before, test} from "node:test";
+
+import {
+    createFrames,
+    loadModule,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    STRUCTURED_READER_OPTIONS,
+} from "./helpers.mjs";
+
+const NUM_EVENTS = 3000;
+// Each frame is appended to a chunked reader separately.
+const NUM_EVENTS_PER_FRAME = 500;
+const SEED = 13;
+const SEARCH_QUERY = "api";
+const SEARCH_OPTIONS = {caseSensitive: true, regex: false};
+
+let module = null;
+let frames = null;
+let logEvents = null;
+
+/**
+ * @param {function(object[]): boolean} condition
+ * @param {number} numLogEvents
+ * @return {number[]} The indices of the first `numLogEvents` log events that satisfy the condition.
+ */
+const getExpectedLogEventIndices = (condition, numLogEvents) => logEvents
+    .slice(0, numLogEvents)
+    .flatMap((logEvent, idx) => (condition(logEvent) ? [idx] : []));
+
+/**
+ * @param {number[]} logLevels
+ * @return {function(object[]): boolean} A condition selecting log events with the given levels.
+ */
+const hasLogLevel = (logLevels) => ([, , logLevel]) => logLevels.includes(logLevel);
+
+/**
+ * @param {object[]} logEvent
+ * @return {boolean} Whether any string value of the log event contains `SEARCH_QUERY`.
+ */
+const matchesSearchQuery = ([message]) => Object.values(JSON.parse(message))
+    .some((value) => "string" === typeof value && value.includes(SEARCH_QUERY));
+
+before(async () => {
+    module = await loadModule();
+    frames = createFrames(
+        module,
+        module.IrStreamType.STRUCTURED,
+        SEED,
+        NUM_EVENTS,
+        {numEventsPerFrame: NUM_EVENTS_PER_FRAME}
+    );
+
+    const reader = new module.ClpStreamReader(
+        new Uint8Array(Buffer.concat(frames)),
+        STRUCTURED_READER_OPTIONS
+    );
+    try {
+        assert.equal(reader.deserializeStream(), NUM_EVENTS);
+        logEvents = reader.decodeRange(0, NUM_EVENTS, false);
+    } finally {
+        reader.delete();
+    }
+});
+
+test("switching back to a previous filter restores its result", () => {
+    const reader = new module.ClpStreamReader(
+        new Uint8Array(Buffer.concat(frames)),
+        STRUCTURED_READER_OPTIONS
+    );
+    try {
+        assert.equal(reader.deserializeStream(), NUM_EVENTS);
+        const expectedWarnOrError = getExpectedLogEventIndices(
+            hasLogLevel([LOG_LEVEL_WARN, LOG_LEVEL_ERROR]),
+            NUM_EVENTS
+        );
+        const expectedSearch = getExpectedLogEventIndices(matchesSearchQuery, NUM_EVENTS);
+
+        for (let i = 0; i < 2; ++i) {
+            // Selecting the same levels in a different order is the same filter.
+            const generation = reader.getFilteredLogEventMapGeneration();
+            reader.filterLogEvents(0 === i ?
+                [LOG_LEVEL_WARN, LOG_LEVEL_ERROR] :
+                [LOG_LEVEL_ERROR, LOG_LEVEL_WARN]);
+            assert.notEqual(reader.getFilteredLogEventMapGeneration(), generation);
+            assert.deepEqual(reader.getFilteredLogEventMap(), expectedWarnOrError);
+
+            reader.filterLogEvents([LOG_LEVEL_INFO]);
+            assert.deepEqual(
+                reader.getFilteredLogEventMap(),
+                getExpectedLogEventIndices(hasLogLevel([LOG_LEVEL_INFO]), NUM_EVENTS)
+            );
+
+            assert.equal(
+                reader.searchLogEvents(SEARCH_QUERY, SEARCH_OPTIONS),
+                expectedSearch.length
+            );
+            assert.deepEqual(reader.getFilteredLogEventMap(), expectedSearch);
+        }
+    } finally {
+        reader.delete();
+    }
+});
+
+test("appended log events are filtered by the active and cached filters", () => {
+    const reader = module.ClpStreamReader.createChunked(frames[0], STRUCTURED_READER_OPTIONS);
+    try {
+        let numLogEvents = reader.deserializeStream();
+        assert.equal(numLogEvents, NUM_EVENTS_PER_FRAME);
+        const logLevels = [LOG_LEVEL_WARN, LOG_LEVEL_ERROR];
+        reader.filterLogEvents(logLevels);
+
+        for (const [frameIdx, frame] of frames.slice(1).entries()) {
+            // Alternate between two filters so that each is cached while the other is active.
+            const isSearchActive = 1 === frameIdx % 2;
+            if (isSearchActive) {
+                reader.searchLogEvents(SEARCH_QUERY, SEARCH_OPTIONS);
+            } else {
+                reader.filterLogEvents(logLevels);
+            }
+
+            const generation = reader.getFilteredLogEventMapGeneration();
+            numLogEvents += reader.appendData(frame);
+            assert.notEqual(reader.getFilteredLogEventMapGeneration(), generation);
+            assert.deepEqual(
+                reader.getFilteredLogEventMap(),
+                getExpectedLogEventIndices(
+                    isSearchActive ? matchesSearchQuery : hasLogLevel(logLevels),
+                    numLogEvents
+                )
+            );
+        }
+        assert.equal(numLogEvents, NUM_EVENTS);
+
+        reader.filterLogEvents(logLevels);
+        assert.deepEqual(
+            reader.getFilteredLogEventMap(),
+            getExpectedLogEventIndices(hasLogLevel(logLevels), NUM_EVENTS)
+        );
+        reader.searchLogEvents(SEARCH_QUERY, SEARCH_OPTIONS);
+        assert.deepEqual(
+            reader.getFilteredLogEventMap(),
+            getExpectedLogEventIndices(matchesSearchQuery, NUM_EVENTS)
+        );
+    } finally {
+        reader.delete();
+    }
+});
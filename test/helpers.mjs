@@ -0,0 +1,89 @@
+// Helpers shared by the tests in this directory.
+
+import path from "node:path";
+import {fileURLToPath, pathToFileURL} from "node:url";
+import zlib from "node:zlib";
+
+const ROOT_DIR = path.resolve(path.dirname(fileURLToPath(import.meta.url)), "..");
+const MODULE_PATH = process.env.CLP_FFI_JS_TEST_MODULE ??
+    path.join(ROOT_DIR, "build", "clp-ffi-js-bench", "ClpFfiJsBench-node.js");
+
+const STRUCTURED_READER_OPTIONS = {logLevelKey: "level", timestampKey: "timestamp"};
+
+// See `LogLevel` in `src/clp_ffi_js/constants.hpp`.
+const LOG_LEVEL_INFO = 3;
+const LOG_LEVEL_WARN = 4;
+const LOG_LEVEL_ERROR = 5;
+
+/**
+ * Loads the module under test: `CLP_FFI_JS_TEST_MODULE` if set, or else the benchmark module in
+ * the default build directory.
+ *
+ * @return {Promise<object>} The instantiated module.
+ */
+const loadModule = async () => {
+    const {default: createModule} = await import(pathToFileURL(MODULE_PATH).href);
+    return createModule();
+};
+
+/**
+ * Generates a synthetic stream, compressed into one or more zstd frames.
+ *
+ * @param {object} module
+ * @param {number} streamType
+ * @param {number} seed
+ * @param {number} numEvents
+ * @param {object} [options]
+ * @param {number} [options.numEventsPerFrame] The number of log events to compress into each
+ * frame, which makes the input seekable if the stream spans more than one frame. Defaults to
+ * `numEvents`.
+ * @param {object} [options.timestampFormat] A `module.SyntheticTimestampFormat` value for the
+ * timestamps of structured streams. Defaults to `EPOCH_MILLISECONDS`.
+ * @return {Uint8Array[]} The compressed frames. The end of the stream is in the last frame.
+ */
+const createFrames = (module, streamType, seed, numEvents, {
+    numEventsPerFrame = numEvents,
+    timestampFormat = module.SyntheticTimestampFormat.EPOCH_MILLISECONDS,
+} = {}) => {
+    const generator = new module.SyntheticCorpusGenerator(streamType, seed, timestampFormat);
+    const frames = [];
+    try {
+        let numGenerated = 0;
+        do {
+            const batchSize = Math.min(numEventsPerFrame, numEvents - numGenerated);
+            numGenerated += batchSize;
+            const data = [generator.generate(batchSize)];
+            if (numGenerated === numEvents) {
+                data.push(generator.finish());
+            }
+            frames.push(new Uint8Array(zlib.zstdCompressSync(Buffer.concat(data))));
+        } while (numGenerated < numEvents);
+    } finally {
+        generator.delete();
+    }
+    return frames;
+};
+
+/**
+ * Same as `createFrames`, except the frames are concatenated into a single stream.
+ *
+ * @param {object} module
+ * @param {number} streamType
+ * @param {number} seed
+ * @param {number} numEvents
+ * @param {object} [options] See `createFrames`.
+ * @return {Uint8Array} The compressed stream.
+ */
+const createStream = (module, streamType, seed, numEvents, options) => new Uint8Array(
+    Buffer.concat(createFrames(module, streamType, seed, numEvents, options))
+);
+
+export {
+    createFrames,
+    createStream,
+    loadModule,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    STRUCTURED_READER_OPTIONS,
+};
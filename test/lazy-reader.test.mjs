@@ -0,0 +1,132 @@
+// Tests that lazy structured readers decode the same log events as eager readers.
+//
+// Usage: node --test test/*.test.mjs (see "Testing" in `README.md`)
+
+import assert from "node:assert/strict";
+import {after, before, test} from "node:test";
+
+import {
+    createStream,
+    loadModule,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_WARN,
+    STRUCTURED_READER_OPTIONS,
+} from "./helpers.mjs";
+
+// Spans several pages of lazily materialized log events (1024 log events each).
+const NUM_EVENTS = 3000;
+const SEED = 1;
+const DECODED_RANGES = [[0, 10], [1020, 1030], [NUM_EVENTS - 10, NUM_EVENTS]];
+
+let module = null;
+let eagerReader = null;
+
+/**
+ * @param {number} numEventsPerFrame
+ * @return {Uint8Array} A synthetic structured stream (see `createStream` in `helpers.mjs`).
+ */
+const createStructuredStream = (numEventsPerFrame) => createStream(
+    module,
+    module.IrStreamType.STRUCTURED,
+    SEED,
+    NUM_EVENTS,
+    {numEventsPerFrame}
+);
+
+/**
+ * Asserts that the reader decodes every range in `DECODED_RANGES` the same as the eager reader.
+ *
+ * @param {object} reader
+ */
+const assertDecodesLikeEagerReader = (reader) => {
+    for (const [beginIdx, endIdx] of DECODED_RANGES) {
+        assert.deepEqual(
+            reader.decodeRange(beginIdx, endIdx, false),
+            eagerReader.decodeRange(beginIdx, endIdx, false)
+        );
+    }
+};
+
+before(async () => {
+    module = await loadModule();
+    eagerReader = new module.ClpStreamReader(
+        createStructuredStream(NUM_EVENTS),
+        STRUCTURED_READER_OPTIONS
+    );
+    assert.equal(eagerReader.deserializeStream(), NUM_EVENTS);
+});
+
+after(() => {
+    eagerReader?.delete();
+});
+
+for (const [name, numEventsPerFrame] of [["retained", NUM_EVENTS], ["seekable", 500]]) {
+    test(`lazy reader over ${name} input decodes pages after deserializing the stream`, () => {
+        const reader = new module.ClpStreamReader(
+            createStructuredStream(numEventsPerFrame),
+            {...STRUCTURED_READER_OPTIONS, lazy: true}
+        );
+        try {
+            assert.equal(reader.deserializeStream(), NUM_EVENTS);
+            assertDecodesLikeEagerReader(reader);
+        } finally {
+            reader.delete();
+        }
+    });
+}
+
+test("lazy reader restored from an exported index decodes pages", () => {
+    const data = createStructuredStream(500);
+    const lazyReaderOptions = {...STRUCTURED_READER_OPTIONS, lazy: true};
+    const reader = new module.ClpStreamReader(data, lazyReaderOptions);
+    let restoredReader = null;
+    try {
+        assert.equal(reader.deserializeStream(), NUM_EVENTS);
+        const index = reader.exportIndex();
+
+        restoredReader = new module.ClpStreamReader(data, lazyReaderOptions);
+        assert.ok(restoredReader.importIndex(index));
+        assertDecodesLikeEagerReader(restoredReader);
+    } finally {
+        reader.delete();
+        restoredReader?.delete();
+    }
+});
+
+test("lazy reader holds less log event storage than the eager reader", () => {
+    const reader = new module.ClpStreamReader(
+        createStructuredStream(NUM_EVENTS),
+        {...STRUCTURED_READER_OPTIONS, lazy: true}
+    );
+    try {
+        assert.equal(reader.deserializeStream(), NUM_EVENTS);
+        assert.ok(
+            reader.getMemoryUsage().eventStorage < eagerReader.getMemoryUsage().eventStorage
+        );
+    } finally {
+        reader.delete();
+    }
+});
+
+test("lazy reader filters and decodes filtered pages like the eager reader", () => {
+    const reader = new module.ClpStreamReader(
+        createStructuredStream(500),
+        {...STRUCTURED_READER_OPTIONS, lazy: true}
+    );
+    const logLevelFilter = [LOG_LEVEL_WARN, LOG_LEVEL_ERROR];
+    try {
+        assert.equal(reader.deserializeStream(), NUM_EVENTS);
+        reader.filterLogEvents(logLevelFilter);
+        eagerReader.filterLogEvents(logLevelFilter);
+
+        const filteredLogEventMap = reader.getFilteredLogEventMap();
+        assert.deepEqual(filteredLogEventMap, eagerReader.getFilteredLogEventMap());
+        assert.deepEqual(
+            reader.decodeRange(0, filteredLogEventMap.length, true),
+            eagerReader.decodeRange(0, filteredLogEventMap.length, true)
+        );
+    } finally {
+        eagerReader.filterLogEvents(null);
+        reader.delete();
+    }
+});
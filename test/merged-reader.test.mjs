@@ -0,0 +1,118 @@
+// Tests that merged readers order the log events of several streams by timestamp, and filter and
+// find them like the streams' own readers.
+//
+// Usage: node --test test/*.test.mjs (see "Testing" in `README.md`)
+
+import assert from "node:assert/strict";
+import {after, before, test} from "node:test";
+
+import {
+    createStream,
+    loadModule,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_WARN,
+    STRUCTURED_READER_OPTIONS,
+} from "./helpers.mjs";
+
+const NUM_EVENTS_PER_STREAM = 1000;
+
+let module = null;
+let streams = null;
+let mergedReader = null;
+let mergedLogEvents = null;
+
+/**
+ * @param {Uint8Array} stream
+ * @return {Array} Every log event in the stream, decoded by the stream's own reader.
+ */
+const decodeStream = (stream) => {
+    const reader = new module.ClpStreamReader(stream, STRUCTURED_READER_OPTIONS);
+    try {
+        assert.equal(reader.deserializeStream(), NUM_EVENTS_PER_STREAM);
+        return reader.decodeRange(0, NUM_EVENTS_PER_STREAM, false);
+    } finally {
+        reader.delete();
+    }
+};
+
+before(async () => {
+    module = await loadModule();
+    streams = [
+        [module.IrStreamType.STRUCTURED, 1],
+        [module.IrStreamType.UNSTRUCTURED, 2],
+        [module.IrStreamType.STRUCTURED, 3],
+    ].map(([streamType, seed]) => createStream(module, streamType, seed, NUM_EVENTS_PER_STREAM));
+    mergedReader = new module.ClpMergedStreamReader(streams, STRUCTURED_READER_OPTIONS);
+
+    // Filtering before the streams are deserialized must not fail.
+    mergedReader.filterLogEvents([LOG_LEVEL_ERROR]);
+    assert.deepEqual(mergedReader.getFilteredLogEventMap(), []);
+
+    assert.equal(mergedReader.deserializeStream(), streams.length * NUM_EVENTS_PER_STREAM);
+    mergedLogEvents = mergedReader.decodeRange(0, streams.length * NUM_EVENTS_PER_STREAM, false);
+});
+
+after(() => {
+    mergedReader?.delete();
+});
+
+test("merged reader removes the filter when deserializing", () => {
+    assert.equal(mergedReader.getFilteredLogEventMap(), null);
+});
+
+test("merged reader orders log events by timestamp, then by stream, then by stream order", () => {
+    for (let i = 1; i < mergedLogEvents.length; ++i) {
+        const [, prevTimestamp, , prevLogEventNum, prevSourceIdx] = mergedLogEvents[i - 1];
+        const [, timestamp, , logEventNum, sourceIdx] = mergedLogEvents[i];
+        assert.ok(
+            prevTimestamp < timestamp || (prevTimestamp === timestamp &&
+                (prevSourceIdx < sourceIdx ||
+                    (prevSourceIdx === sourceIdx && prevLogEventNum < logEventNum))),
+            `log event ${i}`
+        );
+    }
+});
+
+test("merged reader decodes log events like each stream's reader", () => {
+    streams.forEach((stream, sourceIdx) => {
+        const sourceLogEvents = mergedLogEvents
+            .filter(([, , , , idx]) => sourceIdx === idx)
+            .map((logEvent) => logEvent.slice(0, -1));
+        assert.deepEqual(sourceLogEvents, decodeStream(stream));
+    });
+});
+
+test("merged reader filters log events by log level", () => {
+    const logLevels = [LOG_LEVEL_WARN, LOG_LEVEL_ERROR];
+    const expected = mergedLogEvents.flatMap(
+        ([, , logLevel], idx) => (logLevels.includes(logLevel) ? [idx] : [])
+    );
+    assert.ok(0 < expected.length);
+
+    mergedReader.filterLogEvents(logLevels);
+    try {
+        assert.deepEqual(mergedReader.getFilteredLogEventMap(), expected);
+        assert.deepEqual(
+            mergedReader.decodeRange(0, expected.length, true),
+            expected.map((idx) => mergedLogEvents[idx])
+        );
+    } finally {
+        mergedReader.filterLogEvents(null);
+    }
+});
+
+test("merged reader finds the last log event at or before a timestamp", () => {
+    const firstTimestamp = mergedLogEvents[0][1];
+    const lastTimestamp = mergedLogEvents[mergedLogEvents.length - 1][1];
+    assert.equal(mergedReader.findNearestLogEventByTimestamp(firstTimestamp - 1n), 0);
+    assert.equal(
+        mergedReader.findNearestLogEventByTimestamp(lastTimestamp + 1n),
+        mergedLogEvents.length - 1
+    );
+
+    for (const idx of [1, 500, 1500, 2999]) {
+        const timestamp = mergedLogEvents[idx][1];
+        const expected = mergedLogEvents.findLastIndex(([, ts]) => ts <= timestamp);
+        assert.equal(mergedReader.findNearestLogEventByTimestamp(timestamp), expected);
+    }
+});
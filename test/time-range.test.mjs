@@ -0,0 +1,139 @@
+// Tests that time range filters compose with log level filters, and that time histograms count
+// the log events in each bucket.
+//
+// Usage: node --test test/*.test.mjs (see "Testing" in `README.md`)
+
+import assert from "node:assert/strict";
+import {after, before, beforeEach, test} from "node:test";
+
+import {
+    createStream,
+    loadModule,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    STRUCTURED_READER_OPTIONS,
+} from "./helpers.mjs";
+
+const NUM_EVENTS = 3000;
+const SEED = 5;
+
+let reader = null;
+let logEvents = null;
+
+/**
+ * @param {bigint} beginTs
+ * @param {bigint} endTs
+ * @param {number[] | null} logLevels The selected log levels, or null to select every log level.
+ * @return {number[]} The indices of the log events in `[beginTs, endTs)` with the selected levels.
+ */
+const getExpectedLogEventIndices = (beginTs, endTs, logLevels) => logEvents.flatMap(
+    ([, timestamp, logLevel], idx) => ((beginTs <= timestamp && timestamp < endTs &&
+        (null === logLevels || logLevels.includes(logLevel))) ?
+        [idx] :
+        [])
+);
+
+/**
+ * @param {number} numerator
+ * @param {number} denominator
+ * @return {bigint} The timestamp at the given fraction of the way through the stream.
+ */
+const getTimestampAt = (numerator, denominator) => {
+    const firstTimestamp = logEvents[0][1];
+    const lastTimestamp = logEvents[NUM_EVENTS - 1][1];
+    return firstTimestamp +
+        ((lastTimestamp - firstTimestamp) * BigInt(numerator) / BigInt(denominator));
+};
+
+before(async () => {
+    const module = await loadModule();
+    reader = new module.ClpStreamReader(
+        createStream(module, module.IrStreamType.STRUCTURED, SEED, NUM_EVENTS),
+        STRUCTURED_READER_OPTIONS
+    );
+    assert.equal(reader.deserializeStream(), NUM_EVENTS);
+    logEvents = reader.decodeRange(0, NUM_EVENTS, false);
+});
+
+beforeEach(() => {
+    reader.clearTimeRange();
+    reader.filterLogEvents(null);
+});
+
+after(() => {
+    reader?.delete();
+});
+
+test("time range filter selects the log events in the range", () => {
+    const beginTs = getTimestampAt(1, 4);
+    const endTs = getTimestampAt(1, 2);
+    const expected = getExpectedLogEventIndices(beginTs, endTs, null);
+    assert.ok(0 < expected.length);
+
+    assert.equal(reader.filterByTimeRange(beginTs, endTs), expected.length);
+    assert.deepEqual(reader.getFilteredLogEventMap(), expected);
+});
+
+test("time range filter replaces the previous time range", () => {
+    reader.filterByTimeRange(getTimestampAt(0, 1), getTimestampAt(1, 4));
+
+    const beginTs = getTimestampAt(1, 2);
+    const endTs = getTimestampAt(3, 4);
+    const expected = getExpectedLogEventIndices(beginTs, endTs, null);
+    assert.equal(reader.filterByTimeRange(beginTs, endTs), expected.length);
+    assert.deepEqual(reader.getFilteredLogEventMap(), expected);
+});
+
+test("time range and log level filters compose", () => {
+    const beginTs = getTimestampAt(1, 3);
+    const endTs = getTimestampAt(2, 3);
+    const logLevels = [LOG_LEVEL_WARN, LOG_LEVEL_ERROR];
+
+    reader.filterLogEvents(logLevels);
+    reader.filterByTimeRange(beginTs, endTs);
+    assert.deepEqual(
+        reader.getFilteredLogEventMap(),
+        getExpectedLogEventIndices(beginTs, endTs, logLevels)
+    );
+
+    // Changing the log levels keeps the time range.
+    reader.filterLogEvents([LOG_LEVEL_INFO]);
+    assert.deepEqual(
+        reader.getFilteredLogEventMap(),
+        getExpectedLogEventIndices(beginTs, endTs, [LOG_LEVEL_INFO])
+    );
+
+    // Clearing the time range keeps the log levels.
+    reader.clearTimeRange();
+    assert.deepEqual(
+        reader.getFilteredLogEventMap(),
+        logEvents.flatMap(([, , logLevel], idx) => ((LOG_LEVEL_INFO === logLevel) ?
+            [idx] :
+            []))
+    );
+
+    reader.filterLogEvents(null);
+    assert.equal(reader.getFilteredLogEventMap(), null);
+});
+
+test("time histogram counts the log events in each bucket regardless of the filter", () => {
+    const numBuckets = 10;
+    const beginTs = getTimestampAt(1, 10);
+    // Make the range's width a multiple of `numBuckets` so that every bucket has the same width.
+    const bucketWidth = (getTimestampAt(9, 10) - beginTs) / BigInt(numBuckets);
+    const endTs = beginTs + (bucketWidth * BigInt(numBuckets));
+
+    const expected = new Array(numBuckets).fill(0);
+    for (const idx of getExpectedLogEventIndices(beginTs, endTs, null)) {
+        ++expected[Number((logEvents[idx][1] - beginTs) / bucketWidth)];
+    }
+
+    reader.filterLogEvents([LOG_LEVEL_ERROR]);
+    assert.deepEqual(reader.getTimeHistogram(beginTs, endTs, numBuckets), expected);
+});
+
+test("time histogram rejects an empty range", () => {
+    const ts = getTimestampAt(1, 2);
+    assert.throws(() => reader.getTimeHistogram(ts, ts, 1));
+});
@@ -0,0 +1,63 @@
+// Tests that structured readers parse string timestamps into the same epoch milliseconds as integer
+// timestamps.
+//
+// Usage: node --test test/*.test.mjs (see "Testing" in `README.md`)
+
+import assert from "node:assert/strict";
+import {before, test} from "node:test";
+
+import {createStream, loadModule, STRUCTURED_READER_OPTIONS} from "./helpers.mjs";
+
+const NUM_EVENTS = 1000;
+const SEED = 3;
+
+let module = null;
+let expectedTimestamps = null;
+
+/**
+ * @param {object} timestampFormat A `module.SyntheticTimestampFormat` value.
+ * @return {bigint[]} The timestamps of every log event in a stream with the given format.
+ */
+const readTimestamps = (timestampFormat) => {
+    const reader = new module.ClpStreamReader(
+        createStream(module, module.IrStreamType.STRUCTURED, SEED, NUM_EVENTS, {timestampFormat}),
+        STRUCTURED_READER_OPTIONS
+    );
+    try {
+        assert.equal(reader.deserializeStream(), NUM_EVENTS);
+        return reader.decodeRange(0, NUM_EVENTS, false).map(([, timestamp]) => timestamp);
+    } finally {
+        reader.delete();
+    }
+};
+
+before(async () => {
+    module = await loadModule();
+    expectedTimestamps = readTimestamps(module.SyntheticTimestampFormat.EPOCH_MILLISECONDS);
+});
+
+test("integer timestamps are read as milliseconds", () => {
+    // Otherwise, the tests below would also pass if every format were misread in the same way.
+    assert.equal(expectedTimestamps[0] / 1000n, 1_700_000_000n);
+});
+
+test("integer epoch millisecond strings are read as milliseconds", () => {
+    assert.deepEqual(
+        readTimestamps(module.SyntheticTimestampFormat.EPOCH_MILLISECONDS_STRING),
+        expectedTimestamps
+    );
+});
+
+test("integer epoch second strings are read as seconds", () => {
+    assert.deepEqual(
+        readTimestamps(module.SyntheticTimestampFormat.EPOCH_SECONDS_STRING),
+        expectedTimestamps.map((timestamp) => (timestamp / 1000n) * 1000n)
+    );
+});
+
+test("decimal epoch second strings are read as seconds", () => {
+    assert.deepEqual(
+        readTimestamps(module.SyntheticTimestampFormat.DECIMAL_EPOCH_SECONDS_STRING),
+        expectedTimestamps
+    );
+});
@@ -0,0 +1,70 @@
+// Tests that unstructured readers decode messages the same as CLP.
+//
+// Unstructured readers decode messages from their interned logtypes (see `InternedLogEvent`), while
+// structured readers decode text values with CLP itself. For a given seed, the synthetic corpus
+// generator writes the same log events into both stream types, so the unstructured reader's
+// messages can be checked against the equivalent structured stream's.
+//
+// Usage: node --test test/*.test.mjs (see "Testing" in `README.md`)
+
+import assert from "node:assert/strict";
+import {after, before, test} from "node:test";
+
+import {createStream, loadModule, STRUCTURED_READER_OPTIONS} from "./helpers.mjs";
+
+const NUM_EVENTS = 3000;
+const SEED = 7;
+
+let structuredReader = null;
+let unstructuredReader = null;
+
+/**
+ * Formats a timestamp the way the generator's unstructured timestamp pattern
+ * (`%Y-%m-%d %H:%M:%S,%3`) does.
+ *
+ * @param {number} timestamp Milliseconds since the Unix epoch.
+ * @return {string}
+ */
+const formatTimestamp = (timestamp) => new Date(timestamp).toISOString()
+    .replace("T", " ")
+    .replace(".", ",")
+    .replace("Z", "");
+
+before(async () => {
+    const module = await loadModule();
+    structuredReader = new module.ClpStreamReader(
+        createStream(module, module.IrStreamType.STRUCTURED, SEED, NUM_EVENTS),
+        STRUCTURED_READER_OPTIONS
+    );
+    assert.equal(structuredReader.deserializeStream(), NUM_EVENTS);
+    unstructuredReader = new module.ClpStreamReader(
+        createStream(module, module.IrStreamType.UNSTRUCTURED, SEED, NUM_EVENTS),
+        null
+    );
+    assert.equal(unstructuredReader.deserializeStream(), NUM_EVENTS);
+});
+
+after(() => {
+    structuredReader?.delete();
+    unstructuredReader?.delete();
+});
+
+test("unstructured reader decodes messages like CLP", () => {
+    const structuredResults = structuredReader.decodeRange(0, NUM_EVENTS, false);
+    const unstructuredResults = unstructuredReader.decodeRange(0, NUM_EVENTS, false);
+    for (let i = 0; i < NUM_EVENTS; ++i) {
+        const {timestamp, level, service, message, status, latency} =
+            JSON.parse(structuredResults[i][0]);
+        assert.equal(
+            unstructuredResults[i][0],
+            `${formatTimestamp(timestamp)} ${level} [${service}] ${message} ` +
+                `(status=${status}, latency=${latency} ms)`
+        );
+    }
+});
+
+test("corpus contains negative float variables with leading zeros in their fraction", () => {
+    // Otherwise, the test above wouldn't cover those cases of decoding float variables.
+    const results = unstructuredReader.decodeRange(0, NUM_EVENTS, false);
+    assert.ok(results.some(([message]) => /Clock skew of -\d\.0\d\d s/.test(message)));
+});